@@ -49,6 +49,7 @@ private:
     bool m_evenMaxSegment;
 
     friend class QLogValue3DAxisFormatter;
+    friend class Bars3DRenderer;
 };
 
 QT_END_NAMESPACE
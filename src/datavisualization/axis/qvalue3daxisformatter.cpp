@@ -19,6 +19,10 @@ QT_BEGIN_NAMESPACE
  * The base class has no public API beyond constructors and destructors. It is meant to be only
  * used internally. However, subclasses may implement public properties as needed.
  *
+ * \note Subclasses must declare the Q_OBJECT macro. Graphs map values of the built-in formatters
+ * without calling positionAt(), and recognize them by their meta-object. A subclass without the
+ * macro has the meta-object of its base class, so its positionAt() is not used.
+ *
  * \sa QValue3DAxis, QLogValue3DAxisFormatter
  */
 
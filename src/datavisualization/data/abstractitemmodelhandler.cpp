@@ -47,8 +47,10 @@ void AbstractItemModelHandler::setItemModel(QAbstractItemModel *itemModel)
             QObject::connect(m_itemModel.data(), &QAbstractItemModel::rowsRemoved,
                              this, &AbstractItemModelHandler::handleRowsRemoved);
         }
-        if (!m_resolveTimer.isActive())
+        if (!m_resolveTimer.isActive()) {
+            m_fullReset = true;
             m_resolveTimer.start(0);
+        }
 
         emit itemModelChanged(itemModel);
     }
@@ -201,8 +203,11 @@ void AbstractItemModelHandler::handleRowsRemoved(const QModelIndex &parent, int
 
 void AbstractItemModelHandler::handleMappingChanged()
 {
-    if (!m_resolveTimer.isActive())
+    // Row changes must not be applied with the old mapping before the resolve
+    if (!m_resolveTimer.isActive()) {
+        m_fullReset = true;
         m_resolveTimer.start(0);
+    }
 }
 
 void AbstractItemModelHandler::handlePendingResolve()
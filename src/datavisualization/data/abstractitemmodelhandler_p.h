@@ -59,7 +59,7 @@ protected:
     QPointer<QAbstractItemModel> m_itemModel;  // Not owned
     bool resolvePending;
     QTimer m_resolveTimer;
-    bool m_fullReset;
+    bool m_fullReset; // Set while a resolve of the whole model is pending
 
 private:
     Q_DISABLE_COPY(AbstractItemModelHandler)
@@ -24,46 +24,163 @@ BarItemModelHandler::~BarItemModelHandler()
 void BarItemModelHandler::handleDataChanged(const QModelIndex &topLeft,
                                             const QModelIndex &bottomRight, const QList<int> &roles)
 {
+    // Only top level rows are mapped to the proxy
+    if (topLeft.parent().isValid())
+        return;
+
     // Do nothing if full reset already pending
     if (!m_fullReset) {
         if (!m_proxy->useModelCategories()) {
             // If the data model doesn't directly map rows and columns, we cannot optimize
             AbstractItemModelHandler::handleDataChanged(topLeft, bottomRight, roles);
         } else {
+            // Changes to roles we do not map cannot affect the proxy
+            if (!roles.isEmpty() && !roles.contains(m_valueRole)
+                    && !roles.contains(m_rotationRole)) {
+                return;
+            }
+
             int startRow = qMin(topLeft.row(), bottomRight.row());
             int endRow = qMax(topLeft.row(), bottomRight.row());
             int startCol = qMin(topLeft.column(), bottomRight.column());
             int endCol = qMax(topLeft.column(), bottomRight.column());
 
-            for (int i = startRow; i <= endRow; i++) {
-                for (int j = startCol; j <= endCol; j++) {
-                    QModelIndex index = m_itemModel->index(i, j);
-                    QBarDataItem item;
-                    QVariant valueVar = index.data(m_valueRole);
-                    float value;
-                    if (m_haveValuePattern)
-                        value = valueVar.toString().replace(m_valuePattern, m_valueReplace).toFloat();
-                    else
-                        value = valueVar.toFloat();
-                    item.setValue(value);
-                    if (m_rotationRole != noRoleIndex) {
-                        QVariant rotationVar = index.data(m_rotationRole);
-                        float rotation;
-                        if (m_haveRotationPattern) {
-                            rotation = rotationVar.toString().replace(m_rotationPattern,
-                                                                      m_rotationReplace).toFloat();
-                        } else {
-                            rotation = rotationVar.toFloat();
-                        }
-                        item.setRotation(rotation);
+            if (startCol == 0 && endCol == m_columnCount - 1) {
+                // Replace whole rows at once to avoid a change signal per item
+                m_proxy->setRows(startRow, resolveRows(startRow, endRow));
+            } else {
+                for (int i = startRow; i <= endRow; i++) {
+                    for (int j = startCol; j <= endCol; j++) {
+                        QBarDataItem item;
+                        modelPosToBarItem(i, j, item);
+                        m_proxy->setItem(i, j, item);
                     }
-                    m_proxy->setItem(i, j, item);
                 }
             }
         }
     }
 }
 
+void BarItemModelHandler::handleRowsInserted(const QModelIndex &parent, int start, int end)
+{
+    // Only top level rows are mapped to the proxy
+    if (parent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (!m_proxy->useModelCategories() || !m_proxy->rowCount()) {
+            // If the data model doesn't directly map rows and columns, we cannot optimize.
+            // If inserting into an empty array, do full asynchronous reset to avoid multiple
+            // separate inserts when initializing the model.
+            AbstractItemModelHandler::handleRowsInserted(parent, start, end);
+        } else {
+            m_proxy->insertRows(start, resolveRows(start, end), rowHeaders(start, end));
+            updateRowLabels();
+        }
+    }
+}
+
+void BarItemModelHandler::handleRowsMoved(const QModelIndex &sourceParent, int sourceStart,
+                                          int sourceEnd, const QModelIndex &destinationParent,
+                                          int destinationRow)
+{
+    // Moves within child rows do not affect the proxy
+    if (sourceParent.isValid() && destinationParent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (!m_proxy->useModelCategories() || sourceParent.isValid()
+                || destinationParent.isValid()) {
+            // If the data model doesn't directly map rows and columns, we cannot optimize.
+            // Moves to or from child rows change the number of top level rows.
+            AbstractItemModelHandler::handleRowsMoved(sourceParent, sourceStart, sourceEnd,
+                                                      destinationParent, destinationRow);
+        } else {
+            // Only the rows between the source and the destination change places,
+            // so refresh just that span without changing the row count.
+            int firstRow = qMin(sourceStart, destinationRow);
+            int lastRow = qMax(sourceEnd, destinationRow - 1);
+            m_proxy->setRows(firstRow, resolveRows(firstRow, lastRow),
+                             rowHeaders(firstRow, lastRow));
+        }
+    }
+}
+
+void BarItemModelHandler::handleRowsRemoved(const QModelIndex &parent, int start, int end)
+{
+    // Only top level rows are mapped to the proxy
+    if (parent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (!m_proxy->useModelCategories()) {
+            // If the data model doesn't directly map rows and columns, we cannot optimize
+            AbstractItemModelHandler::handleRowsRemoved(parent, start, end);
+        } else {
+            m_proxy->removeRows(start, end - start + 1);
+            updateRowLabels();
+        }
+    }
+}
+
+void BarItemModelHandler::modelPosToBarItem(int modelRow, int modelColumn, QBarDataItem &item)
+{
+    QModelIndex index = m_itemModel->index(modelRow, modelColumn);
+    QVariant valueVar = index.data(m_valueRole);
+    float value;
+    if (m_haveValuePattern)
+        value = valueVar.toString().replace(m_valuePattern, m_valueReplace).toFloat();
+    else
+        value = valueVar.toFloat();
+    item.setValue(value);
+    if (m_rotationRole != noRoleIndex) {
+        QVariant rotationVar = index.data(m_rotationRole);
+        float rotation;
+        if (m_haveRotationPattern) {
+            rotation = rotationVar.toString().replace(m_rotationPattern,
+                                                      m_rotationReplace).toFloat();
+        } else {
+            rotation = rotationVar.toFloat();
+        }
+        item.setRotation(rotation);
+    }
+}
+
+// Resolve the given model rows into new proxy rows. Only valid when using model categories.
+QBarDataArray BarItemModelHandler::resolveRows(int startRow, int endRow)
+{
+    QBarDataArray rows;
+    rows.reserve(endRow - startRow + 1);
+    for (int i = startRow; i <= endRow; i++) {
+        QBarDataRow *row = new QBarDataRow(m_columnCount);
+        for (int j = 0; j < m_columnCount; j++)
+            modelPosToBarItem(i, j, (*row)[j]);
+        rows.append(row);
+    }
+    return rows;
+}
+
+QStringList BarItemModelHandler::rowHeaders(int startRow, int endRow) const
+{
+    QStringList headers;
+    headers.reserve(endRow - startRow + 1);
+    for (int i = startRow; i <= endRow; i++)
+        headers << m_itemModel->headerData(i, Qt::Vertical).toString();
+    return headers;
+}
+
+// Inserting or removing rows can also change the headers of the rows that shifted,
+// for example when the model uses the default numbered headers.
+void BarItemModelHandler::updateRowLabels()
+{
+    QStringList labels = rowHeaders(0, m_itemModel->rowCount() - 1);
+    if (labels != m_proxy->rowLabels())
+        m_proxy->setRowLabels(labels);
+}
+
 // Resolve entire item model into QBarDataArray.
 void BarItemModelHandler::resolveModel()
 {
@@ -115,27 +232,8 @@ void BarItemModelHandler::resolveModel()
         }
         for (int i = 0; i < rowCount; i++) {
             QBarDataRow &newProxyRow = *m_proxyArray->at(i);
-            for (int j = 0; j < columnCount; j++) {
-                QModelIndex index = m_itemModel->index(i, j);
-                QVariant valueVar = index.data(m_valueRole);
-                float value;
-                if (m_haveValuePattern)
-                    value = valueVar.toString().replace(m_valuePattern, m_valueReplace).toFloat();
-                else
-                    value = valueVar.toFloat();
-                newProxyRow[j].setValue(value);
-                if (m_rotationRole != noRoleIndex) {
-                    QVariant rotationVar = index.data(m_rotationRole);
-                    float rotation;
-                    if (m_haveRotationPattern) {
-                        rotation = rotationVar.toString().replace(m_rotationPattern,
-                                                                  m_rotationReplace).toFloat();
-                    } else {
-                        rotation = rotationVar.toFloat();
-                    }
-                    newProxyRow[j].setRotation(rotation);
-                }
-            }
+            for (int j = 0; j < columnCount; j++)
+                modelPosToBarItem(i, j, newProxyRow[j]);
         }
         // Generate labels from headers if using model rows/columns
         for (int i = 0; i < rowCount; i++)
@@ -29,10 +29,19 @@ public:
 public Q_SLOTS:
     void handleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
                            const QList<int> &roles = QList<int>()) override;
+    void handleRowsInserted(const QModelIndex &parent, int start, int end) override;
+    void handleRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd,
+                         const QModelIndex &destinationParent, int destinationRow) override;
+    void handleRowsRemoved(const QModelIndex &parent, int start, int end) override;
 
 protected:
     void resolveModel() override;
 
+    void modelPosToBarItem(int modelRow, int modelColumn, QBarDataItem &item);
+    QBarDataArray resolveRows(int startRow, int endRow);
+    QStringList rowHeaders(int startRow, int endRow) const;
+    void updateRowLabels();
+
     QItemModelBarDataProxy *m_proxy; // Not owned
     QBarDataArray *m_proxyArray; // Not owned
     int m_columnCount;
@@ -48,6 +48,11 @@ bool CustomRenderItem::setMesh(const QString &meshFile)
     return m_object ? true : false;
 }
 
+void CustomRenderItem::rekeyMesh()
+{
+    ObjectHelper::rekeyObjectHelper(m_renderer, m_object);
+}
+
 void CustomRenderItem::setColorTable(const QList<QRgb> &colors)
 {
     m_colorTable.resize(256);
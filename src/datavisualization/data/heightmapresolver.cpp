@@ -0,0 +1,200 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "heightmapresolver_p.h"
+#include "rowchunks_p.h"
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVarLengthArray>
+
+QT_BEGIN_NAMESPACE
+
+// Smallest number of rows worth handing to a separate thread
+const int minRowsPerChunk = 64;
+
+struct HeightMapResolver::Job
+{
+    ~Job()
+    {
+        // Partial results of canceled jobs are released by whoever lets go of the job last
+        if (dataArray) {
+            qDeleteAll(*dataArray);
+            delete dataArray;
+        }
+    }
+
+    Parameters parameters;
+    RowReader reader;
+    QList<float> xValues;
+    QSurfaceDataArray *dataArray = nullptr;
+    QSurfaceDataRow **rows = nullptr;
+    // Cleared when the job is discarded. Background threads only post to the resolver while
+    // holding the mutex, so the resolver can not be destroyed under them.
+    HeightMapResolver *resolver = nullptr;
+    QMutex resolverMutex;
+    QAtomicInt rowsDone;
+    QAtomicInt canceled;
+    bool background = false;
+};
+
+HeightMapResolver::HeightMapResolver(QObject *parent)
+    : QObject(parent),
+      m_progress(1.0f)
+{
+}
+
+HeightMapResolver::~HeightMapResolver()
+{
+    // No signals are emitted during teardown
+    discardJob();
+}
+
+void HeightMapResolver::resolve(const Parameters &parameters, const RowReader &reader,
+                                bool background)
+{
+    cancel();
+
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->parameters = parameters;
+    job->reader = reader;
+    job->resolver = this;
+    job->background = background;
+    job->dataArray = new QSurfaceDataArray(parameters.rows, nullptr);
+    job->rows = job->dataArray->data();
+
+    // Last row and column are explicitly set to max values, as relying
+    // on multiplier can cause rounding errors, resulting in the value being
+    // slightly over the specified maximum, which in turn can lead to it not
+    // getting rendered.
+    const int lastColumn = parameters.columns - 1;
+    const float xMul = (parameters.maxXValue - parameters.minXValue) / float(lastColumn);
+    job->xValues.resize(parameters.columns);
+    for (int j = 0; j < lastColumn; j++)
+        job->xValues[j] = float(j) * xMul + parameters.minXValue;
+    if (lastColumn >= 0)
+        job->xValues[lastColumn] = parameters.maxXValue;
+
+    m_job = job;
+
+    if (background) {
+        setProgress(0.0f);
+        QThreadPool::globalInstance()->start([job]() {
+            resolveRows(job.get());
+            QMutexLocker locker(&job->resolverMutex);
+            if (HeightMapResolver *resolver = job->resolver) {
+                QMetaObject::invokeMethod(resolver, [resolver, job]() {
+                    resolver->finish(job);
+                }, Qt::QueuedConnection);
+            }
+        });
+    } else {
+        resolveRows(job.get());
+        finish(job);
+    }
+}
+
+void HeightMapResolver::cancel()
+{
+    if (!m_job)
+        return;
+
+    discardJob();
+    setProgress(1.0f);
+}
+
+void HeightMapResolver::discardJob()
+{
+    if (!m_job)
+        return;
+
+    // Background threads notice the cancel between rows and exit on their own
+    std::shared_ptr<Job> job = m_job;
+    m_job.reset();
+    job->canceled.storeRelaxed(1);
+    QMutexLocker locker(&job->resolverMutex);
+    job->resolver = nullptr;
+}
+
+void HeightMapResolver::resolveRows(Job *job)
+{
+    forEachRowChunk(job->parameters.rows, minRowsPerChunk, [job](int firstRow, int lastRow) {
+        resolveChunk(job, firstRow, lastRow);
+    });
+}
+
+void HeightMapResolver::resolveChunk(Job *job, int firstRow, int lastRow)
+{
+    const Parameters &parameters = job->parameters;
+    const int columns = parameters.columns;
+    const int lastDataRow = parameters.rows - 1;
+    const float zMul = (parameters.maxZValue - parameters.minZValue) / float(lastDataRow);
+    const float heightScale = parameters.heightScale;
+    const float heightOffset = parameters.heightOffset;
+    const float *xValues = job->xValues.constData();
+
+    QVarLengthArray<float, 1024> heights(columns);
+    float *heightData = heights.data();
+
+    for (int i = firstRow; i < lastRow; i++) {
+        if (job->canceled.loadRelaxed())
+            return;
+
+        job->reader(i, heightData);
+
+        // Kept free of branches so that the compiler can vectorize it
+        for (int j = 0; j < columns; j++)
+            heightData[j] = heightData[j] * heightScale + heightOffset;
+
+        float zVal;
+        if (i == lastDataRow)
+            zVal = parameters.maxZValue;
+        else
+            zVal = (float(i) * zMul) + parameters.minZValue;
+
+        QSurfaceDataRow *newRow = new QSurfaceDataRow(columns);
+        QSurfaceDataItem *items = newRow->data();
+        for (int j = 0; j < columns; j++)
+            items[j].setPosition(QVector3D(xValues[j], heightData[j], zVal));
+        job->rows[i] = newRow;
+
+        if (job->background) {
+            // Report progress in whole percents to keep the number of posted events low
+            const int done = job->rowsDone.fetchAndAddRelaxed(1) + 1;
+            const int percent = done * 100 / parameters.rows;
+            if (percent != (done - 1) * 100 / parameters.rows) {
+                QMutexLocker locker(&job->resolverMutex);
+                if (HeightMapResolver *resolver = job->resolver) {
+                    QMetaObject::invokeMethod(resolver, [resolver, job, percent]() {
+                        if (resolver->m_job.get() == job)
+                            resolver->setProgress(float(percent) / 100.0f);
+                    }, Qt::QueuedConnection);
+                }
+            }
+        }
+    }
+}
+
+void HeightMapResolver::setProgress(float progress)
+{
+    if (m_progress != progress) {
+        m_progress = progress;
+        emit progressChanged(m_progress);
+    }
+}
+
+void HeightMapResolver::finish(const std::shared_ptr<Job> &job)
+{
+    // A newer resolve or a cancel has already taken over
+    if (job != m_job)
+        return;
+
+    m_job.reset();
+    QSurfaceDataArray *dataArray = job->dataArray;
+    job->dataArray = nullptr;
+
+    setProgress(1.0f);
+    emit resolved(dataArray);
+}
+
+QT_END_NAMESPACE
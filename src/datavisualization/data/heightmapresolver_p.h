@@ -0,0 +1,79 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef HEIGHTMAPRESOLVER_P_H
+#define HEIGHTMAPRESOLVER_P_H
+
+#include "qsurfacedataproxy.h"
+#include <QtCore/QObject>
+#include <functional>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Turns a grid of height values into surface data rows. Rows are resolved in parallel chunks
+// on the global thread pool, either blocking the caller or entirely in the background.
+class HeightMapResolver : public QObject
+{
+    Q_OBJECT
+public:
+    // Fills heights with the raw height values of the given row, bottom row first
+    typedef std::function<void(int row, float *heights)> RowReader;
+
+    struct Parameters {
+        int columns = 0;
+        int rows = 0;
+        float minXValue = 0.0f;
+        float maxXValue = 0.0f;
+        float minZValue = 0.0f;
+        float maxZValue = 0.0f;
+        // Raw heights are mapped to heightScale * height + heightOffset
+        float heightScale = 1.0f;
+        float heightOffset = 0.0f;
+    };
+
+    HeightMapResolver(QObject *parent = 0);
+    virtual ~HeightMapResolver();
+
+    void resolve(const Parameters &parameters, const RowReader &reader, bool background);
+    // Discards any resolve in progress without waiting for the background threads
+    void cancel();
+
+    inline float progress() const { return m_progress; }
+    inline bool isResolving() const { return m_job != nullptr; }
+
+    // Images with at least this many pixels are resolved in the background
+    static const int backgroundResolveThreshold = 1024 * 1024;
+
+Q_SIGNALS:
+    void progressChanged(float progress);
+    void resolved(QSurfaceDataArray *dataArray);
+
+private:
+    struct Job;
+
+    static void resolveRows(Job *job);
+    static void resolveChunk(Job *job, int firstRow, int lastRow);
+    void setProgress(float progress);
+    void finish(const std::shared_ptr<Job> &job);
+    void discardJob();
+
+    std::shared_ptr<Job> m_job;
+    float m_progress;
+
+    Q_DISABLE_COPY(HeightMapResolver)
+};
+
+QT_END_NAMESPACE
+
+#endif
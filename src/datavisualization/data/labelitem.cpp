@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "labelitem_p.h"
+#include "glstatecache_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -29,6 +30,7 @@ QSize LabelItem::size() const
 void LabelItem::setTextureId(GLuint textureId)
 {
     QOpenGLContext::currentContext()->functions()->glDeleteTextures(1, &m_textureId);
+    GLStateCache::markTexturesChanged();
     m_textureId = textureId;
 }
 
@@ -39,8 +41,10 @@ GLuint LabelItem::textureId() const
 
 void LabelItem::clear()
 {
-    if (m_textureId && QOpenGLContext::currentContext())
+    if (m_textureId && QOpenGLContext::currentContext()) {
         QOpenGLContext::currentContext()->functions()->glDeleteTextures(1, &m_textureId);
+        GLStateCache::markTexturesChanged();
+    }
     m_textureId = 0;
     m_size = QSize(0, 0);
 }
@@ -3,9 +3,14 @@
 
 #include "qbardataproxy_p.h"
 #include "qbar3dseries_p.h"
+#include "rowchunks_p.h"
+#include <QtCore/QMutex>
 
 QT_BEGIN_NAMESPACE
 
+// Smallest number of items worth scanning for value limits in a separate thread
+const int minLimitItemsPerChunk = 16384;
+
 /*!
  * \class QBarDataProxy
  * \inmodule QtDataVisualization
@@ -737,20 +742,35 @@ QPair<GLfloat, GLfloat> QBarDataProxyPrivate::limitValues(int startRow, int endR
 {
     QPair<GLfloat, GLfloat> limits = qMakePair(0.0f, 0.0f);
     endRow = qMin(endRow, m_dataArray->size() - 1);
-    for (int i = startRow; i <= endRow; i++) {
-        QBarDataRow *row = m_dataArray->at(i);
-        if (row) {
-            int lastColumn = qMin(endColumn, row->size() - 1);
-            for (int j = startColumn; j <= lastColumn; j++) {
-                const QBarDataItem &item = row->at(j);
-                float itemValue = item.value();
-                if (limits.second < itemValue)
-                    limits.second = itemValue;
-                if (limits.first > itemValue)
-                    limits.first = itemValue;
+    if (endRow < startRow)
+        return limits;
+
+    // Rows are scanned in parallel for large arrays, and the limits of the chunks combined.
+    // Chunks are sized by items, with the width of the first row used for all rows.
+    const QBarDataRow *firstRow = m_dataArray->at(startRow);
+    const int columns = firstRow ? qMin(endColumn, int(firstRow->size()) - 1) - startColumn + 1 : 0;
+    QMutex limitsMutex;
+    forEachRowChunk(endRow - startRow + 1, minLimitItemsPerChunk / qMax(1, columns),
+                    [&](int firstChunkRow, int lastChunkRow) {
+        QPair<GLfloat, GLfloat> chunkLimits = qMakePair(0.0f, 0.0f);
+        for (int i = startRow + firstChunkRow; i < startRow + lastChunkRow; i++) {
+            QBarDataRow *row = m_dataArray->at(i);
+            if (row) {
+                int lastColumn = qMin(endColumn, row->size() - 1);
+                const QBarDataItem *items = row->constData();
+                for (int j = startColumn; j <= lastColumn; j++) {
+                    float itemValue = items[j].value();
+                    if (chunkLimits.second < itemValue)
+                        chunkLimits.second = itemValue;
+                    if (chunkLimits.first > itemValue)
+                        chunkLimits.first = itemValue;
+                }
             }
         }
-    }
+        QMutexLocker locker(&limitsMutex);
+        limits.first = qMin(limits.first, chunkLimits.first);
+        limits.second = qMax(limits.second, chunkLimits.second);
+    });
     return limits;
 }
 
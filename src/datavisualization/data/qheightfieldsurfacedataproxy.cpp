@@ -0,0 +1,487 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qheightfieldsurfacedataproxy_p.h"
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
+
+#include <climits>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+// Default ranges correspond value axis defaults
+const float defaultMinValue = 0.0f;
+const float defaultMaxValue = 10.0f;
+
+// Layout of the optional header at the start of a height field file, all values little-endian
+const char headerMagic[4] = { 'Q', 'D', 'V', 'H' };
+const int headerSize = 40;
+
+/*!
+ * \class QHeightFieldSurfaceDataProxy
+ * \inmodule QtDataVisualization
+ * \brief Proxy class for visualizing raw height fields with Q3DSurface.
+ * \since 6.10
+ *
+ * QHeightFieldSurfaceDataProxy visualizes a grid of raw height samples stored in a file.
+ * The file is memory-mapped instead of read, and only the samples inside the current window are
+ * materialized into the data array, taking every sampleStep sample in both directions. This makes
+ * it possible to browse height fields that are far larger than what a single surface can
+ * reasonably show, by moving the window and adjusting the sample step to the zoom level.
+ *
+ * The file contains the samples as little-endian 16-bit signed integers or 32-bit floats, row by
+ * row. Like with height map images, the first row in the file is the top row of the surface,
+ * that is, the row with the largest Z value. The dimensions of the grid, the sample type, and
+ * the value ranges are described either by a header at the start of the file or by a JSON
+ * sidecar file named after the height field file, with \c{.json} appended.
+ *
+ * The header is 40 bytes long and contains, in order, the characters \c{QDVH}, the 32-bit
+ * unsigned width and height of the grid, a 32-bit unsigned sample type that is \c{0} for 16-bit
+ * integers and \c{1} for 32-bit floats, and the 32-bit floating point minimum X, maximum X,
+ * minimum Z, maximum Z, height scale, and height offset values.
+ *
+ * The sidecar file contains a JSON object with the members \c{width}, \c{height}, and
+ * \c{sampleType}, which is either \c{"int16"} or \c{"float32"}. The optional members \c{offset},
+ * \c{minX}, \c{maxX}, \c{minZ}, \c{maxZ}, \c{heightScale}, and \c{heightOffset} give the byte
+ * offset of the first sample in the file, the value ranges, and the mapping of the samples to Y
+ * values. If a sidecar file exists, the height field file is not expected to have a header.
+ *
+ * The Y value of each data item is the sample multiplied by the height scale, with the height
+ * offset added. The X and Z ranges default to \c{[0...10]}, and cover the whole grid.
+ *
+ * \sa QHeightMapSurfaceDataProxy, {Qt Data Visualization Data Handling}
+ */
+
+/*!
+ * \qmltype HeightFieldSurfaceDataProxy
+ * \inqmlmodule QtDataVisualization
+ * \since 6.10
+ * \ingroup datavisualization_qml
+ * \nativetype QHeightFieldSurfaceDataProxy
+ * \inherits SurfaceDataProxy
+ * \brief Proxy type for visualizing raw height fields with Surface3D.
+ *
+ * HeightFieldSurfaceDataProxy visualizes a window of a memory-mapped grid of raw height samples.
+ *
+ * For more complete description, see QHeightFieldSurfaceDataProxy.
+ *
+ * \sa {Qt Data Visualization Data Handling}
+ */
+
+/*!
+ * \qmlproperty string HeightFieldSurfaceDataProxy::heightFieldFile
+ *
+ * The file with the raw height field to be visualized. Setting this property replaces current
+ * data with the height field data.
+ */
+
+/*!
+ * \qmlproperty size HeightFieldSurfaceDataProxy::fieldSize
+ * \readonly
+ *
+ * The number of samples in the whole height field, horizontally and vertically.
+ */
+
+/*!
+ * \qmlproperty rect HeightFieldSurfaceDataProxy::window
+ *
+ * The region of the height field that is visualized, in samples. An invalid rectangle, which is
+ * the default, shows the whole height field.
+ */
+
+/*!
+ * \qmlproperty int HeightFieldSurfaceDataProxy::sampleStep
+ *
+ * The distance between the visualized samples in both directions. Defaults to \c{1}, which shows
+ * every sample inside the window.
+ */
+
+/*!
+ * Constructs QHeightFieldSurfaceDataProxy with the given \a parent.
+ */
+QHeightFieldSurfaceDataProxy::QHeightFieldSurfaceDataProxy(QObject *parent) :
+    QSurfaceDataProxy(new QHeightFieldSurfaceDataProxyPrivate(this), parent)
+{
+}
+
+/*!
+ * Constructs QHeightFieldSurfaceDataProxy from the given height field \a filename and \a parent.
+ *
+ * \sa heightFieldFile
+ */
+QHeightFieldSurfaceDataProxy::QHeightFieldSurfaceDataProxy(const QString &filename,
+                                                           QObject *parent) :
+    QSurfaceDataProxy(new QHeightFieldSurfaceDataProxyPrivate(this), parent)
+{
+    setHeightFieldFile(filename);
+}
+
+/*!
+ * \internal
+ */
+QHeightFieldSurfaceDataProxy::QHeightFieldSurfaceDataProxy(
+        QHeightFieldSurfaceDataProxyPrivate *d, QObject *parent) :
+    QSurfaceDataProxy(d, parent)
+{
+}
+
+/*!
+ * Destroys QHeightFieldSurfaceDataProxy.
+ */
+QHeightFieldSurfaceDataProxy::~QHeightFieldSurfaceDataProxy()
+{
+}
+
+/*!
+ * \property QHeightFieldSurfaceDataProxy::heightFieldFile
+ *
+ * \brief The name of the file with the raw height field to be visualized.
+ *
+ * Setting this property memory-maps the file and replaces current data with the height field
+ * data. The data is resolved asynchronously. QSurfaceDataProxy::arrayReset() is emitted when
+ * the data has been resolved.
+ */
+void QHeightFieldSurfaceDataProxy::setHeightFieldFile(const QString &filename)
+{
+    dptr()->setHeightFieldFile(filename);
+}
+
+QString QHeightFieldSurfaceDataProxy::heightFieldFile() const
+{
+    return dptrc()->m_heightFieldFile;
+}
+
+/*!
+ * \property QHeightFieldSurfaceDataProxy::fieldSize
+ *
+ * \brief The number of samples in the whole height field, horizontally and vertically.
+ *
+ * The size is empty if no height field file is set or the file could not be opened.
+ */
+QSize QHeightFieldSurfaceDataProxy::fieldSize() const
+{
+    return dptrc()->m_fieldSize;
+}
+
+/*!
+ * \property QHeightFieldSurfaceDataProxy::window
+ *
+ * \brief The region of the height field that is visualized, in samples.
+ *
+ * Only the samples inside the window are materialized into the data array. The window is clipped
+ * to the height field. An invalid rectangle, which is the default, shows the whole height field.
+ *
+ * \sa sampleStep
+ */
+void QHeightFieldSurfaceDataProxy::setWindow(const QRect &window)
+{
+    dptr()->setWindow(window);
+}
+
+QRect QHeightFieldSurfaceDataProxy::window() const
+{
+    return dptrc()->m_window;
+}
+
+/*!
+ * \property QHeightFieldSurfaceDataProxy::sampleStep
+ *
+ * \brief The distance between the visualized samples in both directions.
+ *
+ * Defaults to \c{1}, which shows every sample inside the window. Larger values show every
+ * sampleStep sample, which reduces the size of the data array when viewing large windows.
+ * The first row and column of the window are always included.
+ *
+ * \sa window
+ */
+void QHeightFieldSurfaceDataProxy::setSampleStep(int step)
+{
+    dptr()->setSampleStep(step);
+}
+
+int QHeightFieldSurfaceDataProxy::sampleStep() const
+{
+    return dptrc()->m_sampleStep;
+}
+
+/*!
+ * \internal
+ */
+QHeightFieldSurfaceDataProxyPrivate *QHeightFieldSurfaceDataProxy::dptr()
+{
+    return static_cast<QHeightFieldSurfaceDataProxyPrivate *>(d_ptr.data());
+}
+
+/*!
+ * \internal
+ */
+const QHeightFieldSurfaceDataProxyPrivate *QHeightFieldSurfaceDataProxy::dptrc() const
+{
+    return static_cast<const QHeightFieldSurfaceDataProxyPrivate *>(d_ptr.data());
+}
+
+//  QHeightFieldSurfaceDataProxyPrivate
+
+QHeightFieldSurfaceDataProxyPrivate::QHeightFieldSurfaceDataProxyPrivate(
+        QHeightFieldSurfaceDataProxy *q)
+    : QSurfaceDataProxyPrivate(q),
+      m_samples(0),
+      m_sampleType(SampleInt16),
+      m_dataOffset(0),
+      m_minXValue(defaultMinValue),
+      m_maxXValue(defaultMaxValue),
+      m_minZValue(defaultMinValue),
+      m_maxZValue(defaultMaxValue),
+      m_heightScale(1.0f),
+      m_heightOffset(0.0f),
+      m_sampleStep(1)
+{
+    m_resolveTimer.setSingleShot(true);
+    QObject::connect(&m_resolveTimer, &QTimer::timeout,
+                     this, &QHeightFieldSurfaceDataProxyPrivate::handlePendingResolve);
+    QObject::connect(&m_resolver, &HeightMapResolver::resolved,
+                     this, &QHeightFieldSurfaceDataProxyPrivate::handleResolved);
+}
+
+QHeightFieldSurfaceDataProxyPrivate::~QHeightFieldSurfaceDataProxyPrivate()
+{
+    closeHeightField();
+}
+
+QHeightFieldSurfaceDataProxy *QHeightFieldSurfaceDataProxyPrivate::qptr()
+{
+    return static_cast<QHeightFieldSurfaceDataProxy *>(q_ptr);
+}
+
+void QHeightFieldSurfaceDataProxyPrivate::setHeightFieldFile(const QString &filename)
+{
+    QSize oldSize = m_fieldSize;
+
+    closeHeightField();
+    m_heightFieldFile = filename;
+    if (!m_heightFieldFile.isEmpty() && !openHeightField())
+        closeHeightField();
+
+    emit qptr()->heightFieldFileChanged(m_heightFieldFile);
+    if (oldSize != m_fieldSize)
+        emit qptr()->fieldSizeChanged(m_fieldSize);
+
+    // We do resolving asynchronously to make qml onArrayReset handlers actually get the initial reset
+    if (!m_resolveTimer.isActive())
+        m_resolveTimer.start(0);
+}
+
+void QHeightFieldSurfaceDataProxyPrivate::setWindow(const QRect &window)
+{
+    if (m_window != window) {
+        m_window = window;
+        emit qptr()->windowChanged(m_window);
+
+        if (!m_resolveTimer.isActive())
+            m_resolveTimer.start(0);
+    }
+}
+
+void QHeightFieldSurfaceDataProxyPrivate::setSampleStep(int step)
+{
+    if (step < 1) {
+        qWarning() << "Warning: Tried to set invalid sample step:" << step
+                   << "Sample step must be at least 1.";
+        return;
+    }
+    if (m_sampleStep != step) {
+        m_sampleStep = step;
+        emit qptr()->sampleStepChanged(m_sampleStep);
+
+        if (!m_resolveTimer.isActive())
+            m_resolveTimer.start(0);
+    }
+}
+
+bool QHeightFieldSurfaceDataProxyPrivate::openHeightField()
+{
+    m_file = std::make_shared<QFile>(m_heightFieldFile);
+    if (!m_file->open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open height field file:" << m_heightFieldFile;
+        return false;
+    }
+
+    if (!readDescription(m_heightFieldFile + QStringLiteral(".json")))
+        return false;
+
+    const qint64 sampleSize = m_sampleType == SampleInt16 ? 2 : 4;
+    const qint64 dataSize = qint64(m_fieldSize.width()) * m_fieldSize.height() * sampleSize;
+    if (m_dataOffset < 0 || m_file->size() < m_dataOffset + dataSize) {
+        qWarning() << "Height field file" << m_heightFieldFile << "is too small for a"
+                   << m_fieldSize << "grid.";
+        return false;
+    }
+
+    const uchar *mapping = m_file->map(0, m_dataOffset + dataSize);
+    if (!mapping) {
+        qWarning() << "Failed to map height field file:" << m_heightFieldFile
+                   << m_file->errorString();
+        return false;
+    }
+    m_samples = mapping + m_dataOffset;
+
+    return true;
+}
+
+void QHeightFieldSurfaceDataProxyPrivate::closeHeightField()
+{
+    // Background threads of a canceled resolve may still be reading the mapped samples. Their
+    // row reader shares the file, which is unmapped when the last of them lets go of it.
+    m_resolver.cancel();
+
+    m_samples = 0;
+    m_file.reset();
+    m_fieldSize = QSize();
+    m_dataOffset = 0;
+    m_minXValue = defaultMinValue;
+    m_maxXValue = defaultMaxValue;
+    m_minZValue = defaultMinValue;
+    m_maxZValue = defaultMaxValue;
+    m_heightScale = 1.0f;
+    m_heightOffset = 0.0f;
+}
+
+bool QHeightFieldSurfaceDataProxyPrivate::readDescription(const QString &filename)
+{
+    int width = 0;
+    int height = 0;
+    int sampleType = -1;
+
+    if (QFileInfo::exists(filename)) {
+        QFile sidecar(filename);
+        QJsonParseError error;
+        QJsonDocument document;
+        if (sidecar.open(QIODevice::ReadOnly))
+            document = QJsonDocument::fromJson(sidecar.readAll(), &error);
+        if (!document.isObject()) {
+            qWarning() << "Failed to read height field description:" << filename
+                       << error.errorString();
+            return false;
+        }
+
+        const QJsonObject description = document.object();
+        width = description.value(QLatin1String("width")).toInt();
+        height = description.value(QLatin1String("height")).toInt();
+        const QString type = description.value(QLatin1String("sampleType")).toString();
+        if (type == QLatin1String("int16"))
+            sampleType = SampleInt16;
+        else if (type == QLatin1String("float32"))
+            sampleType = SampleFloat32;
+        m_dataOffset = description.value(QLatin1String("offset")).toInteger(0);
+        m_minXValue = description.value(QLatin1String("minX")).toDouble(defaultMinValue);
+        m_maxXValue = description.value(QLatin1String("maxX")).toDouble(defaultMaxValue);
+        m_minZValue = description.value(QLatin1String("minZ")).toDouble(defaultMinValue);
+        m_maxZValue = description.value(QLatin1String("maxZ")).toDouble(defaultMaxValue);
+        m_heightScale = description.value(QLatin1String("heightScale")).toDouble(1.0);
+        m_heightOffset = description.value(QLatin1String("heightOffset")).toDouble(0.0);
+    } else {
+        uchar header[headerSize];
+        if (m_file->read(reinterpret_cast<char *>(header), headerSize) != headerSize
+                || memcmp(header, headerMagic, sizeof(headerMagic)) != 0) {
+            qWarning() << "Height field file" << m_heightFieldFile
+                       << "has neither a header nor a description file.";
+            return false;
+        }
+
+        width = int(qMin(qFromLittleEndian<quint32>(header + 4), quint32(INT_MAX)));
+        height = int(qMin(qFromLittleEndian<quint32>(header + 8), quint32(INT_MAX)));
+        const quint32 type = qFromLittleEndian<quint32>(header + 12);
+        if (type == 0)
+            sampleType = SampleInt16;
+        else if (type == 1)
+            sampleType = SampleFloat32;
+        m_dataOffset = headerSize;
+        m_minXValue = qFromLittleEndian<float>(header + 16);
+        m_maxXValue = qFromLittleEndian<float>(header + 20);
+        m_minZValue = qFromLittleEndian<float>(header + 24);
+        m_maxZValue = qFromLittleEndian<float>(header + 28);
+        m_heightScale = qFromLittleEndian<float>(header + 32);
+        m_heightOffset = qFromLittleEndian<float>(header + 36);
+    }
+
+    if (width <= 0 || height <= 0 || sampleType < 0) {
+        qWarning() << "Invalid height field description for" << m_heightFieldFile;
+        return false;
+    }
+    if (m_minXValue >= m_maxXValue || m_minZValue >= m_maxZValue) {
+        qWarning() << "Invalid value ranges for height field" << m_heightFieldFile;
+        return false;
+    }
+
+    m_fieldSize = QSize(width, height);
+    m_sampleType = SampleType(sampleType);
+    return true;
+}
+
+QRect QHeightFieldSurfaceDataProxyPrivate::effectiveWindow() const
+{
+    const QRect field(QPoint(0, 0), m_fieldSize);
+    if (!m_window.isValid())
+        return field;
+    return m_window.intersected(field);
+}
+
+void QHeightFieldSurfaceDataProxyPrivate::handlePendingResolve()
+{
+    const QRect window = m_samples ? effectiveWindow() : QRect();
+    const int step = m_sampleStep;
+    const int columns = window.isEmpty() ? 0 : (window.width() - 1) / step + 1;
+    const int rows = window.isEmpty() ? 0 : (window.height() - 1) / step + 1;
+    const int firstColumn = window.left();
+    const int lastSampledRow = window.top() + (rows - 1) * step;
+
+    // Positions of the sampled rows and columns within the whole field
+    const float xStep = m_fieldSize.width() > 1
+            ? (m_maxXValue - m_minXValue) / float(m_fieldSize.width() - 1) : 0.0f;
+    const float zStep = m_fieldSize.height() > 1
+            ? (m_maxZValue - m_minZValue) / float(m_fieldSize.height() - 1) : 0.0f;
+
+    HeightMapResolver::Parameters parameters;
+    parameters.columns = columns;
+    parameters.rows = rows;
+    parameters.minXValue = m_minXValue + float(firstColumn) * xStep;
+    parameters.maxXValue = m_minXValue + float(firstColumn + (columns - 1) * step) * xStep;
+    parameters.minZValue = m_maxZValue - float(lastSampledRow) * zStep;
+    parameters.maxZValue = m_maxZValue - float(window.top()) * zStep;
+    parameters.heightScale = m_heightScale;
+    parameters.heightOffset = m_heightOffset;
+
+    // Data rows go from the bottom of the window up, i.e. from the last sampled file row
+    const uchar *samples = m_samples;
+    const qint64 fieldWidth = m_fieldSize.width();
+    HeightMapResolver::RowReader reader;
+    // Readers hold a reference to the file to keep the samples mapped while the job runs
+    if (m_sampleType == SampleInt16) {
+        reader = [=, file = m_file](int row, float *heights) {
+            const uchar *line = samples
+                    + ((lastSampledRow - qint64(row) * step) * fieldWidth + firstColumn) * 2;
+            for (int j = 0; j < columns; j++)
+                heights[j] = float(qFromLittleEndian<qint16>(line + qint64(j) * step * 2));
+        };
+    } else {
+        reader = [=, file = m_file](int row, float *heights) {
+            const uchar *line = samples
+                    + ((lastSampledRow - qint64(row) * step) * fieldWidth + firstColumn) * 4;
+            for (int j = 0; j < columns; j++)
+                heights[j] = qFromLittleEndian<float>(line + qint64(j) * step * 4);
+        };
+    }
+
+    const bool background = qint64(columns) * rows >= HeightMapResolver::backgroundResolveThreshold;
+    m_resolver.resolve(parameters, reader, background);
+}
+
+void QHeightFieldSurfaceDataProxyPrivate::handleResolved(QSurfaceDataArray *dataArray)
+{
+    qptr()->resetArray(dataArray);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,56 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QHEIGHTFIELDSURFACEDATAPROXY_H
+#define QHEIGHTFIELDSURFACEDATAPROXY_H
+
+#include <QtDataVisualization/qsurfacedataproxy.h>
+#include <QtCore/QRect>
+#include <QtCore/QString>
+
+QT_BEGIN_NAMESPACE
+
+class QHeightFieldSurfaceDataProxyPrivate;
+
+class Q_DATAVISUALIZATION_EXPORT QHeightFieldSurfaceDataProxy : public QSurfaceDataProxy
+{
+    Q_OBJECT
+    Q_PROPERTY(QString heightFieldFile READ heightFieldFile WRITE setHeightFieldFile NOTIFY heightFieldFileChanged)
+    Q_PROPERTY(QSize fieldSize READ fieldSize NOTIFY fieldSizeChanged)
+    Q_PROPERTY(QRect window READ window WRITE setWindow NOTIFY windowChanged)
+    Q_PROPERTY(int sampleStep READ sampleStep WRITE setSampleStep NOTIFY sampleStepChanged)
+
+public:
+    explicit QHeightFieldSurfaceDataProxy(QObject *parent = nullptr);
+    explicit QHeightFieldSurfaceDataProxy(const QString &filename, QObject *parent = nullptr);
+    virtual ~QHeightFieldSurfaceDataProxy();
+
+    void setHeightFieldFile(const QString &filename);
+    QString heightFieldFile() const;
+
+    QSize fieldSize() const;
+
+    void setWindow(const QRect &window);
+    QRect window() const;
+    void setSampleStep(int step);
+    int sampleStep() const;
+
+Q_SIGNALS:
+    void heightFieldFileChanged(const QString &filename);
+    void fieldSizeChanged(const QSize &size);
+    void windowChanged(const QRect &window);
+    void sampleStepChanged(int step);
+
+protected:
+    explicit QHeightFieldSurfaceDataProxy(QHeightFieldSurfaceDataProxyPrivate *d,
+                                          QObject *parent = nullptr);
+    QHeightFieldSurfaceDataProxyPrivate *dptr();
+    const QHeightFieldSurfaceDataProxyPrivate *dptrc() const;
+
+private:
+    Q_DISABLE_COPY(QHeightFieldSurfaceDataProxy)
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef QHEIGHTFIELDSURFACEDATAPROXY_P_H
+#define QHEIGHTFIELDSURFACEDATAPROXY_P_H
+
+#include "qheightfieldsurfacedataproxy.h"
+#include "qsurfacedataproxy_p.h"
+#include "heightmapresolver_p.h"
+#include <QtCore/QFile>
+#include <QtCore/QTimer>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QHeightFieldSurfaceDataProxyPrivate : public QSurfaceDataProxyPrivate
+{
+    Q_OBJECT
+
+public:
+    enum SampleType {
+        SampleInt16,
+        SampleFloat32
+    };
+
+    QHeightFieldSurfaceDataProxyPrivate(QHeightFieldSurfaceDataProxy *q);
+    virtual ~QHeightFieldSurfaceDataProxyPrivate();
+
+    void setHeightFieldFile(const QString &filename);
+    void setWindow(const QRect &window);
+    void setSampleStep(int step);
+
+private:
+    QHeightFieldSurfaceDataProxy *qptr();
+    bool openHeightField();
+    void closeHeightField();
+    bool readDescription(const QString &filename);
+    QRect effectiveWindow() const;
+    void handlePendingResolve();
+    void handleResolved(QSurfaceDataArray *dataArray);
+
+    QString m_heightFieldFile;
+    // Shared with the row readers of running resolves
+    std::shared_ptr<QFile> m_file;
+    const uchar *m_samples;
+    QSize m_fieldSize;
+    SampleType m_sampleType;
+    qint64 m_dataOffset;
+    float m_minXValue;
+    float m_maxXValue;
+    float m_minZValue;
+    float m_maxZValue;
+    float m_heightScale;
+    float m_heightOffset;
+
+    QRect m_window;
+    int m_sampleStep;
+
+    QTimer m_resolveTimer;
+    HeightMapResolver m_resolver;
+
+    friend class QHeightFieldSurfaceDataProxy;
+};
+
+QT_END_NAMESPACE
+
+#endif
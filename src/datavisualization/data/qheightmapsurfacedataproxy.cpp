@@ -57,8 +57,19 @@ const float defaultMaxValue = 10.0f;
  * QImage::Format_RGB32 in grayscale.
  *
  * The height of the image is read from the red component of the pixels if the image is in grayscale,
- * otherwise it is an average calculated from red, green and blue components of the pixels. Using
- * grayscale images may improve data conversion speed for large images.
+ * otherwise it is an average calculated from red, green and blue components of the pixels.
+ * Images in QImage::Format_Grayscale8, QImage::Format_Grayscale16, 32-bit RGB, 64-bit RGB, and
+ * 32-bit floating point RGB formats are read without conversion. Floating point height values are
+ * used as such, or treated as being in the range \c{[0...1]} when \c{autoScaleY} is enabled.
+ * Premultiplied images are converted to non-premultiplied ones first.
+ *
+ * \note Since Qt 6.10, heights of QImage::Format_Grayscale16 images are read from the full 16-bit
+ * value, giving heights in the range \c{[0...65535]} when \c{autoScaleY} is disabled. Earlier
+ * versions only read the low byte of each pixel.
+ *
+ * \note Since Qt 6.10, heights of 64-bit RGB images are always the average of the 16-bit red,
+ * green, and blue components, also when all pixels are gray. Earlier versions read only the low
+ * byte of the red component of gray 64-bit images, so their heights change accordingly.
  *
  * Since height maps do not contain values for X or Z axes, those values need to be given
  * separately using minXValue, maxXValue, minZValue, and maxZValue properties. X-value corresponds
@@ -126,6 +137,16 @@ const float defaultMaxValue = 10.0f;
  * the height values are scaled to fit on the Y-axis between \c{minYValue} and \c{maxYValue}.
  */
 
+/*!
+ * \qmlproperty real HeightMapSurfaceDataProxy::resolveProgress
+ * \since 6.10
+ * \readonly
+ *
+ * The progress of resolving the current height map, in the range \c{[0...1]}. Large height maps
+ * are resolved in a background thread, and this property can be used to show the progress of
+ * the resolve. It is \c{1.0} when no resolve is in progress.
+ */
+
 /*!
  * Constructs QHeightMapSurfaceDataProxy with the given \a parent.
  */
@@ -192,12 +213,24 @@ QHeightMapSurfaceDataProxy::~QHeightMapSurfaceDataProxy()
  *
  * The height of the \a image is read from the red component of the pixels if the \a image is in
  * grayscale, otherwise it is an average calculated from red, green, and blue components of the
- * pixels. Using grayscale images may improve data conversion speed for large images.
+ * pixels. Images in QImage::Format_Grayscale8, QImage::Format_Grayscale16, 32-bit RGB, 64-bit
+ * RGB, and 32-bit floating point RGB formats are read without conversion. Floating point height
+ * values are used as such, or treated as being in the range \c{[0...1]} when autoScaleY is
+ * enabled. Premultiplied images are converted to non-premultiplied ones first.
+ *
+ * \note Since Qt 6.10, heights of QImage::Format_Grayscale16 images are read from the full 16-bit
+ * value, giving heights in the range \c{[0...65535]} when autoScaleY is disabled. Earlier
+ * versions only read the low byte of each pixel.
+ *
+ * \note Since Qt 6.10, heights of 64-bit RGB images are always the average of the 16-bit red,
+ * green, and blue components, also when all pixels are gray. Earlier versions read only the low
+ * byte of the red component of gray 64-bit images, so their heights change accordingly.
  *
  * Not recommended formats: all mono formats (for example QImage::Format_Mono).
  *
  * The height map is resolved asynchronously. QSurfaceDataProxy::arrayReset() is emitted when the
- * data has been resolved.
+ * data has been resolved. Height maps of a million pixels or more are resolved in a background
+ * thread, in which case resolveProgress reports the progress.
  */
 void QHeightMapSurfaceDataProxy::setHeightMap(const QImage &image)
 {
@@ -396,6 +429,23 @@ bool QHeightMapSurfaceDataProxy::autoScaleY() const
     return dptrc()->m_autoScaleY;
 }
 
+/*!
+ * \property QHeightMapSurfaceDataProxy::resolveProgress
+ * \since 6.10
+ *
+ * \brief The progress of resolving the current height map.
+ *
+ * The value is in the range \c{[0...1]}, and \c{1.0} when no resolve is in progress.
+ * Height maps of a million pixels or more are resolved in a background thread, leaving the
+ * UI responsive while they load. This property can be used to show the progress of such a resolve.
+ *
+ * \sa heightMap
+ */
+float QHeightMapSurfaceDataProxy::resolveProgress() const
+{
+    return dptrc()->m_resolver.progress();
+}
+
 /*!
  * \internal
  */
@@ -427,10 +477,18 @@ QHeightMapSurfaceDataProxyPrivate::QHeightMapSurfaceDataProxyPrivate(QHeightMapS
     m_resolveTimer.setSingleShot(true);
     QObject::connect(&m_resolveTimer, &QTimer::timeout,
                      this, &QHeightMapSurfaceDataProxyPrivate::handlePendingResolve);
+    QObject::connect(&m_resolver, &HeightMapResolver::resolved,
+                     this, &QHeightMapSurfaceDataProxyPrivate::handleResolved);
+    QObject::connect(&m_resolver, &HeightMapResolver::progressChanged, this, [this](float progress) {
+        emit qptr()->resolveProgressChanged(progress);
+    });
 }
 
 QHeightMapSurfaceDataProxyPrivate::~QHeightMapSurfaceDataProxyPrivate()
 {
+    // The proxy is already gone, so the resolver must not report anything to it anymore
+    QObject::disconnect(&m_resolver, nullptr, this, nullptr);
+    m_resolver.cancel();
 }
 
 QHeightMapSurfaceDataProxy *QHeightMapSurfaceDataProxyPrivate::qptr()
@@ -635,117 +693,126 @@ void QHeightMapSurfaceDataProxyPrivate::setAutoScaleY(bool enabled)
 void QHeightMapSurfaceDataProxyPrivate::handlePendingResolve()
 {
     QImage heightImage = m_heightMap;
-    int bytesInChannel = 1;
     float yMul = 1.0f / UINT8_MAX;
 
-    bool is16bit = (heightImage.format() == QImage::Format_RGBX64
-                    || heightImage.format() == QImage::Format_RGBA64
-                    || heightImage.format() == QImage::Format_RGBA64_Premultiplied
-                    || heightImage.format() == QImage::Format_Grayscale16);
-
-    // Convert to RGB32 to be sure we're reading the right bytes
-    if (is16bit) {
-        if (heightImage.format() != QImage::Format_RGBX64)
-            heightImage = heightImage.convertToFormat(QImage::Format_RGBX64);
-
-        bytesInChannel = 2;
+    // Read the common formats directly, anything else is converted first
+    // Premultiplied colors are converted first, as alpha must not affect the heights
+    switch (heightImage.format()) {
+    case QImage::Format_Grayscale8:
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+        break;
+    case QImage::Format_ARGB32_Premultiplied:
+        heightImage = heightImage.convertToFormat(QImage::Format_ARGB32);
+        break;
+    case QImage::Format_Grayscale16:
+    case QImage::Format_RGBX64:
+    case QImage::Format_RGBA64:
         yMul = 1.0f / UINT16_MAX;
-    } else if (heightImage.format() != QImage::Format_RGB32) {
+        break;
+    case QImage::Format_RGBA64_Premultiplied:
+        heightImage = heightImage.convertToFormat(QImage::Format_RGBA64);
+        yMul = 1.0f / UINT16_MAX;
+        break;
+    case QImage::Format_RGBX32FPx4:
+    case QImage::Format_RGBA32FPx4:
+        yMul = 1.0f;
+        break;
+    case QImage::Format_RGBA32FPx4_Premultiplied:
+        heightImage = heightImage.convertToFormat(QImage::Format_RGBA32FPx4);
+        yMul = 1.0f;
+        break;
+    case QImage::Format_RGBX16FPx4:
+    case QImage::Format_RGBA16FPx4:
+        heightImage = heightImage.convertToFormat(QImage::Format_RGBX32FPx4);
+        yMul = 1.0f;
+        break;
+    case QImage::Format_RGBA16FPx4_Premultiplied:
+        heightImage = heightImage.convertToFormat(QImage::Format_RGBA32FPx4);
+        yMul = 1.0f;
+        break;
+    default:
         heightImage = heightImage.convertToFormat(QImage::Format_RGB32);
+        break;
     }
 
-    uchar *bits = heightImage.bits();
-
-    int imageHeight = heightImage.height();
-    int imageWidth = heightImage.width();
-    int bitCount = imageWidth * 4 * (imageHeight - 1) * bytesInChannel;
-    int widthBits = imageWidth * 4 * bytesInChannel;
-    float height = 0;
-
-    // Do not recreate array if dimensions have not changed
-    QSurfaceDataArray *dataArray = m_dataArray;
-    if (imageWidth != qptr()->columnCount() || imageHeight != dataArray->size()) {
-        dataArray = new QSurfaceDataArray;
-        dataArray->reserve(imageHeight);
-        for (int i = 0; i < imageHeight; i++) {
-            QSurfaceDataRow *newProxyRow = new QSurfaceDataRow(imageWidth);
-            dataArray->append(newProxyRow);
-        }
-    }
-    yMul *= m_maxYValue - m_minYValue;
-    float xMul = (m_maxXValue - m_minXValue) / float(imageWidth - 1);
-    float zMul = (m_maxZValue - m_minZValue) / float(imageHeight - 1);
-
-    // Last row and column are explicitly set to max values, as relying
-    // on multiplier can cause rounding errors, resulting in the value being
-    // slightly over the specified maximum, which in turn can lead to it not
-    // getting rendered.
-    int lastRow = imageHeight - 1;
-    int lastCol = imageWidth - 1;
-    if (heightImage.isGrayscale()) {
-        // Grayscale, it's enough to read Red byte
-        for (int i = 0; i < imageHeight; i++, bitCount -= widthBits) {
-            QSurfaceDataRow &newRow = *dataArray->at(i);
-            float zVal;
-            if (i == lastRow)
-                zVal = m_maxZValue;
-            else
-                zVal = (float(i) * zMul) + m_minZValue;
-            int j = 0;
-            float yVal = 0;
-            uchar *pixelptr;
-            for (; j < lastCol; j++) {
-                pixelptr  = (uchar *)(bits + bitCount + (j * 4 * bytesInChannel));
-                if (!m_autoScaleY)
-                    yVal = *pixelptr;
-                else
-                    yVal = float(*pixelptr) * yMul + m_minYValue;
-                newRow[j].setPosition(QVector3D((float(j) * xMul) + m_minXValue,
-                                                yVal,
-                                                zVal));
+    // Heights of RGB pixels are the average of the color components, which for grayscale images
+    // equals the red component. Scanlines are read bottom up, as the first data row is the
+    // bottom row of the image.
+    const int imageHeight = heightImage.height();
+    const int imageWidth = heightImage.width();
+    HeightMapResolver::RowReader reader;
+    switch (heightImage.format()) {
+    case QImage::Format_Grayscale8:
+        reader = [heightImage, imageWidth, imageHeight](int row, float *heights) {
+            const uchar *pixels = heightImage.constScanLine(imageHeight - 1 - row);
+            for (int j = 0; j < imageWidth; j++)
+                heights[j] = float(pixels[j]);
+        };
+        break;
+    case QImage::Format_Grayscale16:
+        reader = [heightImage, imageWidth, imageHeight](int row, float *heights) {
+            const quint16 *pixels = reinterpret_cast<const quint16 *>(
+                        heightImage.constScanLine(imageHeight - 1 - row));
+            for (int j = 0; j < imageWidth; j++)
+                heights[j] = float(pixels[j]);
+        };
+        break;
+    case QImage::Format_RGBX64:
+    case QImage::Format_RGBA64:
+        reader = [heightImage, imageWidth, imageHeight](int row, float *heights) {
+            const quint16 *pixels = reinterpret_cast<const quint16 *>(
+                        heightImage.constScanLine(imageHeight - 1 - row));
+            for (int j = 0; j < imageWidth; j++) {
+                const quint16 *pixel = pixels + j * 4;
+                heights[j] = float(pixel[0] + pixel[1] + pixel[2]) / 3.0f;
             }
-            newRow[j].setPosition(QVector3D(m_maxXValue,
-                                            yVal,
-                                            zVal));
-        }
-    } else {
-        // Not grayscale, we'll need to calculate height from RGB
-        for (int i = 0; i < imageHeight; i++, bitCount -= widthBits) {
-            QSurfaceDataRow &newRow = *dataArray->at(i);
-            float zVal;
-            if (i == lastRow)
-                zVal = m_maxZValue;
-            else
-                zVal = (float(i) * zMul) + m_minZValue;
-            int j = 0;
-            float yVal = 0;
-            for (; j < lastCol; j++) {
-                int nextpixel = j * 4 * bytesInChannel;
-                uchar *pixelptr = (uchar *)(bits + bitCount + nextpixel);
-                if (is16bit) {
-                    height = float(*((ushort *)pixelptr))
-                        + float(*(((ushort *)pixelptr) + 1))
-                        + float(*(((ushort *)pixelptr) + 2));
-                } else {
-                    height = (float(*pixelptr)
-                            + float(*(pixelptr + 1))
-                            + float(*(pixelptr + 2)));
-                }
-                if (!m_autoScaleY)
-                    yVal = height / 3.0f;
-                else
-                    yVal = (height / 3.0f * yMul) + m_minYValue;
-
-                newRow[j].setPosition(QVector3D((float(j) * xMul) + m_minXValue,
-                                                yVal,
-                                                zVal));
+        };
+        break;
+    case QImage::Format_RGBX32FPx4:
+    case QImage::Format_RGBA32FPx4:
+        reader = [heightImage, imageWidth, imageHeight](int row, float *heights) {
+            const float *pixels = reinterpret_cast<const float *>(
+                        heightImage.constScanLine(imageHeight - 1 - row));
+            for (int j = 0; j < imageWidth; j++) {
+                const float *pixel = pixels + j * 4;
+                heights[j] = (pixel[0] + pixel[1] + pixel[2]) / 3.0f;
             }
-            newRow[j].setPosition(QVector3D(m_maxXValue,
-                                            yVal,
-                                            zVal));
-        }
+        };
+        break;
+    default:
+        reader = [heightImage, imageWidth, imageHeight](int row, float *heights) {
+            const QRgb *pixels = reinterpret_cast<const QRgb *>(
+                        heightImage.constScanLine(imageHeight - 1 - row));
+            for (int j = 0; j < imageWidth; j++) {
+                const QRgb pixel = pixels[j];
+                heights[j] = float(((pixel >> 16) & 0xff) + ((pixel >> 8) & 0xff)
+                                   + (pixel & 0xff)) / 3.0f;
+            }
+        };
+        break;
+    }
+
+    HeightMapResolver::Parameters parameters;
+    parameters.columns = imageWidth;
+    parameters.rows = imageHeight;
+    parameters.minXValue = m_minXValue;
+    parameters.maxXValue = m_maxXValue;
+    parameters.minZValue = m_minZValue;
+    parameters.maxZValue = m_maxZValue;
+    if (m_autoScaleY) {
+        parameters.heightScale = yMul * (m_maxYValue - m_minYValue);
+        parameters.heightOffset = m_minYValue;
     }
 
+    // Large height maps are resolved in the background to keep the UI responsive
+    const bool background = qint64(imageWidth) * imageHeight
+            >= HeightMapResolver::backgroundResolveThreshold;
+    m_resolver.resolve(parameters, reader, background);
+}
+
+void QHeightMapSurfaceDataProxyPrivate::handleResolved(QSurfaceDataArray *dataArray)
+{
     qptr()->resetArray(dataArray);
     emit qptr()->heightMapChanged(m_heightMap);
 }
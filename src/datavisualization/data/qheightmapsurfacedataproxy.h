@@ -25,6 +25,7 @@ class Q_DATAVISUALIZATION_EXPORT QHeightMapSurfaceDataProxy : public QSurfaceDat
     Q_PROPERTY(float minYValue READ minYValue WRITE setMinYValue NOTIFY minYValueChanged REVISION(6, 3))
     Q_PROPERTY(float maxYValue READ maxYValue WRITE setMaxYValue NOTIFY maxYValueChanged REVISION(6, 3))
     Q_PROPERTY(bool autoScaleY READ autoScaleY WRITE setAutoScaleY NOTIFY autoScaleYChanged REVISION(6, 3))
+    Q_PROPERTY(float resolveProgress READ resolveProgress NOTIFY resolveProgressChanged REVISION(6, 10))
 
 public:
     explicit QHeightMapSurfaceDataProxy(QObject *parent = nullptr);
@@ -52,6 +53,7 @@ public:
     float maxYValue() const;
     void setAutoScaleY(bool enabled);
     bool autoScaleY() const;
+    float resolveProgress() const;
 
 Q_SIGNALS:
     void heightMapChanged(const QImage &image);
@@ -63,6 +65,7 @@ Q_SIGNALS:
     Q_REVISION(6, 3) void minYValueChanged(float value);
     Q_REVISION(6, 3) void maxYValueChanged(float value);
     Q_REVISION(6, 3) void autoScaleYChanged(bool enabled);
+    Q_REVISION(6, 10) void resolveProgressChanged(float progress);
 
 protected:
     explicit QHeightMapSurfaceDataProxy(QHeightMapSurfaceDataProxyPrivate *d, QObject *parent = nullptr);
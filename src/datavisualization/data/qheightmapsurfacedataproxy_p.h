@@ -16,6 +16,7 @@
 
 #include "qheightmapsurfacedataproxy.h"
 #include "qsurfacedataproxy_p.h"
+#include "heightmapresolver_p.h"
 #include <QtCore/QTimer>
 
 QT_BEGIN_NAMESPACE
@@ -39,10 +40,12 @@ public:
 private:
     QHeightMapSurfaceDataProxy *qptr();
     void handlePendingResolve();
+    void handleResolved(QSurfaceDataArray *dataArray);
 
     QImage m_heightMap;
     QString m_heightMapFile;
     QTimer m_resolveTimer;
+    HeightMapResolver m_resolver;
 
     float m_minXValue;
     float m_maxXValue;
@@ -98,6 +98,18 @@ QT_BEGIN_NAMESPACE
  * The preset default is \c 0.0.
  */
 
+/*!
+ * \qmlproperty bool Scatter3DSeries::aggregationEnabled
+ * \since 6.10
+ *
+ * Whether items in dense regions are drawn as aggregates. When enabled, the
+ * graph divides the scene into a grid of cells tied to the view size and zoom
+ * level, and draws one representative item for each occupied cell. Zooming in
+ * makes the grid finer, until the items are drawn individually. Only applies to
+ * graphs using the default optimization hint.
+ * The preset default is \c false.
+ */
+
 /*!
  * \qmlproperty int Scatter3DSeries::invalidSelectionIndex
  * A constant property providing an invalid index for selection. This index is
@@ -223,6 +235,41 @@ float QScatter3DSeries::itemSize() const
     return dptrc()->m_itemSize;
 }
 
+/*!
+ * \property QScatter3DSeries::aggregationEnabled
+ * \since 6.10
+ *
+ * \brief Whether items in dense regions are drawn as aggregates.
+ *
+ * When \c true, the graph divides the scene into a grid of cells, and draws only
+ * one representative item for each occupied cell. The grid resolution is tied to
+ * the size of the view and the zoom level, so that a cell covers a few pixels.
+ * Zooming in makes the grid finer, until the items are drawn individually.
+ * Changes to single items move them between the cells without binning the
+ * whole series again.
+ *
+ * Selecting a representative item selects that item. The selected item is
+ * always drawn.
+ *
+ * Aggregation only applies to graphs using QAbstract3DGraph::OptimizationDefault.
+ * With QAbstract3DGraph::OptimizationStatic, all items are drawn from a single
+ * buffer.
+ *
+ * The preset default is \c false.
+ */
+void QScatter3DSeries::setAggregationEnabled(bool enable)
+{
+    if (enable != dptrc()->m_aggregationEnabled) {
+        dptr()->setAggregationEnabled(enable);
+        emit aggregationEnabledChanged(enable);
+    }
+}
+
+bool QScatter3DSeries::isAggregationEnabled() const
+{
+    return dptrc()->m_aggregationEnabled;
+}
+
 /*!
  * Returns an invalid index for selection. This index is set to the selectedItem
  * property to clear the selection from this series.
@@ -255,7 +302,8 @@ const QScatter3DSeriesPrivate *QScatter3DSeries::dptrc() const
 QScatter3DSeriesPrivate::QScatter3DSeriesPrivate(QScatter3DSeries *q)
     : QAbstract3DSeriesPrivate(q, QAbstract3DSeries::SeriesTypeScatter),
       m_selectedItem(Scatter3DController::invalidSelectionIndex()),
-      m_itemSize(0.0f)
+      m_itemSize(0.0f),
+      m_aggregationEnabled(false)
 {
     m_itemLabelFormat = QStringLiteral("@xLabel, @yLabel, @zLabel");
     m_mesh = QAbstract3DSeries::MeshSphere;
@@ -366,4 +414,11 @@ void QScatter3DSeriesPrivate::setItemSize(float size)
         m_controller->markSeriesVisualsDirty();
 }
 
+void QScatter3DSeriesPrivate::setAggregationEnabled(bool enable)
+{
+    m_aggregationEnabled = enable;
+    if (m_controller)
+        m_controller->markSeriesVisualsDirty();
+}
+
 QT_END_NAMESPACE
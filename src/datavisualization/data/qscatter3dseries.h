@@ -17,6 +17,7 @@ class Q_DATAVISUALIZATION_EXPORT QScatter3DSeries : public QAbstract3DSeries
     Q_PROPERTY(QScatterDataProxy *dataProxy READ dataProxy WRITE setDataProxy NOTIFY dataProxyChanged)
     Q_PROPERTY(int selectedItem READ selectedItem WRITE setSelectedItem NOTIFY selectedItemChanged)
     Q_PROPERTY(float itemSize READ itemSize WRITE setItemSize NOTIFY itemSizeChanged)
+    Q_PROPERTY(bool aggregationEnabled READ isAggregationEnabled WRITE setAggregationEnabled NOTIFY aggregationEnabledChanged REVISION(6, 10))
 
 public:
     explicit QScatter3DSeries(QObject *parent = nullptr);
@@ -33,10 +34,14 @@ public:
     void setItemSize(float size);
     float itemSize() const;
 
+    void setAggregationEnabled(bool enable);
+    bool isAggregationEnabled() const;
+
 Q_SIGNALS:
     void dataProxyChanged(QScatterDataProxy *proxy);
     void selectedItemChanged(int index);
     void itemSizeChanged(float size);
+    Q_REVISION(6, 10) void aggregationEnabledChanged(bool enabled);
 
 protected:
     explicit QScatter3DSeries(QScatter3DSeriesPrivate *d, QObject *parent = nullptr);
@@ -32,11 +32,13 @@ public:
 
     void setSelectedItem(int index);
     void setItemSize(float size);
+    void setAggregationEnabled(bool enable);
 
 private:
     QScatter3DSeries *qptr();
     int m_selectedItem;
     float m_itemSize;
+    bool m_aggregationEnabled;
 
 private:
     friend class QScatter3DSeries;
@@ -4,6 +4,9 @@
 #include "qscatterdataproxy_p.h"
 #include "qscatter3dseries_p.h"
 #include "qabstract3daxis_p.h"
+#include <QtCore/QDebug>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -57,6 +60,16 @@ QT_BEGIN_NAMESPACE
  * The series this proxy is attached to.
  */
 
+/*!
+ * \qmlproperty int ScatterDataProxy::capacity
+ * \since 6.10
+ *
+ * The maximum number of items the array holds. Once the array is full, added
+ * items overwrite the oldest items. Arrays that are reset or inserted into
+ * lose the items at their start that do not fit. Defaults to \c{0}, which
+ * means no limit.
+ */
+
 /*!
  * Constructs QScatterDataProxy with the given \a parent.
  */
@@ -93,7 +106,8 @@ QScatter3DSeries *QScatterDataProxy::series() const
 /*!
  * Takes ownership of the array \a newArray. Clears the existing array if the
  * new array differs from it. If the arrays are the same, this function
- * just triggers the arrayReset() signal.
+ * just triggers the arrayReset() signal. If the array exceeds capacity, the
+ * items at its start are removed.
  *
  * Passing a null array deletes the old array and creates a new empty array.
  */
@@ -126,12 +140,17 @@ void QScatterDataProxy::setItems(int index, const QScatterDataArray &items)
 }
 
 /*!
- * Adds the item \a item to the end of the array.
+ * Adds the item \a item to the end of the array. If the array has reached
+ * capacity, the item replaces the oldest item instead, and the selection is
+ * cleared if it was on the replaced item.
  *
  * Returns the index of the added item.
  */
 int QScatterDataProxy::addItem(const QScatterDataItem &item)
 {
+    if (dptr()->m_capacity > 0)
+        return dptr()->addItemsCircular(&item, 1);
+
     int addIndex = dptr()->addItem(item);
     emit itemsAdded(addIndex, 1);
     emit itemCountChanged(itemCount());
@@ -139,12 +158,17 @@ int QScatterDataProxy::addItem(const QScatterDataItem &item)
 }
 
 /*!
- * Adds the items specified by \a items to the end of the array.
+ * Adds the items specified by \a items to the end of the array. If the array
+ * reaches capacity, the rest of the items replace the oldest items instead,
+ * and the selection is cleared if it was on a replaced item.
  *
  * Returns the index of the first added item.
  */
 int QScatterDataProxy::addItems(const QScatterDataArray &items)
 {
+    if (dptr()->m_capacity > 0)
+        return dptr()->addItemsCircular(items.constData(), items.size());
+
     int addIndex = dptr()->addItems(items);
     emit itemsAdded(addIndex, items.size());
     emit itemCountChanged(itemCount());
@@ -153,23 +177,29 @@ int QScatterDataProxy::addItems(const QScatterDataArray &items)
 
 /*!
  * Inserts the item \a item to the position \a index. If the index is equal to
- * the data array size, the item is added to the array.
+ * the data array size, the item is added to the array. If the array exceeds
+ * capacity, the items at the start of the array are removed.
  */
 void QScatterDataProxy::insertItem(int index, const QScatterDataItem &item)
 {
     dptr()->insertItem(index, item);
     emit itemsInserted(index, 1);
+    if (int removeCount = dptr()->trimToCapacity())
+        emit itemsRemoved(0, removeCount);
     emit itemCountChanged(itemCount());
 }
 
 /*!
  * Inserts the items specified by \a items to the position \a index. If the
- * index is equal to data array size, the items are added to the array.
+ * index is equal to data array size, the items are added to the array. If the
+ * array exceeds capacity, the items at the start of the array are removed.
  */
 void QScatterDataProxy::insertItems(int index, const QScatterDataArray &items)
 {
     dptr()->insertItems(index, items);
     emit itemsInserted(index, items.size());
+    if (int removeCount = dptr()->trimToCapacity())
+        emit itemsRemoved(0, removeCount);
     emit itemCountChanged(itemCount());
 }
 
@@ -188,6 +218,49 @@ void QScatterDataProxy::removeItems(int index, int removeCount)
     emit itemCountChanged(itemCount());
 }
 
+/*!
+ * \property QScatterDataProxy::capacity
+ * \since 6.10
+ *
+ * \brief The maximum number of items the array holds.
+ *
+ * Once the array holds this many items, addItem() and addItems() overwrite the
+ * oldest items in place instead of growing the array, and emit itemsChanged()
+ * for the overwritten range. The array is then used as a ring buffer, so
+ * streamed data can be shown for a fixed window without removing items from
+ * the start of the array, which would move all the remaining items.
+ *
+ * Setting the capacity restores the chronological order of the items and
+ * removes the oldest items that do not fit, emitting arrayReset() if the array
+ * changes. The selected item of the series follows its item. resetArray(),
+ * insertItem() and insertItems() remove the items that do not fit from the
+ * start of the array. Changes to the array other than adding items make the
+ * next overwrite start from the beginning of the array.
+ *
+ * Defaults to \c{0}, which means no limit.
+ */
+void QScatterDataProxy::setCapacity(int capacity)
+{
+    if (capacity < 0) {
+        qWarning() << __FUNCTION__ << "Cannot set negative value.";
+        return;
+    }
+    if (capacity == dptrc()->m_capacity)
+        return;
+
+    const bool arrayChanged = dptr()->setCapacity(capacity);
+    emit capacityChanged(capacity);
+    if (arrayChanged) {
+        emit arrayReset();
+        emit itemCountChanged(itemCount());
+    }
+}
+
+int QScatterDataProxy::capacity() const
+{
+    return dptrc()->m_capacity;
+}
+
 /*!
  * \property QScatterDataProxy::itemCount
  *
@@ -280,7 +353,9 @@ const QScatterDataProxyPrivate *QScatterDataProxy::dptrc() const
 
 QScatterDataProxyPrivate::QScatterDataProxyPrivate(QScatterDataProxy *q)
     : QAbstractDataProxyPrivate(q, QAbstractDataProxy::DataTypeScatter),
-      m_dataArray(new QScatterDataArray)
+      m_dataArray(new QScatterDataArray),
+      m_capacity(0),
+      m_writeIndex(0)
 {
 }
 
@@ -300,6 +375,8 @@ void QScatterDataProxyPrivate::resetArray(QScatterDataArray *newArray)
         delete m_dataArray;
         m_dataArray = newArray;
     }
+    m_writeIndex = 0;
+    trimToCapacity();
 }
 
 void QScatterDataProxyPrivate::setItem(int index, const QScatterDataItem &item)
@@ -333,6 +410,7 @@ void QScatterDataProxyPrivate::insertItem(int index, const QScatterDataItem &ite
 {
     Q_ASSERT(index >= 0 && index <= m_dataArray->size());
     m_dataArray->insert(index, item);
+    m_writeIndex = 0;
 }
 
 void QScatterDataProxyPrivate::insertItems(int index, const QScatterDataArray &items)
@@ -340,6 +418,7 @@ void QScatterDataProxyPrivate::insertItems(int index, const QScatterDataArray &i
     Q_ASSERT(index >= 0 && index <= m_dataArray->size());
     for (int i = 0; i < items.size(); i++)
         m_dataArray->insert(index++, items.at(i));
+    m_writeIndex = 0;
 }
 
 void QScatterDataProxyPrivate::removeItems(int index, int removeCount)
@@ -348,6 +427,108 @@ void QScatterDataProxyPrivate::removeItems(int index, int removeCount)
     int maxRemoveCount = m_dataArray->size() - index;
     removeCount = qMin(removeCount, maxRemoveCount);
     m_dataArray->remove(index, removeCount);
+    m_writeIndex = 0;
+}
+
+int QScatterDataProxyPrivate::addItemsCircular(const QScatterDataItem *items, int count)
+{
+    QScatterDataProxy *q = qptr();
+
+    // Only the newest items fit
+    if (count > m_capacity) {
+        items += count - m_capacity;
+        count = m_capacity;
+    }
+
+    // Grow the array until it is full
+    const int addIndex = m_dataArray->size();
+    const int addCount = qBound(0, m_capacity - addIndex, count);
+    if (addCount) {
+        m_dataArray->reserve(m_capacity);
+        for (int i = 0; i < addCount; i++)
+            m_dataArray->append(items[i]);
+        items += addCount;
+        emit q->itemsAdded(addIndex, addCount);
+    }
+
+    // Overwrite the oldest items, in at most two ranges if the write position wraps around
+    const int firstIndex = addCount ? addIndex : m_writeIndex;
+    int remaining = count - addCount;
+    while (remaining > 0) {
+        const int startIndex = m_writeIndex;
+        const int changeCount = qMin(remaining, m_capacity - startIndex);
+        for (int i = 0; i < changeCount; i++)
+            (*m_dataArray)[startIndex + i] = items[i];
+        items += changeCount;
+        remaining -= changeCount;
+        m_writeIndex = (startIndex + changeCount) % m_capacity;
+        clearOverwrittenSelection(startIndex, changeCount);
+        emit q->itemsChanged(startIndex, changeCount);
+    }
+
+    if (addCount)
+        emit q->itemCountChanged(m_dataArray->size());
+
+    return firstIndex;
+}
+
+bool QScatterDataProxyPrivate::setCapacity(int capacity)
+{
+    m_capacity = capacity;
+
+    // Only arrayReset() is emitted, so the selection is moved along with its item here
+    QScatter3DSeries *series = qptr()->series();
+    const int oldSelectedItem = series ? series->selectedItem()
+                                       : QScatter3DSeries::invalidSelectionIndex();
+    int selectedItem = oldSelectedItem;
+
+    bool arrayChanged = false;
+    if (m_writeIndex) {
+        // Restore the chronological order
+        const int size = m_dataArray->size();
+        std::rotate(m_dataArray->begin(), m_dataArray->begin() + m_writeIndex,
+                    m_dataArray->end());
+        if (selectedItem >= 0 && selectedItem < size)
+            selectedItem = (selectedItem - m_writeIndex + size) % size;
+        m_writeIndex = 0;
+        arrayChanged = true;
+    }
+    if (int removeCount = trimToCapacity()) {
+        if (selectedItem >= 0) {
+            selectedItem = selectedItem >= removeCount
+                    ? selectedItem - removeCount : QScatter3DSeries::invalidSelectionIndex();
+        }
+        arrayChanged = true;
+    }
+
+    if (selectedItem != oldSelectedItem)
+        series->setSelectedItem(selectedItem);
+    return arrayChanged;
+}
+
+// Removes the items at the start of the array that do not fit in the capacity.
+// Returns the number of removed items.
+int QScatterDataProxyPrivate::trimToCapacity()
+{
+    const int removeCount = m_capacity ? m_dataArray->size() - m_capacity : 0;
+    if (removeCount <= 0)
+        return 0;
+
+    m_dataArray->remove(0, removeCount);
+    m_writeIndex = 0;
+    return removeCount;
+}
+
+// An overwritten item is a different item, so it must not stay selected
+void QScatterDataProxyPrivate::clearOverwrittenSelection(int startIndex, int count)
+{
+    QScatter3DSeries *series = qptr()->series();
+    if (!series)
+        return;
+
+    const int selectedItem = series->selectedItem();
+    if (selectedItem >= startIndex && selectedItem < startIndex + count)
+        series->setSelectedItem(QScatter3DSeries::invalidSelectionIndex());
 }
 
 void QScatterDataProxyPrivate::limitValues(QVector3D &minValues, QVector3D &maxValues,
@@ -22,6 +22,7 @@ class Q_DATAVISUALIZATION_EXPORT QScatterDataProxy : public QAbstractDataProxy
 
     Q_PROPERTY(int itemCount READ itemCount NOTIFY itemCountChanged)
     Q_PROPERTY(QScatter3DSeries *series READ series NOTIFY seriesChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged REVISION(6, 10))
 
 public:
     explicit QScatterDataProxy(QObject *parent = nullptr);
@@ -45,6 +46,9 @@ public:
 
     void removeItems(int index, int removeCount);
 
+    void setCapacity(int capacity);
+    int capacity() const;
+
 Q_SIGNALS:
     void arrayReset();
     void itemsAdded(int startIndex, int count);
@@ -54,6 +58,7 @@ Q_SIGNALS:
 
     void itemCountChanged(int count);
     void seriesChanged(QScatter3DSeries *series);
+    Q_REVISION(6, 10) void capacityChanged(int capacity);
 
 protected:
     explicit QScatterDataProxy(QScatterDataProxyPrivate *d, QObject *parent = nullptr);
@@ -37,6 +37,9 @@ public:
     void insertItem(int index, const QScatterDataItem &item);
     void insertItems(int index, const QScatterDataArray &items);
     void removeItems(int index, int removeCount);
+    int addItemsCircular(const QScatterDataItem *items, int count);
+    bool setCapacity(int capacity);
+    int trimToCapacity();
     void limitValues(QVector3D &minValues, QVector3D &maxValues, QAbstract3DAxis *axisX,
                      QAbstract3DAxis *axisY, QAbstract3DAxis *axisZ) const;
     bool isValidValue(float axisValue, float value, QAbstract3DAxis *axis) const;
@@ -44,7 +47,12 @@ public:
     void setSeries(QAbstract3DSeries *series) override;
 private:
     QScatterDataProxy *qptr();
+    void clearOverwrittenSelection(int startIndex, int count);
+
     QScatterDataArray *m_dataArray;
+    int m_capacity;
+    // Index of the oldest item, which the next add overwrites once the capacity is reached
+    int m_writeIndex;
 
     friend class QScatterDataProxy;
 };
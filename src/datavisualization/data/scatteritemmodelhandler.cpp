@@ -28,57 +28,95 @@ void ScatterItemModelHandler::handleDataChanged(const QModelIndex &topLeft,
                                                 const QModelIndex &bottomRight,
                                                 const QList<int> &roles)
 {
+    // Only top level rows are mapped to the proxy
+    if (topLeft.parent().isValid())
+        return;
+
     // Do nothing if full reset already pending
     if (!m_fullReset) {
-        if (m_itemModel->columnCount() > 1) {
-            // If the data model is multi-column, do full asynchronous reset to simplify things
-            AbstractItemModelHandler::handleDataChanged(topLeft, bottomRight, roles);
-        } else {
-            int start = qMin(topLeft.row(), bottomRight.row());
-            int end = qMax(topLeft.row(), bottomRight.row());
+        // Changes to roles we do not map cannot affect the proxy
+        if (!roles.isEmpty() && !roles.contains(m_xPosRole) && !roles.contains(m_yPosRole)
+                && !roles.contains(m_zPosRole) && !roles.contains(m_rotationRole)) {
+            return;
+        }
 
-            QScatterDataArray array(end - start + 1);
-            int count = 0;
-            for (int i = start; i <= end; i++)
-                modelPosToScatterItem(i, 0, array[count++]);
+        const int columnCount = m_itemModel->columnCount();
+        int startRow = qMin(topLeft.row(), bottomRight.row());
+        int endRow = qMax(topLeft.row(), bottomRight.row());
+        int startCol = qMin(topLeft.column(), bottomRight.column());
+        int endCol = qMax(topLeft.column(), bottomRight.column());
 
-            m_proxy->setItems(start, array);
+        if (startCol == 0 && endCol == columnCount - 1) {
+            // Whole rows changed, which map to a single contiguous range of items
+            m_proxy->setItems(startRow * columnCount, resolveRows(startRow, endRow));
+        } else {
+            for (int i = startRow; i <= endRow; i++) {
+                QScatterDataArray array(endCol - startCol + 1);
+                int count = 0;
+                for (int j = startCol; j <= endCol; j++)
+                    modelPosToScatterItem(i, j, array[count++]);
+                m_proxy->setItems(i * columnCount + startCol, array);
+            }
         }
     }
 }
 
 void ScatterItemModelHandler::handleRowsInserted(const QModelIndex &parent, int start, int end)
 {
+    // Only top level rows are mapped to the proxy
+    if (parent.isValid())
+        return;
+
     // Do nothing if full reset already pending
     if (!m_fullReset) {
-        if (!m_proxy->itemCount() || m_itemModel->columnCount() > 1) {
+        if (!m_proxy->itemCount()) {
             // If inserting into an empty array, do full asynchronous reset to avoid multiple
             // separate inserts when initializing the model.
-            // If the data model is multi-column, do full asynchronous reset to simplify things
             AbstractItemModelHandler::handleRowsInserted(parent, start, end);
         } else {
-            QScatterDataArray array(end - start + 1);
-            int count = 0;
-            for (int i = start; i <= end; i++)
-                modelPosToScatterItem(i, 0, array[count++]);
+            const int columnCount = m_itemModel->columnCount();
+            m_proxy->insertItems(start * columnCount, resolveRows(start, end));
+        }
+    }
+}
 
-            m_proxy->insertItems(start, array);
+void ScatterItemModelHandler::handleRowsMoved(const QModelIndex &sourceParent, int sourceStart,
+                                              int sourceEnd,
+                                              const QModelIndex &destinationParent,
+                                              int destinationRow)
+{
+    // Moves within child rows do not affect the proxy
+    if (sourceParent.isValid() && destinationParent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (sourceParent.isValid() || destinationParent.isValid()) {
+            // Moves to or from child rows change the number of top level rows
+            AbstractItemModelHandler::handleRowsMoved(sourceParent, sourceStart, sourceEnd,
+                                                      destinationParent, destinationRow);
+            return;
         }
+
+        // Only the rows between the source and the destination change places,
+        // so refresh just the items of that span without changing the item count.
+        const int columnCount = m_itemModel->columnCount();
+        int firstRow = qMin(sourceStart, destinationRow);
+        int lastRow = qMax(sourceEnd, destinationRow - 1);
+        m_proxy->setItems(firstRow * columnCount, resolveRows(firstRow, lastRow));
     }
 }
 
 void ScatterItemModelHandler::handleRowsRemoved(const QModelIndex &parent, int start, int end)
 {
-    Q_UNUSED(parent);
+    // Only top level rows are mapped to the proxy
+    if (parent.isValid())
+        return;
 
     // Do nothing if full reset already pending
     if (!m_fullReset) {
-        if (m_itemModel->columnCount() > 1) {
-            // If the data model is multi-column, do full asynchronous reset to simplify things
-            AbstractItemModelHandler::handleRowsRemoved(parent, start, end);
-        } else {
-            m_proxy->removeItems(start, end - start + 1);
-        }
+        const int columnCount = m_itemModel->columnCount();
+        m_proxy->removeItems(start * columnCount, (end - start + 1) * columnCount);
     }
 }
 
@@ -166,6 +204,19 @@ void ScatterItemModelHandler::modelPosToScatterItem(int modelRow, int modelColum
     item.setPosition(QVector3D(xPos, yPos, zPos));
 }
 
+// Resolve the items of the given model rows, in the same order as resolveModel() lays them out.
+QScatterDataArray ScatterItemModelHandler::resolveRows(int startRow, int endRow)
+{
+    const int columnCount = m_itemModel->columnCount();
+    QScatterDataArray array((endRow - startRow + 1) * columnCount);
+    int count = 0;
+    for (int i = startRow; i <= endRow; i++) {
+        for (int j = 0; j < columnCount; j++)
+            modelPosToScatterItem(i, j, array[count++]);
+    }
+    return array;
+}
+
 // Resolve entire item model into QScatterDataArray.
 void ScatterItemModelHandler::resolveModel()
 {
@@ -30,6 +30,8 @@ public Q_SLOTS:
     void handleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
                            const QList<int> &roles = QList<int>()) override;
     void handleRowsInserted(const QModelIndex &parent, int start, int end) override;
+    void handleRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd,
+                         const QModelIndex &destinationParent, int destinationRow) override;
     void handleRowsRemoved(const QModelIndex &parent, int start, int end) override;
 
 protected:
@@ -37,6 +39,7 @@ protected:
 
 private:
     void modelPosToScatterItem(int modelRow, int modelColumn, QScatterDataItem &item);
+    QScatterDataArray resolveRows(int startRow, int endRow);
 
     QItemModelScatterDataProxy *m_proxy; // Not owned
     QScatterDataArray *m_proxyArray; // Not owned
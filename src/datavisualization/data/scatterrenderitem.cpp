@@ -5,21 +5,41 @@
 
 QT_BEGIN_NAMESPACE
 
-ScatterRenderItem::ScatterRenderItem()
-    : AbstractRenderItem(),
-      m_visible(false)
+ScatterRenderItemArray::ScatterRenderItemArray()
 {
 }
 
-ScatterRenderItem::ScatterRenderItem(const ScatterRenderItem &other)
-    : AbstractRenderItem(other)
+ScatterRenderItemArray::~ScatterRenderItemArray()
 {
-    m_position = other.m_position;
-    m_visible = other.m_visible;
 }
 
-ScatterRenderItem::~ScatterRenderItem()
+void ScatterRenderItemArray::resize(int size)
 {
+    m_positions.resize(size);
+    m_translations.resize(size);
+    // Default constructed quaternions are identity rotations
+    if (!m_rotations.isEmpty())
+        m_rotations.resize(size);
+    m_visibility.resize(size);
+}
+
+void ScatterRenderItemArray::clear()
+{
+    m_positions.clear();
+    m_translations.clear();
+    m_rotations.clear();
+    m_visibility.clear();
+}
+
+void ScatterRenderItemArray::setRotation(int index, const QQuaternion &rotation)
+{
+    const bool identity = rotation.isNull() || rotation.isIdentity();
+    if (m_rotations.isEmpty()) {
+        if (identity)
+            return;
+        m_rotations.resize(m_translations.size());
+    }
+    m_rotations[index] = identity ? identityQuaternion : rotation;
 }
 
 QT_END_NAMESPACE
@@ -14,33 +14,59 @@
 #ifndef SCATTERRENDERITEM_P_H
 #define SCATTERRENDERITEM_P_H
 
-#include "abstractrenderitem_p.h"
+#include "datavisualizationglobal_p.h"
+#include <QtCore/QBitArray>
+#include <QtCore/QList>
 
 QT_BEGIN_NAMESPACE
 
-class ScatterRenderItem : public AbstractRenderItem
+// Render data of the items of a scatter series, stored as separate arrays. Rotations are only
+// stored after an item gets a rotation other than identity.
+class Q_DATAVISUALIZATION_EXPORT ScatterRenderItemArray
 {
 public:
-    ScatterRenderItem();
-    ScatterRenderItem(const ScatterRenderItem &other);
-    ScatterRenderItem &operator=(const ScatterRenderItem &) = default;
-    virtual ~ScatterRenderItem();
+    ScatterRenderItemArray();
+    ~ScatterRenderItemArray();
 
-    inline const QVector3D &position() const { return m_position; }
-    inline void setPosition(const QVector3D &pos)
+    inline int size() const { return int(m_translations.size()); }
+    inline bool isEmpty() const { return m_translations.isEmpty(); }
+    void resize(int size);
+    void clear();
+
+    // Position in data space
+    inline const QVector3D &position(int index) const { return m_positions.at(index); }
+    inline void setPosition(int index, const QVector3D &position)
+    {
+        m_positions[index] = position;
+    }
+
+    // Position in 3D scene
+    inline const QVector3D &translation(int index) const { return m_translations.at(index); }
+    inline void setTranslation(int index, const QVector3D &translation)
     {
-        if (m_position != pos)
-            m_position = pos;
+        m_translations[index] = translation;
     }
 
-    inline bool isVisible() const { return m_visible; }
-    inline void setVisible(bool visible) { m_visible = visible; }
+    inline QQuaternion rotation(int index) const
+    {
+        return m_rotations.isEmpty() ? identityQuaternion : m_rotations.at(index);
+    }
+    void setRotation(int index, const QQuaternion &rotation);
+
+    inline bool isVisible(int index) const { return m_visibility.testBit(index); }
+    inline void setVisible(int index, bool visible) { m_visibility.setBit(index, visible); }
+    inline int visibleCount() const { return int(m_visibility.count(true)); }
+
+    // Contiguous arrays that can be uploaded to vertex buffers as is
+    inline const QList<QVector3D> &positions() const { return m_positions; }
+    inline const QList<QVector3D> &translations() const { return m_translations; }
 
-protected:
-    QVector3D m_position;
-    bool m_visible;
+private:
+    QList<QVector3D> m_positions;
+    QList<QVector3D> m_translations;
+    QList<QQuaternion> m_rotations;
+    QBitArray m_visibility;
 };
-typedef QList<ScatterRenderItem> ScatterRenderItemArray;
 
 QT_END_NAMESPACE
 
@@ -26,58 +26,180 @@ void SurfaceItemModelHandler::handleDataChanged(const QModelIndex &topLeft,
                                                 const QModelIndex &bottomRight,
                                                 const QList<int> &roles)
 {
+    // Only top level rows are mapped to the proxy
+    if (topLeft.parent().isValid())
+        return;
+
     // Do nothing if full reset already pending
     if (!m_fullReset) {
         if (!m_proxy->useModelCategories()) {
             // If the data model doesn't directly map rows and columns, we cannot optimize
             AbstractItemModelHandler::handleDataChanged(topLeft, bottomRight, roles);
         } else {
+            // Changes to roles we do not map cannot affect the proxy
+            if (!roles.isEmpty() && !roles.contains(m_xPosRole) && !roles.contains(m_yPosRole)
+                    && !roles.contains(m_zPosRole)) {
+                return;
+            }
+
             int startRow = qMin(topLeft.row(), bottomRight.row());
             int endRow = qMax(topLeft.row(), bottomRight.row());
             int startCol = qMin(topLeft.column(), bottomRight.column());
             int endCol = qMax(topLeft.column(), bottomRight.column());
 
-            for (int i = startRow; i <= endRow; i++) {
-                for (int j = startCol; j <= endCol; j++) {
-                    QModelIndex index = m_itemModel->index(i, j);
-                    QSurfaceDataItem item;
-                    QVariant xValueVar = index.data(m_xPosRole);
-                    QVariant yValueVar = index.data(m_yPosRole);
-                    QVariant zValueVar = index.data(m_zPosRole);
-                    const QSurfaceDataItem *oldItem = m_proxy->itemAt(i, j);
-                    float xPos;
-                    float yPos;
-                    float zPos;
-                    if (m_xPosRole != noRoleIndex) {
-                        if (m_haveXPosPattern)
-                            xPos = xValueVar.toString().replace(m_xPosPattern, m_xPosReplace).toFloat();
-                        else
-                            xPos = xValueVar.toFloat();
-                    } else {
-                        xPos = oldItem->x();
-                    }
-
-                    if (m_haveYPosPattern)
-                        yPos = yValueVar.toString().replace(m_yPosPattern, m_yPosReplace).toFloat();
-                    else
-                        yPos = yValueVar.toFloat();
-
-                    if (m_zPosRole != noRoleIndex) {
-                        if (m_haveZPosPattern)
-                            zPos = zValueVar.toString().replace(m_zPosPattern, m_zPosReplace).toFloat();
-                        else
-                            zPos = zValueVar.toFloat();
-                    } else {
-                        zPos = oldItem->z();
+            if (startCol == 0 && endCol == m_proxy->columnCount() - 1) {
+                // Replace whole rows at once to avoid a change signal per item
+                m_proxy->setRows(startRow, resolveRows(startRow, endRow));
+            } else {
+                for (int i = startRow; i <= endRow; i++) {
+                    for (int j = startCol; j <= endCol; j++) {
+                        QSurfaceDataItem item;
+                        modelPosToSurfaceItem(i, j, item);
+                        m_proxy->setItem(i, j, item);
                     }
-                    item.setPosition(QVector3D(xPos, yPos, zPos));
-                    m_proxy->setItem(i, j, item);
                 }
             }
         }
     }
 }
 
+void SurfaceItemModelHandler::handleRowsInserted(const QModelIndex &parent, int start, int end)
+{
+    // Only top level rows are mapped to the proxy
+    if (parent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (!m_proxy->useModelCategories() || !m_proxy->rowCount()) {
+            // If the data model doesn't directly map rows and columns, we cannot optimize.
+            // If inserting into an empty array, do full asynchronous reset to avoid multiple
+            // separate inserts when initializing the model.
+            AbstractItemModelHandler::handleRowsInserted(parent, start, end);
+        } else {
+            m_proxy->insertRows(start, resolveRows(start, end));
+            updateShiftedRows(end + 1);
+        }
+    }
+}
+
+void SurfaceItemModelHandler::handleRowsMoved(const QModelIndex &sourceParent, int sourceStart,
+                                              int sourceEnd,
+                                              const QModelIndex &destinationParent,
+                                              int destinationRow)
+{
+    // Moves within child rows do not affect the proxy
+    if (sourceParent.isValid() && destinationParent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (!m_proxy->useModelCategories() || sourceParent.isValid()
+                || destinationParent.isValid()) {
+            // If the data model doesn't directly map rows and columns, we cannot optimize.
+            // Moves to or from child rows change the number of top level rows.
+            AbstractItemModelHandler::handleRowsMoved(sourceParent, sourceStart, sourceEnd,
+                                                      destinationParent, destinationRow);
+        } else {
+            // Only the rows between the source and the destination change places,
+            // so refresh just that span without changing the row count.
+            int firstRow = qMin(sourceStart, destinationRow);
+            int lastRow = qMax(sourceEnd, destinationRow - 1);
+            m_proxy->setRows(firstRow, resolveRows(firstRow, lastRow));
+        }
+    }
+}
+
+void SurfaceItemModelHandler::handleRowsRemoved(const QModelIndex &parent, int start, int end)
+{
+    // Only top level rows are mapped to the proxy
+    if (parent.isValid())
+        return;
+
+    // Do nothing if full reset already pending
+    if (!m_fullReset) {
+        if (!m_proxy->useModelCategories()) {
+            // If the data model doesn't directly map rows and columns, we cannot optimize
+            AbstractItemModelHandler::handleRowsRemoved(parent, start, end);
+        } else {
+            m_proxy->removeRows(start, end - start + 1);
+            updateShiftedRows(start);
+        }
+    }
+}
+
+void SurfaceItemModelHandler::modelPosToSurfaceItem(int modelRow, int modelColumn,
+                                                    QSurfaceDataItem &item)
+{
+    QModelIndex index = m_itemModel->index(modelRow, modelColumn);
+    float xPos;
+    float yPos;
+    float zPos;
+    if (m_xPosRole != noRoleIndex) {
+        QVariant xValueVar = index.data(m_xPosRole);
+        if (m_haveXPosPattern)
+            xPos = xValueVar.toString().replace(m_xPosPattern, m_xPosReplace).toFloat();
+        else
+            xPos = xValueVar.toFloat();
+    } else {
+        QString header = m_itemModel->headerData(modelColumn, Qt::Horizontal).toString();
+        bool ok = false;
+        float headerValue = header.toFloat(&ok);
+        if (ok)
+            xPos = headerValue;
+        else
+            xPos = float(modelColumn);
+    }
+
+    QVariant yValueVar = index.data(m_yPosRole);
+    if (m_haveYPosPattern)
+        yPos = yValueVar.toString().replace(m_yPosPattern, m_yPosReplace).toFloat();
+    else
+        yPos = yValueVar.toFloat();
+
+    if (m_zPosRole != noRoleIndex) {
+        QVariant zValueVar = index.data(m_zPosRole);
+        if (m_haveZPosPattern)
+            zPos = zValueVar.toString().replace(m_zPosPattern, m_zPosReplace).toFloat();
+        else
+            zPos = zValueVar.toFloat();
+    } else {
+        QString header = m_itemModel->headerData(modelRow, Qt::Vertical).toString();
+        bool ok = false;
+        float headerValue = header.toFloat(&ok);
+        if (ok)
+            zPos = headerValue;
+        else
+            zPos = float(modelRow);
+    }
+
+    item.setPosition(QVector3D(xPos, yPos, zPos));
+}
+
+// Resolve the given model rows into new proxy rows. Only valid when using model categories.
+QSurfaceDataArray SurfaceItemModelHandler::resolveRows(int startRow, int endRow)
+{
+    const int columnCount = m_itemModel->columnCount();
+    QSurfaceDataArray rows;
+    rows.reserve(endRow - startRow + 1);
+    for (int i = startRow; i <= endRow; i++) {
+        QSurfaceDataRow *row = new QSurfaceDataRow(columnCount);
+        for (int j = 0; j < columnCount; j++)
+            modelPosToSurfaceItem(i, j, (*row)[j]);
+        rows.append(row);
+    }
+    return rows;
+}
+
+// When z-positions come from the vertical headers or row indexes, rows shifted by an insertion
+// or a removal may have moved along the z-axis, so they need to be resolved again.
+void SurfaceItemModelHandler::updateShiftedRows(int firstRow)
+{
+    const int lastRow = m_proxy->rowCount() - 1;
+    if (m_zPosRole == noRoleIndex && firstRow <= lastRow)
+        m_proxy->setRows(firstRow, resolveRows(firstRow, lastRow));
+}
+
 // Resolve entire item model into QSurfaceDataArray.
 void SurfaceItemModelHandler::resolveModel()
 {
@@ -131,51 +253,8 @@ void SurfaceItemModelHandler::resolveModel()
         }
         for (int i = 0; i < rowCount; i++) {
             QSurfaceDataRow &newProxyRow = *m_proxyArray->at(i);
-            for (int j = 0; j < columnCount; j++) {
-                QModelIndex index = m_itemModel->index(i, j);
-                QVariant xValueVar = index.data(m_xPosRole);
-                QVariant yValueVar = index.data(m_yPosRole);
-                QVariant zValueVar = index.data(m_zPosRole);
-                float xPos;
-                float yPos;
-                float zPos;
-                if (m_xPosRole != noRoleIndex) {
-                    if (m_haveXPosPattern)
-                        xPos = xValueVar.toString().replace(m_xPosPattern, m_xPosReplace).toFloat();
-                    else
-                        xPos = xValueVar.toFloat();
-                } else {
-                    QString header = m_itemModel->headerData(j, Qt::Horizontal).toString();
-                    bool ok = false;
-                    float headerValue = header.toFloat(&ok);
-                    if (ok)
-                        xPos = headerValue;
-                    else
-                        xPos = float(j);
-                }
-
-                if (m_haveYPosPattern)
-                    yPos = yValueVar.toString().replace(m_yPosPattern, m_yPosReplace).toFloat();
-                else
-                    yPos = yValueVar.toFloat();
-
-                if (m_zPosRole != noRoleIndex) {
-                    if (m_haveZPosPattern)
-                        zPos = zValueVar.toString().replace(m_zPosPattern, m_zPosReplace).toFloat();
-                    else
-                        zPos = zValueVar.toFloat();
-                } else {
-                    QString header = m_itemModel->headerData(i, Qt::Vertical).toString();
-                    bool ok = false;
-                    float headerValue = header.toFloat(&ok);
-                    if (ok)
-                        zPos = headerValue;
-                    else
-                        zPos = float(i);
-                }
-
-                newProxyRow[j].setPosition(QVector3D(xPos, yPos, zPos));
-            }
+            for (int j = 0; j < columnCount; j++)
+                modelPosToSurfaceItem(i, j, newProxyRow[j]);
         }
     } else {
         int rowRole = roleHash.key(m_proxy->rowRole().toLatin1());
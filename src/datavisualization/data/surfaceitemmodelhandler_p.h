@@ -29,10 +29,18 @@ public:
 public Q_SLOTS:
     void handleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
                            const QList<int> &roles = QList<int>()) override;
+    void handleRowsInserted(const QModelIndex &parent, int start, int end) override;
+    void handleRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd,
+                         const QModelIndex &destinationParent, int destinationRow) override;
+    void handleRowsRemoved(const QModelIndex &parent, int start, int end) override;
 
 protected:
     void resolveModel() override;
 
+    void modelPosToSurfaceItem(int modelRow, int modelColumn, QSurfaceDataItem &item);
+    QSurfaceDataArray resolveRows(int startRow, int endRow);
+    void updateShiftedRows(int firstRow);
+
     QItemModelSurfaceDataProxy *m_proxy; // Not owned
     QSurfaceDataArray *m_proxyArray; // Not owned
     int m_xPosRole;
@@ -33,6 +33,10 @@ Abstract3DController::Abstract3DController(QRect initialViewport, Q3DScene *scen
     m_reflectionEnabled(false),
     m_reflectivity(0.5),
     m_locale(QLocale::c()),
+    m_frameChanges(FrameChangeNone),
+    m_adaptiveQuality(false),
+    m_frameTimeBudget(33.0),
+    m_qualityRestoreDue(0),
     m_scene(scene),
     m_activeInputHandler(0),
     m_axisX(0),
@@ -43,7 +47,7 @@ Abstract3DController::Abstract3DController(QRect initialViewport, Q3DScene *scen
     m_isCustomDataDirty(true),
     m_isCustomItemDirty(true),
     m_isSeriesVisualsDirty(true),
-    m_renderPending(false),
+    m_renderPending(0),
     m_isPolar(false),
     m_radialLabelOffset(1.0f),
     m_measureFps(false),
@@ -73,6 +77,13 @@ Abstract3DController::Abstract3DController(QRect initialViewport, Q3DScene *scen
     setActiveInputHandler(inputHandler);
     connect(m_scene->d_ptr.data(), &Q3DScenePrivate::needRender, this,
             &Abstract3DController::emitNeedRender);
+
+    // Full quality is restored once nothing has changed for a while
+    m_qualityRestoreTimer.setSingleShot(true);
+    connect(&m_qualityRestoreTimer, &QTimer::timeout, this, [this]() {
+        m_qualityRestoreDue.storeRelease(1);
+        emitNeedRender();
+    });
 }
 
 Abstract3DController::~Abstract3DController()
@@ -104,6 +115,7 @@ void Abstract3DController::setRenderer(Abstract3DRenderer *renderer)
 {
     // Note: This function must be called within render mutex
     m_renderer = renderer;
+    m_adaptiveQualityState.reset();
 
     // If renderer is created in different thread than controller, make sure renderer gets
     // destroyed before the render thread finishes.
@@ -167,12 +179,13 @@ QList<QAbstract3DSeries *> Abstract3DController::seriesList()
 
 /**
  * @brief synchDataToRenderer Called on the render thread while main GUI thread is blocked before rendering.
+ * Changed data is only snapshotted here, the renderer converts it when the next frame is rendered.
  */
 void Abstract3DController::synchDataToRenderer()
 {
     // Subclass implementations check for renderer validity already, so no need to check here.
 
-    m_renderPending = false;
+    m_renderPending.storeRelease(0);
 
     // If there are pending queries, handle those first
     if (m_renderer->isGraphPositionQueryResolved())
@@ -183,64 +196,90 @@ void Abstract3DController::synchDataToRenderer()
 
     startRecordingRemovesAndInserts();
 
-    if (m_scene->d_ptr->m_sceneDirty)
+    // Classify the changes synced in this pass, so that the renderer can skip work
+    // that the changes do not affect
+    FrameChanges changes = m_frameChanges;
+    m_frameChanges = FrameChangeNone;
+
+    if (m_scene->d_ptr->m_sceneDirty) {
+        if (m_scene->d_ptr->isViewDirty())
+            changes |= FrameChangeCamera;
         m_renderer->updateScene(m_scene);
+    }
+
+    updateAdaptiveQuality(changes);
 
+    if (m_changeTracker.themeChanged) {
+        changes |= FrameChangeTheme;
+        m_changeTracker.themeChanged = false;
+    }
     m_renderer->updateTheme(m_themeManager->activeTheme());
 
     if (m_changeTracker.polarChanged) {
         m_renderer->updatePolar(m_isPolar);
         m_changeTracker.polarChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.radialLabelOffsetChanged) {
         m_renderer->updateRadialLabelOffset(m_radialLabelOffset);
         m_changeTracker.radialLabelOffsetChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.shadowQualityChanged) {
         m_renderer->updateShadowQuality(m_shadowQuality);
         m_changeTracker.shadowQualityChanged = false;
+        changes |= FrameChangeOther;
     }
 
     if (m_changeTracker.selectionModeChanged) {
         m_renderer->updateSelectionMode(m_selectionMode);
         m_changeTracker.selectionModeChanged = false;
+        changes |= FrameChangeSelection;
     }
 
     if (m_changeTracker.projectionChanged) {
         m_renderer->m_useOrthoProjection = m_useOrthoProjection;
         m_changeTracker.projectionChanged = false;
+        changes |= FrameChangeCamera;
     }
 
     if (m_changeTracker.aspectRatioChanged) {
         m_renderer->updateAspectRatio(float(m_aspectRatio));
         m_changeTracker.aspectRatioChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.horizontalAspectRatioChanged) {
         m_renderer->updateHorizontalAspectRatio(float(m_horizontalAspectRatio));
         m_changeTracker.horizontalAspectRatioChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.optimizationHintChanged) {
         m_renderer->updateOptimizationHint(m_optimizationHints);
         m_changeTracker.optimizationHintChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.reflectionChanged) {
-        m_renderer->m_reflectionEnabled = m_reflectionEnabled;
+        m_renderer->m_reflectionEnabled = m_reflectionEnabled
+                && !m_adaptiveQualityState.isReduced();
         m_changeTracker.reflectionChanged = false;
+        changes |= FrameChangeOther;
     }
 
     if (m_changeTracker.reflectivityChanged) {
         // Invert value to match functionality to the property description
         m_renderer->m_reflectivity = -(m_reflectivity - 1.0);
         m_changeTracker.reflectivityChanged = false;
+        changes |= FrameChangeOther;
     }
 
     if (m_changeTracker.axisXFormatterChanged) {
         m_changeTracker.axisXFormatterChanged = false;
+        changes |= FrameChangeData;
         if (m_axisX->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisX = static_cast<QValue3DAxis *>(m_axisX);
             m_renderer->updateAxisFormatter(QAbstract3DAxis::AxisOrientationX,
@@ -249,6 +288,7 @@ void Abstract3DController::synchDataToRenderer()
     }
     if (m_changeTracker.axisYFormatterChanged) {
         m_changeTracker.axisYFormatterChanged = false;
+        changes |= FrameChangeData;
         if (m_axisY->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisY = static_cast<QValue3DAxis *>(m_axisY);
             m_renderer->updateAxisFormatter(QAbstract3DAxis::AxisOrientationY,
@@ -257,6 +297,7 @@ void Abstract3DController::synchDataToRenderer()
     }
     if (m_changeTracker.axisZFormatterChanged) {
         m_changeTracker.axisZFormatterChanged = false;
+        changes |= FrameChangeData;
         if (m_axisZ->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisZ = static_cast<QValue3DAxis *>(m_axisZ);
             m_renderer->updateAxisFormatter(QAbstract3DAxis::AxisOrientationZ,
@@ -267,67 +308,80 @@ void Abstract3DController::synchDataToRenderer()
     if (m_changeTracker.axisXTypeChanged) {
         m_renderer->updateAxisType(QAbstract3DAxis::AxisOrientationX, m_axisX->type());
         m_changeTracker.axisXTypeChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.axisYTypeChanged) {
         m_renderer->updateAxisType(QAbstract3DAxis::AxisOrientationY, m_axisY->type());
         m_changeTracker.axisYTypeChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.axisZTypeChanged) {
         m_renderer->updateAxisType(QAbstract3DAxis::AxisOrientationZ, m_axisZ->type());
         m_changeTracker.axisZTypeChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.axisXTitleChanged) {
         m_renderer->updateAxisTitle(QAbstract3DAxis::AxisOrientationX, m_axisX->title());
         m_changeTracker.axisXTitleChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisYTitleChanged) {
         m_renderer->updateAxisTitle(QAbstract3DAxis::AxisOrientationY, m_axisY->title());
         m_changeTracker.axisYTitleChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisZTitleChanged) {
         m_renderer->updateAxisTitle(QAbstract3DAxis::AxisOrientationZ, m_axisZ->title());
         m_changeTracker.axisZTitleChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisXLabelsChanged) {
         m_renderer->updateAxisLabels(QAbstract3DAxis::AxisOrientationX, m_axisX->labels());
         m_changeTracker.axisXLabelsChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisYLabelsChanged) {
         m_renderer->updateAxisLabels(QAbstract3DAxis::AxisOrientationY, m_axisY->labels());
         m_changeTracker.axisYLabelsChanged = false;
+        changes |= FrameChangeLabels;
     }
     if (m_changeTracker.axisZLabelsChanged) {
         m_renderer->updateAxisLabels(QAbstract3DAxis::AxisOrientationZ, m_axisZ->labels());
         m_changeTracker.axisZLabelsChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisXRangeChanged) {
         m_renderer->updateAxisRange(QAbstract3DAxis::AxisOrientationX, m_axisX->min(),
                                     m_axisX->max());
         m_changeTracker.axisXRangeChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.axisYRangeChanged) {
         m_renderer->updateAxisRange(QAbstract3DAxis::AxisOrientationY, m_axisY->min(),
                                     m_axisY->max());
         m_changeTracker.axisYRangeChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.axisZRangeChanged) {
         m_renderer->updateAxisRange(QAbstract3DAxis::AxisOrientationZ, m_axisZ->min(),
                                     m_axisZ->max());
         m_changeTracker.axisZRangeChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changeTracker.axisXSegmentCountChanged) {
         m_changeTracker.axisXSegmentCountChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisX->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisX = static_cast<QValue3DAxis *>(m_axisX);
             m_renderer->updateAxisSegmentCount(QAbstract3DAxis::AxisOrientationX,
@@ -337,6 +391,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisYSegmentCountChanged) {
         m_changeTracker.axisYSegmentCountChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisY->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisY = static_cast<QValue3DAxis *>(m_axisY);
             m_renderer->updateAxisSegmentCount(QAbstract3DAxis::AxisOrientationY,
@@ -346,6 +401,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisZSegmentCountChanged) {
         m_changeTracker.axisZSegmentCountChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisZ->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisZ = static_cast<QValue3DAxis *>(m_axisZ);
             m_renderer->updateAxisSegmentCount(QAbstract3DAxis::AxisOrientationZ,
@@ -355,6 +411,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisXSubSegmentCountChanged) {
         m_changeTracker.axisXSubSegmentCountChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisX->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisX = static_cast<QValue3DAxis *>(m_axisX);
             m_renderer->updateAxisSubSegmentCount(QAbstract3DAxis::AxisOrientationX,
@@ -364,6 +421,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisYSubSegmentCountChanged) {
         m_changeTracker.axisYSubSegmentCountChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisY->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisY = static_cast<QValue3DAxis *>(m_axisY);
             m_renderer->updateAxisSubSegmentCount(QAbstract3DAxis::AxisOrientationY,
@@ -373,6 +431,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisZSubSegmentCountChanged) {
         m_changeTracker.axisZSubSegmentCountChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisZ->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisZ = static_cast<QValue3DAxis *>(m_axisZ);
             m_renderer->updateAxisSubSegmentCount(QAbstract3DAxis::AxisOrientationZ,
@@ -382,6 +441,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisXLabelFormatChanged) {
         m_changeTracker.axisXLabelFormatChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisX->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisX = static_cast<QValue3DAxis *>(m_axisX);
             m_renderer->updateAxisLabelFormat(QAbstract3DAxis::AxisOrientationX,
@@ -391,6 +451,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisYLabelFormatChanged) {
         m_changeTracker.axisYLabelFormatChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisY->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisY = static_cast<QValue3DAxis *>(m_axisY);
             m_renderer->updateAxisLabelFormat(QAbstract3DAxis::AxisOrientationY,
@@ -400,6 +461,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisZLabelFormatChanged) {
         m_changeTracker.axisZLabelFormatChanged = false;
+        changes |= FrameChangeLabels;
         if (m_axisZ->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisZ = static_cast<QValue3DAxis *>(m_axisZ);
             m_renderer->updateAxisLabelFormat(QAbstract3DAxis::AxisOrientationZ,
@@ -409,6 +471,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisXReversedChanged) {
         m_changeTracker.axisXReversedChanged = false;
+        changes |= FrameChangeData;
         if (m_axisX->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisX = static_cast<QValue3DAxis *>(m_axisX);
             m_renderer->updateAxisReversed(QAbstract3DAxis::AxisOrientationX,
@@ -418,6 +481,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisYReversedChanged) {
         m_changeTracker.axisYReversedChanged = false;
+        changes |= FrameChangeData;
         if (m_axisY->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisY = static_cast<QValue3DAxis *>(m_axisY);
             m_renderer->updateAxisReversed(QAbstract3DAxis::AxisOrientationY,
@@ -427,6 +491,7 @@ void Abstract3DController::synchDataToRenderer()
 
     if (m_changeTracker.axisZReversedChanged) {
         m_changeTracker.axisZReversedChanged = false;
+        changes |= FrameChangeData;
         if (m_axisZ->type() & QAbstract3DAxis::AxisTypeValue) {
             QValue3DAxis *valueAxisZ = static_cast<QValue3DAxis *>(m_axisZ);
             m_renderer->updateAxisReversed(QAbstract3DAxis::AxisOrientationZ,
@@ -438,64 +503,76 @@ void Abstract3DController::synchDataToRenderer()
         m_renderer->updateAxisLabelAutoRotation(QAbstract3DAxis::AxisOrientationX,
                                                 m_axisX->labelAutoRotation());
         m_changeTracker.axisXLabelAutoRotationChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisYLabelAutoRotationChanged) {
         m_renderer->updateAxisLabelAutoRotation(QAbstract3DAxis::AxisOrientationY,
                                                 m_axisY->labelAutoRotation());
         m_changeTracker.axisYLabelAutoRotationChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisZLabelAutoRotationChanged) {
         m_renderer->updateAxisLabelAutoRotation(QAbstract3DAxis::AxisOrientationZ,
                                                 m_axisZ->labelAutoRotation());
         m_changeTracker.axisZLabelAutoRotationChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.axisXTitleVisibilityChanged) {
         m_renderer->updateAxisTitleVisibility(QAbstract3DAxis::AxisOrientationX,
                                               m_axisX->isTitleVisible());
         m_changeTracker.axisXTitleVisibilityChanged = false;
+        changes |= FrameChangeLabels;
     }
     if (m_changeTracker.axisYTitleVisibilityChanged) {
         m_renderer->updateAxisTitleVisibility(QAbstract3DAxis::AxisOrientationY,
                                               m_axisY->isTitleVisible());
         m_changeTracker.axisYTitleVisibilityChanged = false;
+        changes |= FrameChangeLabels;
     }
     if (m_changeTracker.axisZTitleVisibilityChanged) {
         m_renderer->updateAxisTitleVisibility(QAbstract3DAxis::AxisOrientationZ,
                                               m_axisZ->isTitleVisible());
         m_changeTracker.axisZTitleVisibilityChanged = false;
+        changes |= FrameChangeLabels;
     }
     if (m_changeTracker.axisXTitleFixedChanged) {
         m_renderer->updateAxisTitleFixed(QAbstract3DAxis::AxisOrientationX,
                                          m_axisX->isTitleFixed());
         m_changeTracker.axisXTitleFixedChanged = false;
+        changes |= FrameChangeLabels;
     }
     if (m_changeTracker.axisYTitleFixedChanged) {
         m_renderer->updateAxisTitleFixed(QAbstract3DAxis::AxisOrientationY,
                                          m_axisY->isTitleFixed());
         m_changeTracker.axisYTitleFixedChanged = false;
+        changes |= FrameChangeLabels;
     }
     if (m_changeTracker.axisZTitleFixedChanged) {
         m_renderer->updateAxisTitleFixed(QAbstract3DAxis::AxisOrientationZ,
                                          m_axisZ->isTitleFixed());
         m_changeTracker.axisZTitleFixedChanged = false;
+        changes |= FrameChangeLabels;
     }
 
     if (m_changeTracker.marginChanged) {
         m_renderer->updateMargin(float(m_margin));
         m_changeTracker.marginChanged = false;
+        changes |= FrameChangeData;
     }
 
     if (m_changedSeriesList.size()) {
         m_renderer->modifiedSeriesList(m_changedSeriesList);
         m_changedSeriesList.clear();
+        changes |= FrameChangeData;
     }
 
     if (m_isSeriesVisualsDirty) {
         m_renderer->updateSeries(m_seriesList);
         m_isSeriesVisualsDirty = false;
+        changes |= FrameChangeData;
     }
 
     if (m_isDataDirty) {
@@ -503,17 +580,22 @@ void Abstract3DController::synchDataToRenderer()
         // so no data needs to be passed in updateData()
         m_renderer->updateData();
         m_isDataDirty = false;
+        changes |= FrameChangeData;
     }
 
     if (m_isCustomDataDirty) {
         m_renderer->updateCustomData(m_customItems);
         m_isCustomDataDirty = false;
+        changes |= FrameChangeData;
     }
 
     if (m_isCustomItemDirty) {
         m_renderer->updateCustomItems();
         m_isCustomItemDirty = false;
+        changes |= FrameChangeData;
     }
+
+    m_renderer->markFrameChanges(changes);
 }
 
 void Abstract3DController::render(const GLuint defaultFboHandle)
@@ -534,11 +616,17 @@ void Abstract3DController::render(const GLuint defaultFboHandle)
             m_numFrames = 0;
             m_frameTimer.restart();
         }
-        // To get meaningful framerate, don't just do render on demand.
-        emitNeedRender();
+        // To get meaningful framerate, don't just do render on demand. The render request
+        // is passed to the controller thread if the graph is rendered in a separate thread.
+        if (QThread::currentThread() == thread())
+            emitNeedRender();
+        else
+            QMetaObject::invokeMethod(this, &Abstract3DController::emitNeedRender,
+                                      Qt::QueuedConnection);
     }
 
     m_renderer->render(defaultFboHandle);
+    m_renderer->endFrame();
 }
 
 void Abstract3DController::mouseDoubleClickEvent(QMouseEvent *event)
@@ -979,6 +1067,7 @@ void Abstract3DController::requestRender(QOpenGLFramebufferObject *fbo)
 {
     QMutexLocker mutexLocker(&m_renderMutex);
     m_renderer->render(fbo->handle());
+    m_renderer->endFrame();
 }
 
 int Abstract3DController::addCustomItem(QCustom3DItem *item)
@@ -1483,12 +1572,106 @@ void Abstract3DController::startRecordingRemovesAndInserts()
     // Default implementation does nothing
 }
 
+void Abstract3DController::setAdaptiveQuality(bool enable)
+{
+    if (m_adaptiveQuality != enable) {
+        m_adaptiveQuality = enable;
+        emit adaptiveQualityChanged(m_adaptiveQuality);
+        emitNeedRender();
+    }
+}
+
+bool Abstract3DController::isAdaptiveQuality() const
+{
+    return m_adaptiveQuality;
+}
+
+void Abstract3DController::setFrameTimeBudget(qreal msecs)
+{
+    if (m_frameTimeBudget != msecs && msecs > 0.0) {
+        m_frameTimeBudget = msecs;
+        m_adaptiveQualityState.setFrameTimeBudget(qint64(msecs * 1000000.0));
+        emit frameTimeBudgetChanged(m_frameTimeBudget);
+    }
+}
+
+qreal Abstract3DController::frameTimeBudget() const
+{
+    return m_frameTimeBudget;
+}
+
+// Decides whether the frame is rendered at reduced quality. Must be called during sync, before
+// reflections are synced. Reduced quality skips the shadow pass in the renderer instead of
+// changing the shadow quality, which would recreate the shaders and the depth buffer.
+void Abstract3DController::updateAdaptiveQuality(FrameChanges &changes)
+{
+    const bool wasReduced = m_adaptiveQualityState.isReduced();
+    const bool restoreDue = m_qualityRestoreDue.fetchAndStoreAcquire(0);
+    if (m_adaptiveQuality) {
+        const bool active = changes != FrameChangeNone || m_isDataDirty
+                || !m_changedSeriesList.isEmpty();
+        if (m_adaptiveQualityState.update(changes.testFlag(FrameChangeCamera), active,
+                                          m_renderer->lastFrameNsecs(), restoreDue)) {
+            // The sync may be done in the render thread, so the timer is started via a call
+            // queued to the controller thread in that case
+            const int interval = m_adaptiveQualityState.restoreInterval();
+            QMetaObject::invokeMethod(&m_qualityRestoreTimer, [this, interval]() {
+                m_qualityRestoreTimer.start(interval);
+            });
+        }
+    } else {
+        m_adaptiveQualityState.reset();
+    }
+
+    const bool reduce = m_adaptiveQualityState.isReduced();
+    if (reduce != wasReduced) {
+        m_renderer->m_reducedQuality = reduce;
+        m_renderer->m_skipShadowPass = reduce;
+        if (m_reflectionEnabled)
+            m_changeTracker.reflectionChanged = true;
+        changes |= FrameChangeOther;
+    }
+}
+
 void Abstract3DController::emitNeedRender()
 {
-    if (!m_renderPending) {
+    // Requests made while a render is already pending are served by the same frame
+    m_renderRequests.fetchAndAddRelaxed(1);
+    if (m_renderPending.testAndSetOrdered(0, 1))
         emit needRender();
-        m_renderPending = true;
-    }
+    else
+        m_coalescedRenderRequests.fetchAndAddRelaxed(1);
+}
+
+void Abstract3DController::markThemeDirty()
+{
+    m_frameChanges |= FrameChangeTheme;
+    emitNeedRender();
+}
+
+FrameStatistics Abstract3DController::frameStatistics()
+{
+    QMutexLocker mutexLocker(&m_renderMutex);
+
+    FrameStatistics statistics;
+    statistics.renderRequests = m_renderRequests.loadRelaxed();
+    statistics.coalescedRenderRequests = m_coalescedRenderRequests.loadRelaxed();
+    if (m_renderer) {
+        const FrameStatistics &rendererStatistics = m_renderer->frameStatistics();
+        statistics.renderedFrames = rendererStatistics.renderedFrames;
+        statistics.unchangedFrames = rendererStatistics.unchangedFrames;
+        statistics.cameraOnlyFrames = rendererStatistics.cameraOnlyFrames;
+        statistics.selectionPassesSkipped = rendererStatistics.selectionPassesSkipped;
+        statistics.reflectionPassesRendered = rendererStatistics.reflectionPassesRendered;
+        statistics.reflectionPassesReused = rendererStatistics.reflectionPassesReused;
+        statistics.reflectionPassNsecs = rendererStatistics.reflectionPassNsecs;
+        statistics.drawCalls = rendererStatistics.drawCalls;
+        statistics.culledItems = rendererStatistics.culledItems;
+        statistics.occludedItems = rendererStatistics.occludedItems;
+        statistics.stateBindsElided = rendererStatistics.stateBindsElided;
+        statistics.renderNsecs = rendererStatistics.renderNsecs;
+    }
+    return statistics;
 }
 
 void Abstract3DController::handlePendingClick()
@@ -22,10 +22,13 @@
 #include "qabstract3dgraph.h"
 #include "q3dscene_p.h"
 #include "qcustom3ditem.h"
+#include "adaptivequality_p.h"
 #include <QtGui/QLinearGradient>
+#include <QtCore/QAtomicInt>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLocale>
 #include <QtCore/QMutex>
+#include <QtCore/QTimer>
 
 QT_FORWARD_DECLARE_CLASS(QOpenGLFramebufferObject)
 
@@ -140,6 +143,26 @@ struct Abstract3DChangeBitField {
     }
 };
 
+// Counters for render requests and for the work renderers could skip because of them
+struct FrameStatistics {
+    quint64 renderRequests = 0;
+    quint64 coalescedRenderRequests = 0;
+    quint64 renderedFrames = 0;
+    quint64 unchangedFrames = 0;
+    quint64 cameraOnlyFrames = 0;
+    quint64 selectionPassesSkipped = 0;
+    quint64 reflectionPassesRendered = 0;
+    quint64 reflectionPassesReused = 0;
+    quint64 reflectionPassNsecs = 0;
+    quint64 drawCalls = 0;
+    // Items skipped by frustum culling, counted once per pass
+    quint64 culledItems = 0;
+    // Bars skipped by occlusion culling in the main pass
+    quint64 occludedItems = 0;
+    quint64 stateBindsElided = 0;
+    quint64 renderNsecs = 0;
+};
+
 class Q_DATAVISUALIZATION_EXPORT Abstract3DController : public QObject
 {
     Q_OBJECT
@@ -152,6 +175,18 @@ public:
         SelectionColumn
     };
 
+    // Classification of what changed between two rendered frames
+    enum FrameChange {
+        FrameChangeNone      = 0x00,
+        FrameChangeCamera    = 0x01,
+        FrameChangeData      = 0x02,
+        FrameChangeTheme     = 0x04,
+        FrameChangeLabels    = 0x08,
+        FrameChangeSelection = 0x10,
+        FrameChangeOther     = 0x20
+    };
+    Q_DECLARE_FLAGS(FrameChanges, FrameChange)
+
 private:
     Abstract3DChangeBitField m_changeTracker;
     ThemeManager *m_themeManager;
@@ -165,6 +200,16 @@ private:
     qreal m_reflectivity;
     QLocale m_locale;
     QVector3D m_queriedGraphPosition;
+    FrameChanges m_frameChanges;
+    // Render requests may come from any thread, while sync and frameStatistics() read them
+    QAtomicInteger<quint64> m_renderRequests;
+    QAtomicInteger<quint64> m_coalescedRenderRequests;
+    bool m_adaptiveQuality;
+    qreal m_frameTimeBudget;
+    AdaptiveQuality m_adaptiveQualityState;
+    // Set by the restore timer in the controller thread and read during sync
+    QAtomicInt m_qualityRestoreDue;
+    QTimer m_qualityRestoreTimer;
 
 protected:
     Q3DScene *m_scene;
@@ -181,7 +226,7 @@ protected:
     bool m_isCustomDataDirty;
     bool m_isCustomItemDirty;
     bool m_isSeriesVisualsDirty;
-    bool m_renderPending;
+    QAtomicInt m_renderPending;
     bool m_isPolar;
     float m_radialLabelOffset;
 
@@ -308,7 +353,14 @@ public:
     void setMargin(qreal margin);
     qreal margin() const;
 
+    void setAdaptiveQuality(bool enable);
+    bool isAdaptiveQuality() const;
+    void setFrameTimeBudget(qreal msecs);
+    qreal frameTimeBudget() const;
+
     void emitNeedRender();
+    void markThemeDirty();
+    FrameStatistics frameStatistics();
 
     virtual void clearSelection() = 0;
 
@@ -398,6 +450,8 @@ Q_SIGNALS:
     void localeChanged(const QLocale &locale);
     void queriedGraphPositionChanged(const QVector3D &data);
     void marginChanged(qreal margin);
+    void adaptiveQualityChanged(bool enabled);
+    void frameTimeBudgetChanged(qreal msecs);
 
 protected:
     virtual QAbstract3DAxis *createDefaultAxis(QAbstract3DAxis::AxisOrientation orientation);
@@ -406,6 +460,7 @@ protected:
     virtual void startRecordingRemovesAndInserts();
 
 private:
+    void updateAdaptiveQuality(FrameChanges &changes);
     void setAxisHelper(QAbstract3DAxis::AxisOrientation orientation, QAbstract3DAxis *axis,
                        QAbstract3DAxis **axisPtr);
 
@@ -414,6 +469,8 @@ private:
     friend class QAbstract3DGraphPrivate;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Abstract3DController::FrameChanges)
+
 QT_END_NAMESPACE
 
 #endif
@@ -13,6 +13,7 @@
 #include "qcustom3dlabel_p.h"
 #include "qcustom3dvolume_p.h"
 #include "scatter3drenderer_p.h"
+#include "frustum_p.h"
 
 #include <QtCore/qmath.h>
 #include <QtGui/QOffscreenSurface>
@@ -94,6 +95,16 @@ Abstract3DRenderer::Abstract3DRenderer(Abstract3DController *controller)
       m_oldCameraTarget(QVector3D(2000.0f, 2000.0f, 2000.0f)), // Just random invalid target
       m_reflectionEnabled(false),
       m_reflectivity(0.5),
+      m_reducedQuality(false),
+      m_skipShadowPass(false),
+      m_frameChanges(Abstract3DController::FrameChangeNone),
+      m_pendingFrameChanges(Abstract3DController::FrameChangeNone),
+      m_selectionBufferValid(false),
+      m_dataUpdatesPending(false),
+      m_lastFrameNsecs(0),
+      m_refinementLevel(0),
+      m_refining(false),
+      m_resourceThread(QThread::currentThread()),
 #if !QT_CONFIG(opengles2)
       m_funcs_2_1(0),
 #endif
@@ -121,7 +132,7 @@ Abstract3DRenderer::Abstract3DRenderer(Abstract3DController *controller)
 #endif
     QObject::connect(m_drawer, &Drawer::drawerChanged, this, &Abstract3DRenderer::updateTextures);
     QObject::connect(this, &Abstract3DRenderer::needRender, controller,
-                     &Abstract3DController::needRender, Qt::QueuedConnection);
+                     &Abstract3DController::emitNeedRender, Qt::QueuedConnection);
     QObject::connect(this, &Abstract3DRenderer::requestShadowQuality, controller,
                      &Abstract3DController::handleRequestShadowQuality, Qt::QueuedConnection);
 }
@@ -218,8 +229,44 @@ void Abstract3DRenderer::initializeOpenGL()
                      this, &Abstract3DRenderer::contextCleanup);
 }
 
+void Abstract3DRenderer::flushDataUpdates()
+{
+    if (m_dataUpdatesPending) {
+        m_dataUpdatesPending = false;
+        applyDataUpdates();
+    }
+}
+
 void Abstract3DRenderer::render(const GLuint defaultFboHandle)
 {
+    m_renderTimer.start();
+
+    if (m_resourceThread != QThread::currentThread())
+        rekeySharedResources();
+
+    // Buffer uploads are done before the drawer starts tracking the GL state for the frame
+    flushDataUpdates();
+    m_drawer->beginFrame();
+
+    m_frameChanges = m_pendingFrameChanges;
+    m_pendingFrameChanges = Abstract3DController::FrameChangeNone;
+
+    // Changes to selection highlights are the only ones that keep item positions on screen intact
+    // Progressive rendering also starts over from the coarsest level when the view changes
+    if (m_frameChanges & ~Abstract3DController::FrameChanges(Abstract3DController::FrameChangeSelection)) {
+        m_selectionBufferValid = false;
+        m_refinementLevel = 0;
+    } else if (m_refining) {
+        m_refinementLevel++;
+    }
+    m_refining = false;
+
+    m_frameStatistics.renderedFrames++;
+    if (m_frameChanges == Abstract3DController::FrameChangeNone)
+        m_frameStatistics.unchangedFrames++;
+    else if (m_frameChanges == Abstract3DController::FrameChangeCamera)
+        m_frameStatistics.cameraOnlyFrames++;
+
     if (defaultFboHandle) {
         glDepthMask(true);
         glEnable(GL_DEPTH_TEST);
@@ -245,6 +292,40 @@ void Abstract3DRenderer::render(const GLuint defaultFboHandle)
     glDisable(GL_SCISSOR_TEST);
 }
 
+// Called by the controller once the renderer subclass has finished the frame
+void Abstract3DRenderer::endFrame()
+{
+    m_drawer->endFrame();
+
+    m_frameStatistics.drawCalls = m_drawer->drawCalls();
+    m_frameStatistics.stateBindsElided = m_drawer->bindsElided();
+    m_lastFrameNsecs = m_renderTimer.nsecsElapsed();
+    m_frameStatistics.renderNsecs += m_lastFrameNsecs;
+
+    // Keep rendering until the items skipped by progressive rendering have been drawn
+    if (m_refining)
+        emit needRender();
+}
+
+int Abstract3DRenderer::progressiveStride(int itemCount, int itemBudget)
+{
+    if (!m_cachedOptimizationHint.testFlag(QAbstract3DGraph::OptimizationProgressive)
+            || itemCount <= itemBudget) {
+        return 1;
+    }
+
+    // Each refinement level draws four times the items of the previous one
+    int stride = 1;
+    while (itemCount / stride > itemBudget)
+        stride *= 4;
+    for (int level = 0; level < m_refinementLevel && stride > 1; level++)
+        stride /= 4;
+
+    if (stride > 1)
+        m_refining = true;
+    return stride;
+}
+
 void Abstract3DRenderer::updateSelectionState(SelectionState state)
 {
     m_selectionState = state;
@@ -593,8 +674,7 @@ void Abstract3DRenderer::updateAxisRange(QAbstract3DAxis::AxisOrientation orient
     cache.setMin(min);
     cache.setMax(max);
 
-    foreach (SeriesRenderCache *cache, m_renderCacheList)
-        cache->setDataDirty(true);
+    handleAxisMappingChanged();
 }
 
 void Abstract3DRenderer::updateAxisSegmentCount(QAbstract3DAxis::AxisOrientation orientation,
@@ -621,8 +701,7 @@ void Abstract3DRenderer::updateAxisReversed(QAbstract3DAxis::AxisOrientation ori
                                             bool enable)
 {
     axisCacheForOrientation(orientation).setReversed(enable);
-    foreach (SeriesRenderCache *cache, m_renderCacheList)
-        cache->setDataDirty(true);
+    handleAxisMappingChanged();
 }
 
 void Abstract3DRenderer::updateAxisFormatter(QAbstract3DAxis::AxisOrientation orientation,
@@ -637,6 +716,11 @@ void Abstract3DRenderer::updateAxisFormatter(QAbstract3DAxis::AxisOrientation or
     formatter->d_ptr->populateCopy(*(cache.formatter()));
     cache.markPositionsDirty();
 
+    handleAxisMappingChanged();
+}
+
+void Abstract3DRenderer::handleAxisMappingChanged()
+{
     foreach (SeriesRenderCache *cache, m_renderCacheList)
         cache->setDataDirty(true);
 }
@@ -1080,6 +1164,24 @@ void Abstract3DRenderer::loadPositionMapperMesh()
                                     QStringLiteral(":/defaultMeshes/barFull"));
 }
 
+// Meshes and shader programs are shared per thread, so when the graph starts rendering on
+// another thread, the ones acquired on the old thread must not be used anymore.
+void Abstract3DRenderer::rekeySharedResources()
+{
+    m_resourceThread = QThread::currentThread();
+
+    ObjectHelper::rekeyObjectHelper(this, m_backgroundObj);
+    ObjectHelper::rekeyObjectHelper(this, m_gridLineObj);
+    ObjectHelper::rekeyObjectHelper(this, m_labelObj);
+    ObjectHelper::rekeyObjectHelper(this, m_positionMapperObj);
+    foreach (SeriesRenderCache *cache, m_renderCacheList)
+        cache->rekeyObject();
+    foreach (CustomRenderItem *item, m_customRenderCache)
+        item->rekeyMesh();
+
+    ShaderHelper::markRenderThreadChanged();
+}
+
 void Abstract3DRenderer::generateBaseColorTexture(const QColor &color, GLuint *texture)
 {
     m_textureHelper->deleteTexture(texture);
@@ -1443,6 +1545,9 @@ void Abstract3DRenderer::drawCustomItems(RenderingState state,
         shader->setUniformValue(shader->view(), viewMatrix);
     }
 
+    const Frustum frustum(RenderingDepth == state ? depthProjectionViewMatrix
+                                                  : projectionViewMatrix);
+
     // Draw custom items - first regular and then volumes
     bool volumeDetected = false;
     int loopCount = 0;
@@ -1523,6 +1628,18 @@ void Abstract3DRenderer::drawCustomItems(RenderingState state,
                 itModelMatrix.scale(item->scaling());
             MVPMatrix = projectionViewMatrix * modelMatrix;
 
+            // Skip items outside the frustum of the pass. Volume slice frames may extend past
+            // the mesh, so volumes drawing them are not culled.
+            if (item->mesh() && !(item->isVolume() && item->drawSliceFrames())) {
+                QVector3D minimum = item->mesh()->minBounds();
+                QVector3D maximum = item->mesh()->maxBounds();
+                Frustum::transformBox(modelMatrix, minimum, maximum);
+                if (!frustum.intersectsBox(minimum, maximum)) {
+                    m_frameStatistics.culledItems++;
+                    continue;
+                }
+            }
+
             if (RenderingNormal == state) {
                 // Normal render
                 ShaderHelper *prevShader = shader;
@@ -1532,7 +1649,7 @@ void Abstract3DRenderer::drawCustomItems(RenderingState state,
                              || item->sliceIndexY() >= 0
                              || item->sliceIndexZ() >= 0)) {
                         shader = m_volumeTextureSliceShader;
-                    } else if (item->useHighDefShader()) {
+                    } else if (item->useHighDefShader() && !m_reducedQuality) {
                         shader = m_volumeTextureShader;
                     } else {
                         shader = m_volumeTextureLowDefShader;
@@ -1607,6 +1724,9 @@ void Abstract3DRenderer::drawCustomItems(RenderingState state,
                                 // other sample:
                                 if (sampleCount > 256)
                                     sampleCount /= 2;
+                                // Adaptive quality halves the sample count further
+                                if (m_reducedQuality)
+                                    sampleCount = qMax(sampleCount / 2, 1);
                             } else {
                                 sampleCount = item->textureWidth() + item->textureHeight()
                                         + item->textureDepth();
@@ -1822,6 +1942,19 @@ void Abstract3DRenderer::queriedGraphPosition(const QMatrix4x4 &projectionViewMa
     m_graphPositionQueryPending = false;
 }
 
+// Returns true if the selection buffer still holds the scene as it would be drawn this frame,
+// in which case the selection query can be read from it without redrawing. Otherwise the caller
+// is expected to redraw the buffer, after which it is considered valid until the next change.
+bool Abstract3DRenderer::reuseSelectionBuffer()
+{
+    if (m_selectionBufferValid) {
+        m_frameStatistics.selectionPassesSkipped++;
+        return true;
+    }
+    m_selectionBufferValid = true;
+    return false;
+}
+
 void Abstract3DRenderer::calculatePolarXZ(const QVector3D &dataPos, float &x, float &z) const
 {
     // x is angular, z is radial
@@ -27,6 +27,7 @@
 #include <QtCore/qpointer.h>
 
 QT_FORWARD_DECLARE_CLASS(QOffscreenSurface)
+QT_FORWARD_DECLARE_CLASS(QThread)
 
 QT_BEGIN_NAMESPACE
 
@@ -55,7 +56,11 @@ protected:
 public:
     virtual ~Abstract3DRenderer();
 
+    // Data update functions called from synchDataToRenderer() only take snapshots of the changed
+    // data, as the GUI thread is blocked meanwhile. The render items are updated from the
+    // snapshots in applyDataUpdates(), which is called on the render thread.
     virtual void updateData() = 0;
+    void flushDataUpdates();
     virtual void updateSeries(const QList<QAbstract3DSeries *> &seriesList);
     virtual void updateCustomData(const QList<QCustom3DItem *> &customItems);
     virtual void updateCustomItems();
@@ -63,6 +68,7 @@ public:
     virtual SeriesRenderCache *createNewCache(QAbstract3DSeries *series);
     virtual void cleanCache(SeriesRenderCache *cache);
     virtual void render(GLuint defaultFboHandle);
+    void endFrame();
 
     virtual void updateTheme(Q3DTheme *theme);
     virtual void updateSelectionMode(QAbstract3DGraph::SelectionFlags newMode);
@@ -147,6 +153,13 @@ public:
     inline QVector3D queriedGraphPosition() const { return m_queriedGraphPosition; }
     inline QPoint cachedGraphPositionQuery() const { return m_cachedScene->graphPositionQuery(); }
 
+    inline void markFrameChanges(Abstract3DController::FrameChanges changes)
+    {
+        m_pendingFrameChanges |= changes;
+    }
+    inline const FrameStatistics &frameStatistics() const { return m_frameStatistics; }
+    inline qint64 lastFrameNsecs() const { return m_lastFrameNsecs; }
+
     LabelItem &selectionLabelItem();
     void setSelectionLabel(const QString &label);
     QString &selectionLabel();
@@ -173,10 +186,13 @@ protected:
     void reInitShaders();
     virtual void handleShadowQualityChange();
     virtual void handleResize();
+    // Called when an axis range, reversal or formatter changes. Marks all series data dirty.
+    virtual void handleAxisMappingChanged();
 
     AxisRenderCache &axisCacheForOrientation(QAbstract3DAxis::AxisOrientation orientation);
 
     virtual void lowerShadowQuality();
+    virtual void applyDataUpdates() = 0;
 
     void fixGradient(QLinearGradient *gradient, GLuint *gradientTexture);
 
@@ -202,6 +218,7 @@ protected:
     void loadGridLineMesh();
     void loadLabelMesh();
     void loadPositionMapperMesh();
+    void rekeySharedResources();
 
     void drawRadialGrid(ShaderHelper *shader, float yFloorLinePos,
                         const QMatrix4x4 &projectionViewMatrix, const QMatrix4x4 &depthMatrix);
@@ -218,10 +235,15 @@ protected:
                               const QMatrix4x4 &projectionViewMatrix);
     void queriedGraphPosition(const QMatrix4x4 &projectionViewMatrix, const QVector3D &scaling,
                               GLuint defaultFboHandle);
+    bool reuseSelectionBuffer();
+    // Returns the step between the items to draw this frame when the progressive optimization
+    // is in use, or 1 when all of the items are drawn.
+    int progressiveStride(int itemCount, int itemBudget);
 
     bool m_hasNegativeValues;
     Q3DTheme *m_cachedTheme;
     Drawer *m_drawer;
+    QElapsedTimer m_renderTimer;
     QRect m_viewport;
     QAbstract3DGraph::ShadowQuality m_cachedShadowQuality;
     GLfloat m_autoScaleAdjustment;
@@ -307,6 +329,18 @@ protected:
 
     bool m_reflectionEnabled;
     qreal m_reflectivity;
+    bool m_reducedQuality; // Set by the controller while adaptive quality is in effect
+    bool m_skipShadowPass; // Shadow casters are not drawn, but shadow resources are kept
+
+    Abstract3DController::FrameChanges m_frameChanges;
+    Abstract3DController::FrameChanges m_pendingFrameChanges;
+    bool m_selectionBufferValid;
+    bool m_dataUpdatesPending;
+    qint64 m_lastFrameNsecs;
+    int m_refinementLevel; // Number of unchanged frames drawn since the last change
+    bool m_refining; // Some items were skipped during the current frame
+    FrameStatistics m_frameStatistics;
+    QThread *m_resourceThread; // Thread the shared meshes and programs were acquired for
 
     QLocale m_locale;
 #if !QT_CONFIG(opengles2)
@@ -0,0 +1,54 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "adaptivequality_p.h"
+
+QT_BEGIN_NAMESPACE
+
+AdaptiveQuality::AdaptiveQuality()
+    : m_frameTimeBudget(33000000),
+      m_reduced(false),
+      m_restored(false),
+      m_restoreInterval(minRestoreInterval)
+{
+}
+
+void AdaptiveQuality::setFrameTimeBudget(qint64 nsecs)
+{
+    m_frameTimeBudget = nsecs;
+}
+
+bool AdaptiveQuality::update(bool cameraChanged, bool active, qint64 lastFrameNsecs,
+                             bool restoreDue)
+{
+    const bool overBudget = active && lastFrameNsecs > m_frameTimeBudget;
+
+    // The last frame was the first one rendered at full quality after a restore
+    if (m_restored && active) {
+        m_restored = false;
+        if (overBudget)
+            m_restoreInterval = qMin(m_restoreInterval * 2, int(maxRestoreInterval));
+        else
+            m_restoreInterval = minRestoreInterval;
+    }
+
+    if (cameraChanged || overBudget || (m_reduced && active)) {
+        m_reduced = true;
+        return true;
+    }
+
+    if (m_reduced && restoreDue) {
+        m_reduced = false;
+        m_restored = true;
+    }
+    return false;
+}
+
+void AdaptiveQuality::reset()
+{
+    m_reduced = false;
+    m_restored = false;
+    m_restoreInterval = minRestoreInterval;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,55 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef ADAPTIVEQUALITY_P_H
+#define ADAPTIVEQUALITY_P_H
+
+#include "datavisualizationglobal_p.h"
+
+QT_BEGIN_NAMESPACE
+
+// Decides which frames adaptive quality renders at reduced quality. Quality is reduced while
+// the camera moves or when changed frames take longer than the budget, and stays reduced as long
+// as frames keep changing. Full quality is restored once the graph has been idle for the restore
+// interval. If the first changed frame after a restore shows that full quality is still over
+// budget, the interval is doubled, so quality does not flip on every change of a slow graph.
+class Q_DATAVISUALIZATION_EXPORT AdaptiveQuality
+{
+public:
+    AdaptiveQuality();
+
+    void setFrameTimeBudget(qint64 nsecs);
+    inline qint64 frameTimeBudget() const { return m_frameTimeBudget; }
+
+    // Called for each synced frame. Active frames have changes to render, and restoreDue tells
+    // that the graph has been idle for the restore interval. Returns whether the idle timer must
+    // be restarted, which is the case whenever an active frame keeps the quality reduced.
+    bool update(bool cameraChanged, bool active, qint64 lastFrameNsecs, bool restoreDue);
+    void reset();
+
+    inline bool isReduced() const { return m_reduced; }
+    inline int restoreInterval() const { return m_restoreInterval; }
+
+    static const int minRestoreInterval = 500;
+    static const int maxRestoreInterval = 8000;
+
+private:
+    qint64 m_frameTimeBudget;
+    bool m_reduced;
+    bool m_restored;
+    int m_restoreInterval;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -26,6 +26,8 @@ Bars3DController::Bars3DController(QRect boundRect, Q3DScene *scene)
       m_barSpacing(QSizeF(1.0, 1.0)),
       m_floorLevel(0.0f),
       m_barSeriesMargin(0.0f, 0.0f),
+      m_occlusionCulling(false),
+      m_reflectionTextureEnabled(true),
       m_renderer(0)
 {
     // Setting a null axis creates a new default axis according to orientation and graph type.
@@ -65,6 +67,10 @@ void Bars3DController::synchDataToRenderer()
     if (!isInitialized())
         return;
 
+    // Data snapshotted in the previous pass must be applied before new snapshots are taken,
+    // in case no frame was rendered in between
+    m_renderer->flushDataUpdates();
+
     // Background change requires reloading the meshes in bar graphs, so dirty the series visuals
     if (m_themeManager->activeTheme()->d_ptr->m_dirtyBits.backgroundEnabledDirty) {
         m_isSeriesVisualsDirty = true;
@@ -82,42 +88,61 @@ void Bars3DController::synchDataToRenderer()
     // Floor level update requires data update, so do before abstract sync
     if (m_changeTracker.floorLevelChanged) {
         m_renderer->updateFloorLevel(m_floorLevel);
+        m_renderer->markFrameChanges(FrameChangeOther);
         m_changeTracker.floorLevelChanged = false;
     }
 
     if (m_changeTracker.barSeriesMarginChanged) {
         m_renderer->updateBarSeriesMargin(m_barSeriesMargin);
+        m_renderer->markFrameChanges(FrameChangeOther);
         m_changeTracker.barSeriesMarginChanged = false;
     }
 
+    if (m_changeTracker.occlusionCullingChanged) {
+        m_renderer->updateOcclusionCulling(m_occlusionCulling);
+        m_renderer->markFrameChanges(FrameChangeOther);
+        m_changeTracker.occlusionCullingChanged = false;
+    }
+
+    if (m_changeTracker.reflectionTextureChanged) {
+        m_renderer->updateReflectionTextureEnabled(m_reflectionTextureEnabled);
+        m_renderer->markFrameChanges(FrameChangeOther);
+        m_changeTracker.reflectionTextureChanged = false;
+    }
+
     Abstract3DController::synchDataToRenderer();
 
     // Notify changes to renderer
     if (m_changeTracker.rowsChanged) {
         m_renderer->updateRows(m_changedRows);
+        m_renderer->markFrameChanges(FrameChangeData);
         m_changeTracker.rowsChanged = false;
         m_changedRows.clear();
     }
 
     if (m_changeTracker.itemChanged) {
         m_renderer->updateItems(m_changedItems);
+        m_renderer->markFrameChanges(FrameChangeData);
         m_changeTracker.itemChanged = false;
         m_changedItems.clear();
     }
 
     if (m_changeTracker.multiSeriesScalingChanged) {
         m_renderer->updateMultiSeriesScaling(m_isMultiSeriesUniform);
+        m_renderer->markFrameChanges(FrameChangeOther);
         m_changeTracker.multiSeriesScalingChanged = false;
     }
 
     if (m_changeTracker.barSpecsChanged) {
         m_renderer->updateBarSpecs(m_barThicknessRatio, m_barSpacing, m_isBarSpecRelative);
+        m_renderer->markFrameChanges(FrameChangeOther);
         m_changeTracker.barSpecsChanged = false;
     }
 
     // Needs to be done after data is set, as it needs to know the visual array.
     if (m_changeTracker.selectedBarChanged) {
         m_renderer->updateSelectedBar(m_selectedBar, m_selectedBarSeries);
+        m_renderer->markFrameChanges(FrameChangeSelection);
         m_changeTracker.selectedBarChanged = false;
     }
 
@@ -527,6 +552,30 @@ float Bars3DController::floorLevel() const
     return m_floorLevel;
 }
 
+void Bars3DController::setOcclusionCulling(bool enable)
+{
+    m_occlusionCulling = enable;
+    m_changeTracker.occlusionCullingChanged = true;
+    emitNeedRender();
+}
+
+bool Bars3DController::isOcclusionCulling() const
+{
+    return m_occlusionCulling;
+}
+
+void Bars3DController::setReflectionTextureEnabled(bool enable)
+{
+    m_reflectionTextureEnabled = enable;
+    m_changeTracker.reflectionTextureChanged = true;
+    emitNeedRender();
+}
+
+bool Bars3DController::isReflectionTextureEnabled() const
+{
+    return m_reflectionTextureEnabled;
+}
+
 void Bars3DController::setSelectionMode(QAbstract3DGraph::SelectionFlags mode)
 {
     if (mode.testFlag(QAbstract3DGraph::SelectionSlice)
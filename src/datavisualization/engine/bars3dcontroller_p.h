@@ -30,6 +30,8 @@ struct Bars3DChangeBitField {
     bool itemChanged                : 1;
     bool floorLevelChanged          : 1;
     bool barSeriesMarginChanged     : 1;
+    bool occlusionCullingChanged    : 1;
+    bool reflectionTextureChanged   : 1;
 
     Bars3DChangeBitField() :
         multiSeriesScalingChanged(true),
@@ -38,7 +40,9 @@ struct Bars3DChangeBitField {
         rowsChanged(false),
         itemChanged(false),
         floorLevelChanged(false),
-        barSeriesMarginChanged(false)
+        barSeriesMarginChanged(false),
+        occlusionCullingChanged(false),
+        reflectionTextureChanged(false)
     {
     }
 };
@@ -75,6 +79,8 @@ private:
     QSizeF m_barSpacing;
     float m_floorLevel;
     QSizeF m_barSeriesMargin;
+    bool m_occlusionCulling;
+    bool m_reflectionTextureEnabled;
 
     // Rendering
     Bars3DRenderer *m_renderer;
@@ -103,6 +109,11 @@ public:
     bool isBarSpecRelative();
     void setFloorLevel(float level);
     float floorLevel() const;
+    void setOcclusionCulling(bool enable);
+    bool isOcclusionCulling() const;
+    // Only for comparing the reflection texture to drawing the reflections directly in benchmarks
+    void setReflectionTextureEnabled(bool enable);
+    bool isReflectionTextureEnabled() const;
 
     inline QBar3DSeries *selectedSeries() const { return m_selectedBarSeries; }
 
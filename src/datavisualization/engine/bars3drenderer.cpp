@@ -9,8 +9,14 @@
 #include "texturehelper_p.h"
 #include "utils_p.h"
 #include "barseriesrendercache_p.h"
+#include "qlogvalue3daxisformatter_p.h"
+#include "rowchunks_p.h"
 
 #include <QtCore/qmath.h>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVarLengthArray>
+
+#include <cmath>
 
 // You can verify that depth buffer drawing works correctly by uncommenting this.
 // You should see the scene from  where the light is
@@ -19,6 +25,49 @@
 QT_BEGIN_NAMESPACE
 
 const bool sliceGridLabels = true;
+// Rows per block tested against the view frustum before testing single bars
+const int cullingRowBlockSize = 16;
+// Shadows of bars on the far side of the floor are drawn slightly off it
+const float shadowFloorOffset = 0.015f;
+// Smallest number of render items worth preparing in a separate thread
+const int minRenderItemsPerChunk = 16384;
+
+static inline QQuaternion barRotation(float angle)
+{
+    if (angle)
+        return QQuaternion::fromAxisAndAngle(upVector, angle);
+    return identityQuaternion;
+}
+
+void BarHeightMapping::map(const float *values, float *heights, int count) const
+{
+    // Members are copied to locals, as the compiler must otherwise assume that writing the
+    // heights can change them, which prevents vectorizing the loops
+    const float min = axisMin;
+    const float range = axisRange;
+    if (customFormatter) {
+        for (int i = 0; i < count; i++)
+            heights[i] = customFormatter->positionAt(values[i]);
+    } else if (logarithmic) {
+        for (int i = 0; i < count; i++)
+            heights[i] = (std::log(values[i]) - min) / range;
+    } else {
+        for (int i = 0; i < count; i++)
+            heights[i] = (values[i] - min) / range;
+    }
+
+    // Kept free of branches. The comparisons let NaN values through unchanged.
+    const float heightOffset = offset;
+    const float lower = lowerBound;
+    const float upper = upperBound;
+    const float heightSign = sign;
+    for (int i = 0; i < count; i++) {
+        float height = heights[i] + heightOffset;
+        height = height < lower ? lower : height;
+        height = height > upper ? upper : height;
+        heights[i] = height * heightSign;
+    }
+}
 
 Bars3DRenderer::Bars3DRenderer(Bars3DController *controller)
     : Abstract3DRenderer(controller),
@@ -40,6 +89,11 @@ Bars3DRenderer::Bars3DRenderer(Bars3DController *controller)
       m_depthFrameBuffer(0),
       m_selectionFrameBuffer(0),
       m_selectionDepthBuffer(0),
+      m_reflectionTexture(0),
+      m_reflectionFrameBuffer(0),
+      m_reflectionDepthBuffer(0),
+      m_reflectionTextureValid(false),
+      m_reflectionTextureEnabled(true),
       m_shadowQualityToShader(100.0f),
       m_shadowQualityMultiplier(3),
       m_heightNormalizer(1.0f),
@@ -67,7 +121,9 @@ Bars3DRenderer::Bars3DRenderer(Bars3DController *controller)
       m_xScaleFactor(1.0f),
       m_zScaleFactor(1.0f),
       m_floorLevel(0.0f),
-      m_actualFloorLevel(0.0f)
+      m_actualFloorLevel(0.0f),
+      m_occlusionCulling(false),
+      m_dataSnapshotPending(false)
 {
     m_axisCacheY.setScale(2.0f);
     m_axisCacheY.setTranslate(-1.0f);
@@ -91,6 +147,9 @@ void Bars3DRenderer::contextCleanup()
         m_textureHelper->glDeleteFramebuffers(1, &m_selectionFrameBuffer);
         m_textureHelper->glDeleteRenderbuffers(1, &m_selectionDepthBuffer);
         m_textureHelper->deleteTexture(&m_selectionTexture);
+        m_textureHelper->glDeleteFramebuffers(1, &m_reflectionFrameBuffer);
+        m_textureHelper->glDeleteRenderbuffers(1, &m_reflectionDepthBuffer);
+        m_textureHelper->deleteTexture(&m_reflectionTexture);
         m_textureHelper->glDeleteFramebuffers(1, &m_depthFrameBuffer);
         m_textureHelper->deleteTexture(&m_bgrTexture);
     }
@@ -163,6 +222,45 @@ void Bars3DRenderer::getVisibleItemBounds(QVector3D &minBounds, QVector3D &maxBo
 }
 
 void Bars3DRenderer::updateData()
+{
+    // All visible series are snapshotted, as axis range changes may require reading
+    // rows that have not changed
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
+        if (cache->isVisible())
+            cache->takeDataSnapshot();
+    }
+    m_dataSnapshotPending = true;
+    m_dataUpdatesPending = true;
+}
+
+void Bars3DRenderer::applyDataUpdates()
+{
+    if (m_dataSnapshotPending) {
+        applyData();
+        m_dataSnapshotPending = false;
+    }
+    if (!m_pendingRows.isEmpty()) {
+        applyRows(m_pendingRows);
+        m_pendingRows.clear();
+    }
+    if (!m_pendingItems.isEmpty()) {
+        applyItems(m_pendingItems);
+        m_pendingItems.clear();
+    }
+
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList)
+        static_cast<BarSeriesRenderCache *>(baseCache)->releaseDataSnapshot();
+}
+
+void Bars3DRenderer::takeDataSnapshot(QBar3DSeries *series)
+{
+    BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(m_renderCacheList.value(series));
+    if (cache && cache->isVisible())
+        cache->takeDataSnapshot();
+}
+
+void Bars3DRenderer::applyData()
 {
     int minRow = m_axisCacheZ.min();
     int maxRow = m_axisCacheZ.max();
@@ -199,11 +297,11 @@ void Bars3DRenderer::updateData()
     calculateSceneScalingFactors();
 
     m_zeroPosition = m_axisCacheY.formatter()->positionAt(m_actualFloorLevel);
+    const BarHeightMapping mapping = heightMapping();
 
     foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
         BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
         if (cache->isVisible()) {
-            const QBar3DSeries *currentSeries = cache->series();
             BarRenderItemArray &renderArray = cache->renderArray();
             bool dimensionsChanged = false;
             if (newRows != renderArray.size()
@@ -217,21 +315,30 @@ void Bars3DRenderer::updateData()
             }
 
             if (cache->dataDirty() || dimensionsChanged) {
-                QBarDataProxy *dataProxy = currentSeries->dataProxy();
-                dataRowCount = dataProxy->rowCount();
+                const QBarDataArray &dataArray = cache->dataSnapshot();
+                dataRowCount = dataArray.size();
                 if (maxDataRowCount < dataRowCount)
                     maxDataRowCount = qMin(dataRowCount, newRows);
-                int dataRowIndex = minRow;
-                for (int i = 0; i < newRows; i++) {
-                    BarRenderItemRow &renderRow = renderArray[i];
-                    const QBarDataRow *dataRow = 0;
-                    if (dataRowIndex < dataRowCount)
-                        dataRow = dataProxy->rowAt(dataRowIndex);
-                    updateRenderRow(dataRow, renderRow);
-                    dataRowIndex++;
+                // Rows are independent, so large arrays are prepared in parallel
+                BarRenderItemRow *renderRows = renderArray.data();
+                auto prepareRows = [&](int firstRow, int lastRow) {
+                    for (int i = firstRow; i < lastRow; i++) {
+                        const int dataRowIndex = minRow + i;
+                        const QBarDataRow *dataRow = 0;
+                        if (dataRowIndex < dataRowCount)
+                            dataRow = dataArray.at(dataRowIndex);
+                        updateRenderRow(dataRow, renderRows[i], mapping);
+                    }
+                };
+                if (mapping.customFormatter) {
+                    prepareRows(0, newRows);
+                } else {
+                    forEachRowChunk(newRows, minRenderItemsPerChunk / qMax(1, newColumns),
+                                    prepareRows);
                 }
                 cache->setDataDirty(false);
             }
+            cache->setRowBlocksDirty();
         }
     }
 
@@ -240,57 +347,87 @@ void Bars3DRenderer::updateData()
                       m_selectedSeriesCache ? m_selectedSeriesCache->series() : 0);
 }
 
-void Bars3DRenderer::updateRenderRow(const QBarDataRow *dataRow, BarRenderItemRow &renderRow)
+// Matches AxisRenderCache::positionAt() with the floor level and axis reversal applied
+BarHeightMapping Bars3DRenderer::heightMapping() const
+{
+    BarHeightMapping mapping;
+    // The range of the built-in formatters is read from the values their positionAt() uses.
+    // Subclasses are told apart by their meta-object, see QValue3DAxisFormatter.
+    const QValue3DAxisFormatter *formatter = m_axisCacheY.formatter();
+    const QMetaObject *formatterType = formatter->metaObject();
+    if (formatterType == &QValue3DAxisFormatter::staticMetaObject) {
+        const QValue3DAxisFormatterPrivate *d = formatter->d_ptr.data();
+        mapping.axisMin = d->m_min;
+        mapping.axisRange = d->m_rangeNormalizer;
+    } else if (formatterType == &QLogValue3DAxisFormatter::staticMetaObject) {
+        const QLogValue3DAxisFormatterPrivate *d =
+                static_cast<const QLogValue3DAxisFormatterPrivate *>(formatter->d_ptr.data());
+        mapping.logarithmic = true;
+        mapping.axisMin = float(d->m_logMin);
+        mapping.axisRange = float(d->m_logRangeNormalizer);
+    } else {
+        mapping.customFormatter = formatter;
+    }
+
+    if (m_noZeroInRange) {
+        if (m_hasNegativeValues) {
+            mapping.offset = -1.0f;
+            mapping.upperBound = 0.0f;
+        } else {
+            mapping.lowerBound = 0.0f;
+        }
+    } else {
+        mapping.offset = -m_zeroPosition;
+    }
+    if (m_axisCacheY.reversed())
+        mapping.sign = -1.0f;
+
+    return mapping;
+}
+
+void Bars3DRenderer::updateRenderRow(const QBarDataRow *dataRow, BarRenderItemRow &renderRow,
+                                     const BarHeightMapping &mapping) const
 {
     int j = 0;
     int renderRowSize = renderRow.size();
     int startIndex = m_axisCacheX.min();
+    BarRenderItem *renderItems = renderRow.data();
 
     if (dataRow) {
         int updateSize = qMin((dataRow->size() - startIndex), renderRowSize);
-        int dataColIndex = startIndex;
-        for (; j < updateSize ; j++) {
-            updateRenderItem(dataRow->at(dataColIndex), renderRow[j]);
-            dataColIndex++;
+        if (updateSize > 0) {
+            // Values are gathered first, so that the heights are mapped in one tight loop
+            const QBarDataItem *dataItems = dataRow->constData() + startIndex;
+            QVarLengthArray<float, 1024> values(updateSize);
+            QVarLengthArray<float, 1024> heights(updateSize);
+            for (int k = 0; k < updateSize; k++)
+                values[k] = dataItems[k].value();
+            mapping.map(values.constData(), heights.data(), updateSize);
+            for (; j < updateSize; j++) {
+                BarRenderItem &renderItem = renderItems[j];
+                renderItem.setValue(values[j]);
+                renderItem.setHeight(heights[j]);
+                renderItem.setRotation(barRotation(dataItems[j].rotation()));
+            }
         }
     }
     for (; j < renderRowSize; j++) {
-        renderRow[j].setValue(0.0f);
-        renderRow[j].setHeight(0.0f);
-        renderRow[j].setRotation(identityQuaternion);
+        renderItems[j].setValue(0.0f);
+        renderItems[j].setHeight(0.0f);
+        renderItems[j].setRotation(identityQuaternion);
     }
 }
 
-void Bars3DRenderer::updateRenderItem(const QBarDataItem &dataItem, BarRenderItem &renderItem)
+void Bars3DRenderer::updateRenderItem(const QBarDataItem &dataItem, BarRenderItem &renderItem,
+                                      const BarHeightMapping &mapping) const
 {
     float value = dataItem.value();
-    float heightValue = m_axisCacheY.formatter()->positionAt(value);
-    if (m_noZeroInRange) {
-        if (m_hasNegativeValues) {
-            heightValue = -1.0f + heightValue;
-            if (heightValue > 0.0f)
-                heightValue = 0.0f;
-        } else {
-            if (heightValue < 0.0f)
-                heightValue = 0.0f;
-        }
-    } else {
-        heightValue -= m_zeroPosition;
-    }
-    if (m_axisCacheY.reversed())
-        heightValue = -heightValue;
+    float height;
+    mapping.map(&value, &height, 1);
 
     renderItem.setValue(value);
-    renderItem.setHeight(heightValue);
-
-    float angle = dataItem.rotation();
-    if (angle) {
-        renderItem.setRotation(
-                    QQuaternion::fromAxisAndAngle(
-                        upVector, angle));
-    } else {
-        renderItem.setRotation(identityQuaternion);
-    }
+    renderItem.setHeight(height);
+    renderItem.setRotation(barRotation(dataItem.rotation()));
 }
 
 void Bars3DRenderer::updateSeries(const QList<QAbstract3DSeries *> &seriesList)
@@ -336,12 +473,26 @@ SeriesRenderCache *Bars3DRenderer::createNewCache(QAbstract3DSeries *series)
 }
 
 void Bars3DRenderer::updateRows(const QList<Bars3DController::ChangeRow> &rows)
+{
+    const QBar3DSeries *prevSeries = 0;
+    foreach (const Bars3DController::ChangeRow &item, rows) {
+        if (item.series != prevSeries) {
+            takeDataSnapshot(item.series);
+            prevSeries = item.series;
+        }
+    }
+    m_pendingRows.append(rows);
+    m_dataUpdatesPending = true;
+}
+
+void Bars3DRenderer::applyRows(const QList<Bars3DController::ChangeRow> &rows)
 {
     int minRow = m_axisCacheZ.min();
     int maxRow = m_axisCacheZ.max();
     BarSeriesRenderCache *cache = 0;
     const QBar3DSeries *prevSeries = 0;
     const QBarDataArray *dataArray = 0;
+    const BarHeightMapping mapping = heightMapping();
 
     foreach (Bars3DController::ChangeRow item, rows) {
         const int row = item.row;
@@ -351,14 +502,15 @@ void Bars3DRenderer::updateRows(const QList<Bars3DController::ChangeRow> &rows)
         if (currentSeries != prevSeries) {
             cache = static_cast<BarSeriesRenderCache *>(m_renderCacheList.value(currentSeries));
             prevSeries = currentSeries;
-            dataArray = item.series->dataProxy()->array();
+            dataArray = &cache->dataSnapshot();
             // Invisible series render caches are not updated, but instead just marked dirty, so that
             // they can be completely recalculated when they are turned visible.
             if (!cache->isVisible() && !cache->dataDirty())
                 cache->setDataDirty(true);
         }
         if (cache->isVisible()) {
-            updateRenderRow(dataArray->at(row), cache->renderArray()[row - minRow]);
+            updateRenderRow(dataArray->at(row), cache->renderArray()[row - minRow], mapping);
+            cache->setRowBlocksDirty();
             if (m_cachedIsSlicingActivated
                     && cache == m_selectedSeriesCache
                     && m_selectedBarPos.x() == row) {
@@ -369,6 +521,19 @@ void Bars3DRenderer::updateRows(const QList<Bars3DController::ChangeRow> &rows)
 }
 
 void Bars3DRenderer::updateItems(const QList<Bars3DController::ChangeItem> &items)
+{
+    const QBar3DSeries *prevSeries = 0;
+    foreach (const Bars3DController::ChangeItem &item, items) {
+        if (item.series != prevSeries) {
+            takeDataSnapshot(item.series);
+            prevSeries = item.series;
+        }
+    }
+    m_pendingItems.append(items);
+    m_dataUpdatesPending = true;
+}
+
+void Bars3DRenderer::applyItems(const QList<Bars3DController::ChangeItem> &items)
 {
     int minRow = m_axisCacheZ.min();
     int maxRow = m_axisCacheZ.max();
@@ -377,6 +542,7 @@ void Bars3DRenderer::updateItems(const QList<Bars3DController::ChangeItem> &item
     BarSeriesRenderCache *cache = 0;
     const QBar3DSeries *prevSeries = 0;
     const QBarDataArray *dataArray = 0;
+    const BarHeightMapping mapping = heightMapping();
 
     foreach (Bars3DController::ChangeItem item, items) {
         const int row = item.point.x();
@@ -387,7 +553,7 @@ void Bars3DRenderer::updateItems(const QList<Bars3DController::ChangeItem> &item
         if (currentSeries != prevSeries) {
             cache = static_cast<BarSeriesRenderCache *>(m_renderCacheList.value(currentSeries));
             prevSeries = currentSeries;
-            dataArray = item.series->dataProxy()->array();
+            dataArray = &cache->dataSnapshot();
             // Invisible series render caches are not updated, but instead just marked dirty, so that
             // they can be completely recalculated when they are turned visible.
             if (!cache->isVisible() && !cache->dataDirty())
@@ -395,7 +561,8 @@ void Bars3DRenderer::updateItems(const QList<Bars3DController::ChangeItem> &item
         }
         if (cache->isVisible()) {
             updateRenderItem(dataArray->at(row)->at(col),
-                             cache->renderArray()[row - minRow][col - minCol]);
+                             cache->renderArray()[row - minRow][col - minCol], mapping);
+            cache->setRowBlocksDirty();
             if (m_cachedIsSlicingActivated
                     && cache == m_selectedSeriesCache
                     && m_selectedBarPos == QPoint(row, col)) {
@@ -1010,9 +1177,6 @@ void Bars3DRenderer::drawScene(GLuint defaultFboHandle)
     else if (viewMatrix.row(0).x() <= 0 && viewMatrix.row(0).z() <= 0)
         backgroundRotation = 0.0f;
 
-    // Get light position from the scene
-    QVector3D lightPos =  m_cachedScene->activeLight()->position();
-
     // Skip depth rendering if we're in slice mode
     // Introduce regardless of shadow quality to simplify logic
     QMatrix4x4 depthViewMatrix;
@@ -1020,6 +1184,7 @@ void Bars3DRenderer::drawScene(GLuint defaultFboHandle)
     QMatrix4x4 depthProjectionViewMatrix;
 
     QMatrix4x4 projectionViewMatrix = projectionMatrix * viewMatrix;
+    const Frustum frustum(projectionViewMatrix);
 
     BarRenderItem *selectedBar(0);
 
@@ -1048,91 +1213,99 @@ void Bars3DRenderer::drawScene(GLuint defaultFboHandle)
         depthProjectionMatrix.perspective(10.0f, viewPortRatio, 3.0f, 100.0f);
         depthProjectionViewMatrix = depthProjectionMatrix * depthViewMatrix;
 
-        // Draw bars to depth buffer
-        QVector3D shadowScaler(m_scaleX * m_seriesScaleX * 0.9f, 0.0f,
-                               m_scaleZ * m_seriesScaleZ * 0.9f);
-        foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-            if (baseCache->isVisible()) {
-                BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
-                float seriesPos = m_seriesStart + m_seriesStep
-                        * (cache->visualIndex() - (cache->visualIndex()
-                                                   * m_cachedBarSeriesMargin.width())) + 0.5f;
-                ObjectHelper *barObj = cache->object();
-                QQuaternion seriesRotation(cache->meshRotation());
-                const BarRenderItemArray &renderArray = cache->renderArray();
-                for (int row = startRow; row != stopRow; row += stepRow) {
-                    const BarRenderItemRow &renderRow = renderArray.at(row);
-                    for (int bar = startBar; bar != stopBar; bar += stepBar) {
-                        const BarRenderItem &item = renderRow.at(bar);
-                        if (!item.value())
-                            continue;
-                        GLfloat shadowOffset = 0.0f;
-                        // Set front face culling for negative valued bars and back face culling
-                        // for positive valued bars to remove peter-panning issues
-                        if (item.height() > 0) {
-                            glCullFace(GL_BACK);
-                            if (m_yFlipped)
-                                shadowOffset = 0.015f;
-                        } else {
-                            glCullFace(GL_FRONT);
-                            if (!m_yFlipped)
-                                shadowOffset = -0.015f;
+        // Adaptive quality skips drawing the shadow casters. The cleared depth texture leaves
+        // the scene unshadowed without switching shaders or recreating the depth buffer.
+        if (!m_skipShadowPass) {
+            // Draw bars to depth buffer, culled against the light frustum
+            const Frustum depthFrustum(depthProjectionViewMatrix);
+            QVector3D shadowScaler(m_scaleX * m_seriesScaleX * 0.9f, 0.0f,
+                                   m_scaleZ * m_seriesScaleZ * 0.9f);
+            foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+                if (baseCache->isVisible()) {
+                    BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
+                    float seriesPos = m_seriesStart + m_seriesStep
+                            * (cache->visualIndex() - (cache->visualIndex()
+                                                       * m_cachedBarSeriesMargin.width())) + 0.5f;
+                    ObjectHelper *barObj = cache->object();
+                    QQuaternion seriesRotation(cache->meshRotation());
+                    const BarRenderItemArray &renderArray = cache->renderArray();
+                    const QList<BarRowBlock> &rowBlocks = cache->rowBlocks(cullingRowBlockSize);
+                    int currentBlock = -1;
+                    Frustum::Containment blockContainment = Frustum::Inside;
+                    for (int row = startRow; row != stopRow; row += stepRow) {
+                        const int block = row / cullingRowBlockSize;
+                        if (block != currentBlock) {
+                            currentBlock = block;
+                            blockContainment = rowBlockContainment(depthFrustum,
+                                                                   rowBlocks.at(block), block,
+                                                                   seriesPos, seriesRotation, 1.0f,
+                                                                   shadowFloorOffset);
                         }
-
-                        if (m_cachedTheme->isBackgroundEnabled() && m_reflectionEnabled
-                                && ((m_yFlipped && item.height() > 0.0)
-                                    || (!m_yFlipped && item.height() < 0.0))) {
+                        if (blockContainment == Frustum::Outside) {
+                            m_frameStatistics.culledItems += m_cachedColumnCount;
                             continue;
                         }
+                        const BarRenderItemRow &renderRow = renderArray.at(row);
+                        for (int bar = startBar; bar != stopBar; bar += stepBar) {
+                            const BarRenderItem &item = renderRow.at(bar);
+                            if (!item.value())
+                                continue;
+                            if (blockContainment == Frustum::Intersecting
+                                    && !isBarInFrustum(depthFrustum, row, bar, seriesPos, item,
+                                                       seriesRotation, 1.0f, shadowFloorOffset)) {
+                                m_frameStatistics.culledItems++;
+                                continue;
+                            }
+                            GLfloat shadowOffset = 0.0f;
+                            // Set front face culling for negative valued bars and back face culling
+                            // for positive valued bars to remove peter-panning issues
+                            if (item.height() > 0) {
+                                glCullFace(GL_BACK);
+                                if (m_yFlipped)
+                                    shadowOffset = shadowFloorOffset;
+                            } else {
+                                glCullFace(GL_FRONT);
+                                if (!m_yFlipped)
+                                    shadowOffset = -shadowFloorOffset;
+                            }
 
-                        QMatrix4x4 modelMatrix;
-                        QMatrix4x4 MVPMatrix;
-
-                        colPos = (bar + seriesPos) * (m_cachedBarSpacing.width());
-                        rowPos = (row + 0.5f) * (m_cachedBarSpacing.height());
-
-                        // Draw shadows for bars "on the other side" a bit off ground to avoid
-                        // seeing shadows through the ground
-                        modelMatrix.translate((colPos - m_rowWidth) / m_scaleFactor,
-                                              item.height() + shadowOffset,
-                                              (m_columnDepth - rowPos) / m_scaleFactor);
-                        // Scale the bars down in X and Z to reduce self-shadowing issues
-                        shadowScaler.setY(item.height());
-                        if (!seriesRotation.isIdentity() || !item.rotation().isIdentity())
-                            modelMatrix.rotate(seriesRotation * item.rotation());
-                        modelMatrix.scale(shadowScaler);
-
-                        MVPMatrix = depthProjectionViewMatrix * modelMatrix;
-
-                        m_depthShader->setUniformValue(m_depthShader->MVP(), MVPMatrix);
+                            if (m_cachedTheme->isBackgroundEnabled() && m_reflectionEnabled
+                                    && ((m_yFlipped && item.height() > 0.0)
+                                        || (!m_yFlipped && item.height() < 0.0))) {
+                                continue;
+                            }
 
-                        // 1st attribute buffer : vertices
-                        glEnableVertexAttribArray(m_depthShader->posAtt());
-                        glBindBuffer(GL_ARRAY_BUFFER, barObj->vertexBuf());
-                        glVertexAttribPointer(m_depthShader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0,
-                                              (void *)0);
+                            QMatrix4x4 modelMatrix;
+                            QMatrix4x4 MVPMatrix;
 
-                        // Index buffer
-                        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, barObj->elementBuf());
+                            colPos = (bar + seriesPos) * (m_cachedBarSpacing.width());
+                            rowPos = (row + 0.5f) * (m_cachedBarSpacing.height());
 
-                        // Draw the triangles
-                        glDrawElements(GL_TRIANGLES, barObj->indexCount(), GL_UNSIGNED_INT,
-                                       (void *)0);
+                            // Draw shadows for bars "on the other side" a bit off ground to avoid
+                            // seeing shadows through the ground
+                            modelMatrix.translate((colPos - m_rowWidth) / m_scaleFactor,
+                                                  item.height() + shadowOffset,
+                                                  (m_columnDepth - rowPos) / m_scaleFactor);
+                            // Scale the bars down in X and Z to reduce self-shadowing issues
+                            shadowScaler.setY(item.height());
+                            if (!seriesRotation.isIdentity() || !item.rotation().isIdentity())
+                                modelMatrix.rotate(seriesRotation * item.rotation());
+                            modelMatrix.scale(shadowScaler);
 
-                        // Free buffers
-                        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-                        glBindBuffer(GL_ARRAY_BUFFER, 0);
+                            MVPMatrix = depthProjectionViewMatrix * modelMatrix;
 
-                        glDisableVertexAttribArray(m_depthShader->posAtt());
+                            m_depthShader->setUniformValue(m_depthShader->MVP(), MVPMatrix);
+                            m_drawer->drawSelectionObject(m_depthShader, barObj);
+                        }
                     }
                 }
             }
-        }
 
-        Abstract3DRenderer::drawCustomItems(RenderingDepth, m_depthShader, viewMatrix,
-                                            projectionViewMatrix,
-                                            depthProjectionViewMatrix, m_depthTexture,
-                                            m_shadowQualityToShader);
+            Abstract3DRenderer::drawCustomItems(RenderingDepth, m_depthShader, viewMatrix,
+                                                projectionViewMatrix,
+                                                depthProjectionViewMatrix, m_depthTexture,
+                                                m_shadowQualityToShader);
+        }
 
         // Disable drawing to depth framebuffer (= enable drawing to screen)
         glBindFramebuffer(GL_FRAMEBUFFER, defaultFboHandle);
@@ -1171,70 +1344,92 @@ void Bars3DRenderer::drawScene(GLuint defaultFboHandle)
                    m_primarySubViewport.width(),
                    m_primarySubViewport.height());
 
-        glEnable(GL_DEPTH_TEST); // Needed, otherwise the depth render buffer is not used
-        glClearColor(1.0f, 1.0f, 1.0f, 1.0f); // Set clear color to white (= selectionSkipColor)
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Needed for clearing the frame buffer
-        glDisable(GL_DITHER); // disable dithering, it may affect colors if enabled
-        foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-            if (baseCache->isVisible()) {
-                BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
-                float seriesPos = m_seriesStart + m_seriesStep
-                        * (cache->visualIndex() - (cache->visualIndex()
-                                                   * m_cachedBarSeriesMargin.width())) + 0.5f;
-                ObjectHelper *barObj = cache->object();
-                QQuaternion seriesRotation(cache->meshRotation());
-                const BarRenderItemArray &renderArray = cache->renderArray();
-                for (int row = startRow; row != stopRow; row += stepRow) {
-                    const BarRenderItemRow &renderRow = renderArray.at(row);
-                    for (int bar = startBar; bar != stopBar; bar += stepBar) {
-                        const BarRenderItem &item = renderRow.at(bar);
-                        if (!item.value())
+        if (!reuseSelectionBuffer()) {
+            glEnable(GL_DEPTH_TEST); // Needed, otherwise the depth render buffer is not used
+            glClearColor(1.0f, 1.0f, 1.0f, 1.0f); // Set clear color to white (= selectionSkipColor)
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Needed for clearing the frame buffer
+            glDisable(GL_DITHER); // disable dithering, it may affect colors if enabled
+            foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+                if (baseCache->isVisible()) {
+                    BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
+                    float seriesPos = m_seriesStart + m_seriesStep
+                            * (cache->visualIndex() - (cache->visualIndex()
+                                                       * m_cachedBarSeriesMargin.width())) + 0.5f;
+                    ObjectHelper *barObj = cache->object();
+                    QQuaternion seriesRotation(cache->meshRotation());
+                    const BarRenderItemArray &renderArray = cache->renderArray();
+                    const QList<BarRowBlock> &rowBlocks = cache->rowBlocks(cullingRowBlockSize);
+                    int currentBlock = -1;
+                    Frustum::Containment blockContainment = Frustum::Inside;
+                    for (int row = startRow; row != stopRow; row += stepRow) {
+                        const int block = row / cullingRowBlockSize;
+                        if (block != currentBlock) {
+                            currentBlock = block;
+                            blockContainment = rowBlockContainment(frustum, rowBlocks.at(block),
+                                                                   block, seriesPos,
+                                                                   seriesRotation, 1.0f, 0.0f);
+                        }
+                        if (blockContainment == Frustum::Outside) {
+                            m_frameStatistics.culledItems += m_cachedColumnCount;
                             continue;
+                        }
+                        const BarRenderItemRow &renderRow = renderArray.at(row);
+                        for (int bar = startBar; bar != stopBar; bar += stepBar) {
+                            const BarRenderItem &item = renderRow.at(bar);
+                            if (!item.value())
+                                continue;
+                            if (blockContainment == Frustum::Intersecting
+                                    && !isBarInFrustum(frustum, row, bar, seriesPos, item,
+                                                       seriesRotation, 1.0f, 0.0f)) {
+                                m_frameStatistics.culledItems++;
+                                continue;
+                            }
 
-                        if (item.height() < 0)
-                            glCullFace(GL_FRONT);
-                        else
-                            glCullFace(GL_BACK);
+                            if (item.height() < 0)
+                                glCullFace(GL_FRONT);
+                            else
+                                glCullFace(GL_BACK);
 
-                        QMatrix4x4 modelMatrix;
-                        QMatrix4x4 MVPMatrix;
+                            QMatrix4x4 modelMatrix;
+                            QMatrix4x4 MVPMatrix;
 
-                        colPos = (bar + seriesPos) * (m_cachedBarSpacing.width());
-                        rowPos = (row + 0.5f) * (m_cachedBarSpacing.height());
+                            colPos = (bar + seriesPos) * (m_cachedBarSpacing.width());
+                            rowPos = (row + 0.5f) * (m_cachedBarSpacing.height());
 
-                        modelMatrix.translate((colPos - m_rowWidth) / m_scaleFactor,
-                                              item.height(),
-                                              (m_columnDepth - rowPos) / m_scaleFactor);
-                        if (!seriesRotation.isIdentity() || !item.rotation().isIdentity())
-                            modelMatrix.rotate(seriesRotation * item.rotation());
-                        modelMatrix.scale(QVector3D(m_scaleX * m_seriesScaleX,
-                                                    item.height(),
-                                                    m_scaleZ * m_seriesScaleZ));
+                            modelMatrix.translate((colPos - m_rowWidth) / m_scaleFactor,
+                                                  item.height(),
+                                                  (m_columnDepth - rowPos) / m_scaleFactor);
+                            if (!seriesRotation.isIdentity() || !item.rotation().isIdentity())
+                                modelMatrix.rotate(seriesRotation * item.rotation());
+                            modelMatrix.scale(QVector3D(m_scaleX * m_seriesScaleX,
+                                                        item.height(),
+                                                        m_scaleZ * m_seriesScaleZ));
 
-                        MVPMatrix = projectionViewMatrix * modelMatrix;
+                            MVPMatrix = projectionViewMatrix * modelMatrix;
 
-                        QVector4D barColor = QVector4D(GLfloat(row) / 255.0f,
-                                                       GLfloat(bar) / 255.0f,
-                                                       GLfloat(cache->visualIndex()) / 255.0f,
-                                                       itemAlpha);
+                            QVector4D barColor = QVector4D(GLfloat(row) / 255.0f,
+                                                           GLfloat(bar) / 255.0f,
+                                                           GLfloat(cache->visualIndex()) / 255.0f,
+                                                           itemAlpha);
 
-                        m_selectionShader->setUniformValue(m_selectionShader->MVP(), MVPMatrix);
-                        m_selectionShader->setUniformValue(m_selectionShader->color(), barColor);
+                            m_selectionShader->setUniformValue(m_selectionShader->MVP(), MVPMatrix);
+                            m_selectionShader->setUniformValue(m_selectionShader->color(), barColor);
 
-                        m_drawer->drawSelectionObject(m_selectionShader, barObj);
+                            m_drawer->drawSelectionObject(m_selectionShader, barObj);
+                        }
                     }
                 }
             }
+            glCullFace(GL_BACK);
+            Abstract3DRenderer::drawCustomItems(RenderingSelection, m_selectionShader,
+                                                viewMatrix,
+                                                projectionViewMatrix, depthProjectionViewMatrix,
+                                                m_depthTexture, m_shadowQualityToShader);
+            drawLabels(true, activeCamera, viewMatrix, projectionMatrix);
+            drawBackground(backgroundRotation, depthProjectionViewMatrix, projectionViewMatrix,
+                           viewMatrix, false, true);
+            glEnable(GL_DITHER);
         }
-        glCullFace(GL_BACK);
-        Abstract3DRenderer::drawCustomItems(RenderingSelection, m_selectionShader,
-                                            viewMatrix,
-                                            projectionViewMatrix, depthProjectionViewMatrix,
-                                            m_depthTexture, m_shadowQualityToShader);
-        drawLabels(true, activeCamera, viewMatrix, projectionMatrix);
-        drawBackground(backgroundRotation, depthProjectionViewMatrix, projectionViewMatrix,
-                       viewMatrix, false, true);
-        glEnable(GL_DITHER);
 
         // Read color under cursor
         QVector4D clickedColor = Utils::getSelection(m_inputPosition, m_viewport.height());
@@ -1253,47 +1448,9 @@ void Bars3DRenderer::drawScene(GLuint defaultFboHandle)
     }
 
     if (m_reflectionEnabled) {
-        //
-        // Draw reflections
-        //
-        glDisable(GL_DEPTH_TEST);
-        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-        glEnable(GL_STENCIL_TEST);
-        glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
-        glStencilFunc(GL_ALWAYS, 1, 0xffffffff);
-
-        // Draw background stencil
-        drawBackground(backgroundRotation, depthProjectionViewMatrix, projectionViewMatrix,
-                       viewMatrix);
-
-        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-        glEnable(GL_DEPTH_TEST);
-
-        glStencilFunc(GL_EQUAL, 1, 0xffffffff);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-
-        // Set light
-        QVector3D reflectionLightPos = lightPos;
-        reflectionLightPos.setY(-(lightPos.y()));
-        m_cachedScene->activeLight()->setPosition(reflectionLightPos);
-
-        // Draw bar reflections
-        (void)drawBars(&selectedBar, depthProjectionViewMatrix,
-                       projectionViewMatrix, viewMatrix,
-                       startRow, stopRow, stepRow,
-                       startBar, stopBar, stepBar, -1.0f);
-
-        Abstract3DRenderer::drawCustomItems(RenderingNormal, m_customItemShader,
-                                            viewMatrix, projectionViewMatrix,
-                                            depthProjectionViewMatrix, m_depthTexture,
-                                            m_shadowQualityToShader, -1.0f);
-
-        // Reset light
-        m_cachedScene->activeLight()->setPosition(lightPos);
-
-        glDisable(GL_STENCIL_TEST);
-
-        glCullFace(GL_BACK);
+        drawReflections(backgroundRotation, depthProjectionViewMatrix, projectionViewMatrix,
+                        viewMatrix, startRow, stopRow, stepRow, startBar, stopBar, stepBar,
+                        defaultFboHandle);
     }
 
     //
@@ -1369,6 +1526,137 @@ void Bars3DRenderer::drawScene(GLuint defaultFboHandle)
     m_selectionDirty = false;
 }
 
+void Bars3DRenderer::drawReflections(GLfloat backgroundRotation,
+                                     const QMatrix4x4 &depthProjectionViewMatrix,
+                                     const QMatrix4x4 &projectionViewMatrix,
+                                     const QMatrix4x4 &viewMatrix,
+                                     GLint startRow, GLint stopRow, GLint stepRow,
+                                     GLint startBar, GLint stopBar, GLint stepBar,
+                                     GLuint defaultFboHandle)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector3D lightPos = m_cachedScene->activeLight()->position();
+    QVector3D reflectionLightPos = lightPos;
+    reflectionLightPos.setY(-(lightPos.y()));
+    BarRenderItem *selectedBar = 0;
+
+    // Render the mirrored scene into the reflection texture, unless the texture from the previous
+    // frame still matches it. Falls back to drawing the mirrored bars directly if the texture
+    // cannot be created or has been disabled for comparison.
+    bool useTexture = m_reflectionTextureEnabled && updateReflectionBuffer();
+    if (useTexture && !m_reflectionTextureValid) {
+        glBindFramebuffer(GL_FRAMEBUFFER, m_reflectionFrameBuffer);
+        glViewport(0, 0, m_reflectionTextureSize.width(), m_reflectionTextureSize.height());
+        glEnable(GL_DEPTH_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        m_cachedScene->activeLight()->setPosition(reflectionLightPos);
+        (void)drawBars(&selectedBar, depthProjectionViewMatrix,
+                       projectionViewMatrix, viewMatrix,
+                       startRow, stopRow, stepRow,
+                       startBar, stopBar, stepBar, -1.0f);
+        Abstract3DRenderer::drawCustomItems(RenderingNormal, m_customItemShader,
+                                            viewMatrix, projectionViewMatrix,
+                                            depthProjectionViewMatrix, m_depthTexture,
+                                            m_shadowQualityToShader, -1.0f);
+        m_cachedScene->activeLight()->setPosition(lightPos);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, defaultFboHandle);
+        glViewport(m_primarySubViewport.x(),
+                   m_primarySubViewport.y(),
+                   m_primarySubViewport.width(),
+                   m_primarySubViewport.height());
+
+        m_reflectionTextureValid = true;
+        m_frameStatistics.reflectionPassesRendered++;
+    } else if (useTexture) {
+        m_frameStatistics.reflectionPassesReused++;
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
+    glStencilFunc(GL_ALWAYS, 1, 0xffffffff);
+
+    // Draw background stencil
+    drawBackground(backgroundRotation, depthProjectionViewMatrix, projectionViewMatrix,
+                   viewMatrix);
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    glStencilFunc(GL_EQUAL, 1, 0xffffffff);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+
+    if (useTexture) {
+        // Stretch the reflection texture over the viewport, the stencil clips it to the floor
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_CULL_FACE);
+        m_labelShader->bind();
+        m_labelShader->setUniformValue(m_labelShader->MVP(), QMatrix4x4());
+        m_drawer->drawObject(m_labelShader, m_labelObj, m_reflectionTexture);
+        glEnable(GL_CULL_FACE);
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+    } else {
+        glEnable(GL_DEPTH_TEST);
+
+        // Set light
+        m_cachedScene->activeLight()->setPosition(reflectionLightPos);
+
+        // Draw bar reflections
+        (void)drawBars(&selectedBar, depthProjectionViewMatrix,
+                       projectionViewMatrix, viewMatrix,
+                       startRow, stopRow, stepRow,
+                       startBar, stopBar, stepBar, -1.0f);
+
+        Abstract3DRenderer::drawCustomItems(RenderingNormal, m_customItemShader,
+                                            viewMatrix, projectionViewMatrix,
+                                            depthProjectionViewMatrix, m_depthTexture,
+                                            m_shadowQualityToShader, -1.0f);
+
+        // Reset light
+        m_cachedScene->activeLight()->setPosition(lightPos);
+
+        m_frameStatistics.reflectionPassesRendered++;
+    }
+
+    glDisable(GL_STENCIL_TEST);
+
+    glCullFace(GL_BACK);
+
+    m_frameStatistics.reflectionPassNsecs += timer.nsecsElapsed();
+}
+
+// Creates the reflection texture if needed and returns true if it can be used. The texture is
+// rendered at a fraction of the viewport size; the fainter the reflections, the smaller it is.
+// Its contents stay valid until the camera, data, theme or selection changes.
+bool Bars3DRenderer::updateReflectionBuffer()
+{
+    if (m_frameChanges != Abstract3DController::FrameChangeNone)
+        m_reflectionTextureValid = false;
+
+    int divisor = m_reflectivity < 0.5 ? 2 : 4;
+    QSize size = m_primarySubViewport.size() / divisor;
+    if (size.isEmpty())
+        return false;
+
+    if (!m_reflectionTexture || size != m_reflectionTextureSize) {
+        m_textureHelper->deleteTexture(&m_reflectionTexture);
+        m_reflectionTextureValid = false;
+        m_reflectionTextureSize = size;
+        m_reflectionTexture = m_textureHelper->createSelectionTexture(size,
+                                                                      m_reflectionFrameBuffer,
+                                                                      m_reflectionDepthBuffer);
+    }
+
+    return m_reflectionTexture != 0;
+}
+
 bool Bars3DRenderer::drawBars(BarRenderItem **selectedBar,
                               const QMatrix4x4 &depthProjectionViewMatrix,
                               const QMatrix4x4 &projectionViewMatrix, const QMatrix4x4 &viewMatrix,
@@ -1437,6 +1725,14 @@ bool Bars3DRenderer::drawBars(BarRenderItem **selectedBar,
     QVector3D modelScaler(m_scaleX * m_seriesScaleX, 0.0f, m_scaleZ * m_seriesScaleZ);
     bool somethingSelected =
             (m_visualSelectedBarPos != Bars3DController::invalidSelectionPosition());
+    // Rows of culled blocks are still visited when the selection needs their bars
+    bool visitCulledRows =
+            somethingSelected && m_cachedSelectionMode > QAbstract3DGraph::SelectionNone;
+    const Frustum frustum(projectionViewMatrix);
+    // Bars are drawn front to back, so the bars drawn first can hide the ones drawn later
+    const bool cullOccluded = m_occlusionCulling && reflection == 1.0f;
+    if (cullOccluded)
+        m_occlusionBuffer.reset(projectionViewMatrix, m_primarySubViewport.size());
     foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
         if (baseCache->isVisible()) {
             BarSeriesRenderCache *cache = static_cast<BarSeriesRenderCache *>(baseCache);
@@ -1476,7 +1772,35 @@ bool Bars3DRenderer::drawBars(BarRenderItem **selectedBar,
             }
 
             previousColorStyle = colorStyle;
+            const QList<BarRowBlock> &rowBlocks = cache->rowBlocks(cullingRowBlockSize);
+            int currentBlock = -1;
+            Frustum::Containment blockContainment = Frustum::Inside;
+            bool blockOccluded = false;
             for (int row = startRow; row != stopRow; row += stepRow) {
+                const int block = row / cullingRowBlockSize;
+                if (block != currentBlock) {
+                    currentBlock = block;
+                    blockContainment = rowBlockContainment(frustum, rowBlocks.at(block), block,
+                                                           seriesPos, seriesRotation,
+                                                           reflection, 0.0f);
+                    blockOccluded = false;
+                    if (cullOccluded && blockContainment != Frustum::Outside) {
+                        QVector3D minimum;
+                        QVector3D maximum;
+                        calculateRowBlockBounds(rowBlocks.at(block), block, seriesPos,
+                                                seriesRotation, reflection, 0.0f,
+                                                minimum, maximum);
+                        blockOccluded = m_occlusionBuffer.isOccluded(minimum, maximum);
+                    }
+                }
+                if (blockContainment == Frustum::Outside && !visitCulledRows) {
+                    m_frameStatistics.culledItems += m_cachedColumnCount;
+                    continue;
+                }
+                if (blockOccluded && !visitCulledRows) {
+                    m_frameStatistics.occludedItems += m_cachedColumnCount;
+                    continue;
+                }
                 BarRenderItemRow &renderRow = renderArray[row];
                 for (int bar = startBar; bar != stopBar; bar += stepBar) {
                     BarRenderItem &item = renderRow[bar];
@@ -1621,6 +1945,17 @@ bool Bars3DRenderer::drawBars(BarRenderItem **selectedBar,
 
                     if (item.height() == 0) {
                         continue;
+                    } else if (blockContainment == Frustum::Outside
+                               || (blockContainment == Frustum::Intersecting
+                                   && !isBarInFrustum(frustum, row, bar, seriesPos, item,
+                                                      seriesRotation, reflection, 0.0f))) {
+                        m_frameStatistics.culledItems++;
+                        continue;
+                    } else if (blockOccluded
+                               || (cullOccluded && isBarOccluded(row, bar, seriesPos, item,
+                                                                 seriesRotation))) {
+                        m_frameStatistics.occludedItems++;
+                        continue;
                     } else if ((m_reflectionEnabled
                                 && (reflection == 1.0f
                                     || (reflection != 1.0f
@@ -1668,6 +2003,9 @@ bool Bars3DRenderer::drawBars(BarRenderItem **selectedBar,
                             // Draw the object
                             m_drawer->drawObject(barShader, barObj, gradientTexture);
                         }
+
+                        if (cullOccluded)
+                            addBarOccluder(cache, row, bar, seriesPos, item, seriesRotation);
                     }
                 }
             }
@@ -2461,6 +2799,17 @@ void Bars3DRenderer::updateBarSeriesMargin(const QSizeF &margin)
     calculateSceneScalingFactors();
 }
 
+void Bars3DRenderer::updateOcclusionCulling(bool enable)
+{
+    m_occlusionCulling = enable;
+}
+
+void Bars3DRenderer::updateReflectionTextureEnabled(bool enable)
+{
+    m_reflectionTextureEnabled = enable;
+    m_reflectionTextureValid = false;
+}
+
 void Bars3DRenderer::updateAxisRange(QAbstract3DAxis::AxisOrientation orientation, float min,
                                      float max)
 {
@@ -2666,6 +3015,141 @@ void Bars3DRenderer::calculateSeriesStartPosition()
             * (m_seriesStep - (m_seriesStep * m_cachedBarSeriesMargin.width()));
 }
 
+// Bars span the [-1, 1] mesh scaled by the bar scaler and their height. Rotations around the
+// up axis widen the bars horizontally, other rotations are bounded by a sphere.
+void Bars3DRenderer::calculateBarBounds(int firstRow, int lastRow, int firstBar, int lastBar,
+                                        float seriesPos, float minHeight, float maxHeight,
+                                        const QQuaternion &seriesRotation, bool itemsRotated,
+                                        float margin, QVector3D &minimum,
+                                        QVector3D &maximum) const
+{
+    const float minX = ((firstBar + seriesPos) * m_cachedBarSpacing.width() - m_rowWidth)
+            / m_scaleFactor;
+    const float maxX = ((lastBar + seriesPos) * m_cachedBarSpacing.width() - m_rowWidth)
+            / m_scaleFactor;
+    const float minZ = (m_columnDepth - (lastRow + 0.5f) * m_cachedBarSpacing.height())
+            / m_scaleFactor;
+    const float maxZ = (m_columnDepth - (firstRow + 0.5f) * m_cachedBarSpacing.height())
+            / m_scaleFactor;
+    QVector3D scaler(m_scaleX * m_seriesScaleX, 0.0f, m_scaleZ * m_seriesScaleZ);
+
+    if (!qFuzzyIsNull(seriesRotation.x()) || !qFuzzyIsNull(seriesRotation.z())) {
+        scaler.setY(qMax(qAbs(minHeight), qAbs(maxHeight)));
+        const float radius = scaler.length() + margin;
+        minimum = QVector3D(minX - radius, minHeight - radius, minZ - radius);
+        maximum = QVector3D(maxX + radius, maxHeight + radius, maxZ + radius);
+        return;
+    }
+
+    if (itemsRotated || !seriesRotation.isIdentity()) {
+        const float radius = qSqrt(scaler.x() * scaler.x() + scaler.z() * scaler.z());
+        scaler.setX(radius);
+        scaler.setZ(radius);
+    }
+    minimum = QVector3D(minX - scaler.x() - margin, qMin(0.0f, 2.0f * minHeight) - margin,
+                        minZ - scaler.z() - margin);
+    maximum = QVector3D(maxX + scaler.x() + margin, qMax(0.0f, 2.0f * maxHeight) + margin,
+                        maxZ + scaler.z() + margin);
+}
+
+void Bars3DRenderer::calculateRowBlockBounds(const BarRowBlock &rowBlock, int block,
+                                             float seriesPos, const QQuaternion &seriesRotation,
+                                             float reflection, float margin,
+                                             QVector3D &minimum, QVector3D &maximum) const
+{
+    float minHeight = rowBlock.minHeight;
+    float maxHeight = rowBlock.maxHeight;
+    if (reflection < 0.0f) {
+        minHeight = -rowBlock.maxHeight;
+        maxHeight = -rowBlock.minHeight;
+    }
+
+    calculateBarBounds(block * cullingRowBlockSize,
+                       qMin((block + 1) * cullingRowBlockSize, m_cachedRowCount) - 1,
+                       0, m_cachedColumnCount - 1, seriesPos, minHeight, maxHeight,
+                       seriesRotation, rowBlock.rotated, margin, minimum, maximum);
+}
+
+Frustum::Containment Bars3DRenderer::rowBlockContainment(const Frustum &frustum,
+                                                         const BarRowBlock &rowBlock, int block,
+                                                         float seriesPos,
+                                                         const QQuaternion &seriesRotation,
+                                                         float reflection, float margin) const
+{
+    QVector3D minimum;
+    QVector3D maximum;
+    calculateRowBlockBounds(rowBlock, block, seriesPos, seriesRotation, reflection, margin,
+                            minimum, maximum);
+    return frustum.containsBox(minimum, maximum);
+}
+
+bool Bars3DRenderer::isBarInFrustum(const Frustum &frustum, int row, int bar, float seriesPos,
+                                    const BarRenderItem &item,
+                                    const QQuaternion &seriesRotation, float reflection,
+                                    float margin) const
+{
+    const float height = reflection * item.height();
+    QVector3D minimum;
+    QVector3D maximum;
+    calculateBarBounds(row, row, bar, bar, seriesPos, height, height, seriesRotation,
+                       !item.rotation().isIdentity(), margin, minimum, maximum);
+    return frustum.intersectsBox(minimum, maximum);
+}
+
+bool Bars3DRenderer::isBarOccluded(int row, int bar, float seriesPos, const BarRenderItem &item,
+                                   const QQuaternion &seriesRotation) const
+{
+    QVector3D minimum;
+    QVector3D maximum;
+    calculateBarBounds(row, row, bar, bar, seriesPos, item.height(), item.height(),
+                       seriesRotation, !item.rotation().isIdentity(), 0.0f, minimum, maximum);
+    return m_occlusionBuffer.isOccluded(minimum, maximum);
+}
+
+// Occluders must not extend past the bar mesh, so only the solid core of the mesh is added
+void Bars3DRenderer::addBarOccluder(const BarSeriesRenderCache *cache, int row, int bar,
+                                    float seriesPos, const BarRenderItem &item,
+                                    const QQuaternion &seriesRotation)
+{
+    if (!qFuzzyIsNull(seriesRotation.x()) || !qFuzzyIsNull(seriesRotation.z()))
+        return;
+
+    float coreScale;
+    switch (cache->mesh()) {
+    case QAbstract3DSeries::MeshBar:
+    case QAbstract3DSeries::MeshCube:
+        coreScale = 1.0f;
+        break;
+    case QAbstract3DSeries::MeshBevelBar:
+    case QAbstract3DSeries::MeshBevelCube:
+        coreScale = 0.8f;
+        break;
+    case QAbstract3DSeries::MeshCylinder:
+        // Square inside the circular cross section
+        coreScale = 0.7071f;
+        break;
+    default:
+        return;
+    }
+
+    float halfX = m_scaleX * m_seriesScaleX * coreScale;
+    float halfZ = m_scaleZ * m_seriesScaleZ * coreScale;
+    if (!seriesRotation.isIdentity() || !item.rotation().isIdentity()) {
+        // Square inside the circle inscribed in the rotated cross section
+        halfX = 0.7071f * qMin(halfX, halfZ);
+        halfZ = halfX;
+    }
+    const float halfY = qAbs(item.height()) * (cache->mesh() == QAbstract3DSeries::MeshCylinder
+                                                ? 1.0f : coreScale);
+    const QVector3D center(((bar + seriesPos) * m_cachedBarSpacing.width() - m_rowWidth)
+                           / m_scaleFactor,
+                           item.height(),
+                           (m_columnDepth - (row + 0.5f) * m_cachedBarSpacing.height())
+                           / m_scaleFactor);
+    const QVector3D halfSize(halfX, halfY, halfZ);
+    m_occlusionBuffer.addOccluder(center - halfSize, center + halfSize);
+}
+
 Bars3DController::SelectionType Bars3DRenderer::isSelected(int row, int bar,
                                                            const BarSeriesRenderCache *cache)
 {
@@ -2797,6 +3281,7 @@ void Bars3DRenderer::initSelectionShader()
 void Bars3DRenderer::initSelectionBuffer()
 {
     m_textureHelper->deleteTexture(&m_selectionTexture);
+    m_selectionBufferValid = false;
 
     if (m_cachedIsSlicingActivated || m_primarySubViewport.size().isEmpty())
         return;
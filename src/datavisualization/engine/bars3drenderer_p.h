@@ -18,6 +18,10 @@
 #include "bars3dcontroller_p.h"
 #include "abstract3drenderer_p.h"
 #include "barrenderitem_p.h"
+#include "frustum_p.h"
+#include "occlusionbuffer_p.h"
+
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 class QPoint;
@@ -30,6 +34,25 @@ class ShaderHelper;
 class LabelItem;
 class Q3DScene;
 class BarSeriesRenderCache;
+struct BarRowBlock;
+
+// Mapping of bar values to heights, resolved from the value axis once per update, so that rows
+// of values can be mapped in tight loops and on several threads. Only linear axes are mapped in
+// vectorizable loops, logarithmic axes call std::log for each value.
+struct BarHeightMapping
+{
+    // Custom formatters are called for each value instead
+    const QValue3DAxisFormatter *customFormatter = 0;
+    bool logarithmic = false;
+    float axisMin = 0.0f;
+    float axisRange = 1.0f;
+    float offset = 0.0f;
+    float lowerBound = -std::numeric_limits<float>::infinity();
+    float upperBound = std::numeric_limits<float>::infinity();
+    float sign = 1.0f;
+
+    void map(const float *values, float *heights, int count) const;
+};
 
 class Q_DATAVISUALIZATION_EXPORT Bars3DRenderer : public Abstract3DRenderer
 {
@@ -59,6 +82,12 @@ private:
     GLuint m_depthFrameBuffer;
     GLuint m_selectionFrameBuffer;
     GLuint m_selectionDepthBuffer;
+    GLuint m_reflectionTexture;
+    GLuint m_reflectionFrameBuffer;
+    GLuint m_reflectionDepthBuffer;
+    QSize m_reflectionTextureSize;
+    bool m_reflectionTextureValid;
+    bool m_reflectionTextureEnabled;
     GLfloat m_shadowQualityToShader;
     GLint m_shadowQualityMultiplier;
     GLfloat m_heightNormalizer;
@@ -89,6 +118,13 @@ private:
     float m_zScaleFactor;
     float m_floorLevel;
     float m_actualFloorLevel;
+    bool m_occlusionCulling;
+    OcclusionBuffer m_occlusionBuffer;
+
+    // Data updates waiting for applyDataUpdates()
+    bool m_dataSnapshotPending;
+    QList<Bars3DController::ChangeRow> m_pendingRows;
+    QList<Bars3DController::ChangeItem> m_pendingItems;
 
 public:
     explicit Bars3DRenderer(Bars3DController *controller);
@@ -113,6 +149,7 @@ protected:
     void initializeOpenGL() override;
     void fixCameraTarget(QVector3D &target) override;
     void getVisibleItemBounds(QVector3D &minBounds, QVector3D &maxBounds) override;
+    void applyDataUpdates() override;
 
 public Q_SLOTS:
     void updateMultiSeriesScaling(bool uniform);
@@ -120,6 +157,8 @@ public Q_SLOTS:
                         const QSizeF &spacing = QSizeF(1.0, 1.0),
                         bool relative = true);
     void updateBarSeriesMargin(const QSizeF &margin);
+    void updateOcclusionCulling(bool enable);
+    void updateReflectionTextureEnabled(bool enable);
     void updateSlicingActive(bool isSlicing);
     void updateSelectedBar(const QPoint &position, QBar3DSeries *series);
     inline QPoint clickedPosition() const { return m_clickedPosition; }
@@ -158,18 +197,48 @@ private:
     void initSelectionShader();
     void initBackgroundShaders(const QString &vertexShader, const QString &fragmentShader) override;
     void initSelectionBuffer() override;
+    bool updateReflectionBuffer();
+    void drawReflections(GLfloat backgroundRotation, const QMatrix4x4 &depthProjectionViewMatrix,
+                         const QMatrix4x4 &projectionViewMatrix, const QMatrix4x4 &viewMatrix,
+                         GLint startRow, GLint stopRow, GLint stepRow,
+                         GLint startBar, GLint stopBar, GLint stepBar, GLuint defaultFboHandle);
     void initDepthShader();
     void updateDepthBuffer() override;
     void calculateSceneScalingFactors();
     void calculateHeightAdjustment();
     void calculateSeriesStartPosition();
+    void calculateBarBounds(int firstRow, int lastRow, int firstBar, int lastBar,
+                            float seriesPos, float minHeight, float maxHeight,
+                            const QQuaternion &seriesRotation, bool itemsRotated, float margin,
+                            QVector3D &minimum, QVector3D &maximum) const;
+    void calculateRowBlockBounds(const BarRowBlock &rowBlock, int block, float seriesPos,
+                                 const QQuaternion &seriesRotation, float reflection,
+                                 float margin, QVector3D &minimum, QVector3D &maximum) const;
+    Frustum::Containment rowBlockContainment(const Frustum &frustum, const BarRowBlock &rowBlock,
+                                             int block, float seriesPos,
+                                             const QQuaternion &seriesRotation,
+                                             float reflection, float margin) const;
+    bool isBarInFrustum(const Frustum &frustum, int row, int bar, float seriesPos,
+                        const BarRenderItem &item, const QQuaternion &seriesRotation,
+                        float reflection, float margin) const;
+    bool isBarOccluded(int row, int bar, float seriesPos, const BarRenderItem &item,
+                       const QQuaternion &seriesRotation) const;
+    void addBarOccluder(const BarSeriesRenderCache *cache, int row, int bar, float seriesPos,
+                        const BarRenderItem &item, const QQuaternion &seriesRotation);
     Abstract3DController::SelectionType isSelected(int row, int bar,
                                                    const BarSeriesRenderCache *cache);
     QPoint selectionColorToArrayPosition(const QVector4D &selectionColor);
     QBar3DSeries *selectionColorToSeries(const QVector4D &selectionColor);
 
-    inline void updateRenderRow(const QBarDataRow *dataRow, BarRenderItemRow &renderRow);
-    inline void updateRenderItem(const QBarDataItem &dataItem, BarRenderItem &renderItem);
+    void applyData();
+    void applyRows(const QList<Bars3DController::ChangeRow> &rows);
+    void applyItems(const QList<Bars3DController::ChangeItem> &items);
+    void takeDataSnapshot(QBar3DSeries *series);
+    BarHeightMapping heightMapping() const;
+    void updateRenderRow(const QBarDataRow *dataRow, BarRenderItemRow &renderRow,
+                         const BarHeightMapping &mapping) const;
+    void updateRenderItem(const QBarDataItem &dataItem, BarRenderItem &renderItem,
+                          const BarHeightMapping &mapping) const;
 
     Q_DISABLE_COPY(Bars3DRenderer)
 };
@@ -8,7 +8,10 @@ QT_BEGIN_NAMESPACE
 BarSeriesRenderCache::BarSeriesRenderCache(QAbstract3DSeries *series,
                                            Abstract3DRenderer *renderer)
     : SeriesRenderCache(series, renderer),
-      m_visualIndex(-1)
+      m_visualIndex(-1),
+      m_hasDataSnapshot(false),
+      m_rowBlockSize(0),
+      m_rowBlocksDirty(true)
 {
 }
 
@@ -20,8 +23,59 @@ void BarSeriesRenderCache::cleanup(TextureHelper *texHelper)
 {
     m_renderArray.clear();
     m_sliceArray.clear();
+    m_rowBlocks.clear();
+    m_rowBlocksDirty = true;
+    releaseDataSnapshot();
 
     SeriesRenderCache::cleanup(texHelper);
 }
 
+void BarSeriesRenderCache::takeDataSnapshot()
+{
+    if (m_hasDataSnapshot)
+        return;
+
+    // Rows are implicitly shared, so this does not copy the items. Any later change made to
+    // the proxy rows detaches them from the snapshot.
+    const QBarDataArray &array = *series()->dataProxy()->array();
+    m_dataSnapshot.reserve(array.size());
+    for (const QBarDataRow *row : array)
+        m_dataSnapshot.append(row ? new QBarDataRow(*row) : 0);
+    m_hasDataSnapshot = true;
+}
+
+void BarSeriesRenderCache::releaseDataSnapshot()
+{
+    qDeleteAll(m_dataSnapshot);
+    m_dataSnapshot.clear();
+    m_hasDataSnapshot = false;
+}
+
+const QList<BarRowBlock> &BarSeriesRenderCache::rowBlocks(int rowBlockSize)
+{
+    if (!m_rowBlocksDirty && rowBlockSize == m_rowBlockSize)
+        return m_rowBlocks;
+
+    const int rowCount = m_renderArray.size();
+    m_rowBlocks.resize((rowCount + rowBlockSize - 1) / rowBlockSize);
+    for (int block = 0; block < m_rowBlocks.size(); block++) {
+        BarRowBlock &rowBlock = m_rowBlocks[block];
+        rowBlock.minHeight = 0.0f;
+        rowBlock.maxHeight = 0.0f;
+        rowBlock.rotated = false;
+        const int stopRow = qMin((block + 1) * rowBlockSize, rowCount);
+        for (int row = block * rowBlockSize; row < stopRow; row++) {
+            for (const BarRenderItem &item : m_renderArray.at(row)) {
+                rowBlock.minHeight = qMin(rowBlock.minHeight, item.height());
+                rowBlock.maxHeight = qMax(rowBlock.maxHeight, item.height());
+                if (!item.rotation().isIdentity())
+                    rowBlock.rotated = true;
+            }
+        }
+    }
+    m_rowBlockSize = rowBlockSize;
+    m_rowBlocksDirty = false;
+    return m_rowBlocks;
+}
+
 QT_END_NAMESPACE
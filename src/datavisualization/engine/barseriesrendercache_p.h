@@ -21,6 +21,13 @@
 
 QT_BEGIN_NAMESPACE
 
+// Height range of the bars in a block of rows, and whether any of them is rotated
+struct BarRowBlock {
+    float minHeight;
+    float maxHeight;
+    bool rotated;
+};
+
 class BarSeriesRenderCache : public SeriesRenderCache
 {
 public:
@@ -35,10 +42,25 @@ public:
     inline void setVisualIndex(int index) { m_visualIndex = index; }
     inline int visualIndex() {return m_visualIndex; }
 
+    void takeDataSnapshot();
+    void releaseDataSnapshot();
+    inline bool hasDataSnapshot() const { return m_hasDataSnapshot; }
+    inline const QBarDataArray &dataSnapshot() const { return m_dataSnapshot; }
+
+    // Blocks of rowBlockSize rows used for culling whole blocks at a time. They are
+    // recalculated on first use after the render array has changed.
+    const QList<BarRowBlock> &rowBlocks(int rowBlockSize);
+    inline void setRowBlocksDirty() { m_rowBlocksDirty = true; }
+
 protected:
     BarRenderItemArray m_renderArray;
     QList<BarRenderSliceItem> m_sliceArray;
     int m_visualIndex; // order of the series is relevant
+    QBarDataArray m_dataSnapshot; // Owns the rows, which share the data with the proxy rows
+    bool m_hasDataSnapshot;
+    QList<BarRowBlock> m_rowBlocks;
+    int m_rowBlockSize;
+    bool m_rowBlocksDirty;
 };
 
 QT_END_NAMESPACE
@@ -10,6 +10,7 @@
 #include "scatterpointbufferhelper_p.h"
 
 #include <QtGui/QMatrix4x4>
+#include <QtOpenGL/QOpenGLVertexArrayObject>
 #include <QtCore/qmath.h>
 
 // Resources need to be explicitly initialized when building as static library
@@ -40,13 +41,18 @@ Drawer::Drawer(Q3DTheme *theme)
       m_textureHelper(0),
       m_pointbuffer(0),
       m_linebuffer(0),
-      m_scaledFontSize(0.0f)
+      m_pointVertexArray(nullptr),
+      m_lineVertexArray(nullptr),
+      m_scaledFontSize(0.0f),
+      m_drawCalls(0)
 {
 }
 
 Drawer::~Drawer()
 {
     delete m_textureHelper;
+    delete m_pointVertexArray;
+    delete m_lineVertexArray;
     if (QOpenGLContext::currentContext()) {
         glDeleteBuffers(1, &m_pointbuffer);
         glDeleteBuffers(1, &m_linebuffer);
@@ -56,10 +62,22 @@ Drawer::~Drawer()
 void Drawer::initializeOpenGL()
 {
     initializeOpenGLFunctions();
+    m_state.initializeOpenGL();
     if (!m_textureHelper)
         m_textureHelper = new TextureHelper();
 }
 
+void Drawer::beginFrame()
+{
+    // Anything may have happened to the GL state between frames
+    m_state.invalidate();
+}
+
+void Drawer::endFrame()
+{
+    m_state.release();
+}
+
 void Drawer::setTheme(Q3DTheme *theme)
 {
     m_theme = theme;
@@ -85,53 +103,41 @@ void Drawer::drawObject(ShaderHelper *shader, AbstractObjectHelper *object, GLui
 #endif
     if (textureId) {
         // Activate texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureId);
+        m_state.bindTexture(0, GL_TEXTURE_2D, textureId);
         shader->setUniformValue(shader->texture(), 0);
     }
 
     if (depthTextureId) {
         // Activate depth texture
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, depthTextureId);
+        m_state.bindTexture(1, GL_TEXTURE_2D, depthTextureId);
         shader->setUniformValue(shader->shadow(), 1);
     }
 #if !QT_CONFIG(opengles2)
     if (textureId3D) {
         // Activate texture
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_3D, textureId3D);
+        m_state.bindTexture(2, GL_TEXTURE_3D, textureId3D);
         shader->setUniformValue(shader->texture(), 2);
     }
 #endif
 
-    // 1st attribute buffer : vertices
-    glEnableVertexAttribArray(shader->posAtt());
-    glBindBuffer(GL_ARRAY_BUFFER, object->vertexBuf());
-    glVertexAttribPointer(shader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    m_drawCalls++;
 
-    // 2nd attribute buffer : normals
-    if (shader->normalAtt() >= 0) {
-        glEnableVertexAttribArray(shader->normalAtt());
-        glBindBuffer(GL_ARRAY_BUFFER, object->normalBuf());
-        glVertexAttribPointer(shader->normalAtt(), 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    QOpenGLVertexArrayObject *vertexArray = object->vertexArray();
+    if (vertexArray) {
+        m_state.bindVertexArray(vertexArray);
+        drawElements(object, true);
+        return;
     }
 
-    // 3rd attribute buffer : UVs
-    if (shader->uvAtt() >= 0) {
-        glEnableVertexAttribArray(shader->uvAtt());
-        glBindBuffer(GL_ARRAY_BUFFER, object->uvBuf());
-        glVertexAttribPointer(shader->uvAtt(), 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    }
+    m_state.bindVertexArray(nullptr);
 
-    // Index buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->elementBuf());
+    // Attribute buffers : vertices, normals and UVs
+    object->setupAttributes(shader->posAtt(), shader->normalAtt(), shader->uvAtt());
 
     // Draw the triangles
-    glDrawElements(GL_TRIANGLES, object->indexCount(), GL_UNSIGNED_INT, (void*)0);
+    drawElements(object, false);
 
     // Free buffers
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     if (shader->uvAtt() >= 0)
@@ -139,55 +145,63 @@ void Drawer::drawObject(ShaderHelper *shader, AbstractObjectHelper *object, GLui
     if (shader->normalAtt() >= 0)
         glDisableVertexAttribArray(shader->normalAtt());
     glDisableVertexAttribArray(shader->posAtt());
-
-    // Release textures
-#if !QT_CONFIG(opengles2)
-    if (textureId3D) {
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_3D, 0);
-    }
-#endif
-    if (depthTextureId) {
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-    if (textureId) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
 }
 
 void Drawer::drawSelectionObject(ShaderHelper *shader, AbstractObjectHelper *object)
 {
-    glEnableVertexAttribArray(shader->posAtt());
-    glBindBuffer(GL_ARRAY_BUFFER, object->vertexBuf());
-    glVertexAttribPointer(shader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0, (void *)0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->elementBuf());
-    glDrawElements(GL_TRIANGLES, object->indexCount(), GL_UNSIGNED_INT, (void *)0);
+    m_drawCalls++;
+
+    QOpenGLVertexArrayObject *vertexArray = object->vertexArray();
+    if (vertexArray) {
+        m_state.bindVertexArray(vertexArray);
+        drawElements(object, true);
+        return;
+    }
+
+    m_state.bindVertexArray(nullptr);
+    object->setupAttributes(shader->posAtt(), -1, -1);
+    drawElements(object, false);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(shader->posAtt());
 }
 
+void Drawer::drawElements(AbstractObjectHelper *object, bool vertexArrayBound)
+{
+    if (!object->isLevelOfDetailActive()) {
+        if (!vertexArrayBound)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->elementBuf());
+        glDrawElements(GL_TRIANGLES, object->indexCount(), object->indexType(), (void *)0);
+        return;
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->lodElementBuf());
+    glDrawElements(GL_TRIANGLES, object->lodIndexCount(), object->lodIndexType(), (void *)0);
+    // The element buffer binding is part of the vertex array state
+    if (vertexArrayBound)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->elementBuf());
+}
+
 void Drawer::drawSurfaceGrid(ShaderHelper *shader, SurfaceObject *object)
 {
     // Get grid line color
     QVector4D lineColor = Utils::vectorFromColor(object->wireframeColor());
     shader->setUniformValue(shader->color(), lineColor);
 
+    m_drawCalls++;
+
+    // The grid uses its own index buffer, so it cannot use the vertex array of the surface
+    m_state.bindVertexArray(nullptr);
+
     // 1st attribute buffer : vertices
-    glEnableVertexAttribArray(shader->posAtt());
-    glBindBuffer(GL_ARRAY_BUFFER, object->vertexBuf());
-    glVertexAttribPointer(shader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    object->setupAttributes(shader->posAtt(), -1, -1);
 
     // Index buffer
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->gridElementBuf());
 
     // Draw the lines
-    glDrawElements(GL_LINES, object->gridIndexCount(), GL_UNSIGNED_INT, (void*)0);
+    glDrawElements(GL_LINES, object->gridIndexCount(), object->gridIndexType(), (void*)0);
 
     // Free buffers
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     glDisableVertexAttribArray(shader->posAtt());
@@ -202,8 +216,19 @@ void Drawer::drawPoint(ShaderHelper *shader)
         glGenBuffers(1, &m_pointbuffer);
         glBindBuffer(GL_ARRAY_BUFFER, m_pointbuffer);
         glBufferData(GL_ARRAY_BUFFER, sizeof(point_data), point_data, GL_STATIC_DRAW);
+        m_pointVertexArray = createPositionVertexArray(m_pointbuffer);
     }
 
+    m_drawCalls++;
+
+    if (m_pointVertexArray) {
+        m_state.bindVertexArray(m_pointVertexArray);
+        glDrawArrays(GL_POINTS, 0, 1);
+        return;
+    }
+
+    m_state.bindVertexArray(nullptr);
+
     // 1st attribute buffer : vertices
     glEnableVertexAttribArray(shader->posAtt());
     glBindBuffer(GL_ARRAY_BUFFER, m_pointbuffer);
@@ -222,23 +247,20 @@ void Drawer::drawPoints(ShaderHelper *shader, ScatterPointBufferHelper *object,
 {
     if (textureId) {
         // Activate texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureId);
+        m_state.bindTexture(0, GL_TEXTURE_2D, textureId);
         shader->setUniformValue(shader->texture(), 0);
     }
 
-    // 1st attribute buffer : vertices
+    m_drawCalls++;
+
+    // Point buffers are updated in place too often to be worth a vertex array
+    m_state.bindVertexArray(nullptr);
+
+    // 1st attribute buffer : data positions, mapped to the axes in the vertex shader
     glEnableVertexAttribArray(shader->posAtt());
     glBindBuffer(GL_ARRAY_BUFFER, object->pointBuf());
     glVertexAttribPointer(shader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
 
-    // 2nd attribute buffer : UVs
-    if (textureId) {
-        glEnableVertexAttribArray(shader->uvAtt());
-        glBindBuffer(GL_ARRAY_BUFFER, object->uvBuf());
-        glVertexAttribPointer(shader->uvAtt(), 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    }
-
     // Draw the points
     glDrawArrays(GL_POINTS, 0, object->indexCount());
 
@@ -246,12 +268,6 @@ void Drawer::drawPoints(ShaderHelper *shader, ScatterPointBufferHelper *object,
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     glDisableVertexAttribArray(shader->posAtt());
-
-    if (textureId) {
-        glDisableVertexAttribArray(shader->uvAtt());
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
 }
 
 void Drawer::drawLine(ShaderHelper *shader)
@@ -263,8 +279,19 @@ void Drawer::drawLine(ShaderHelper *shader)
         glGenBuffers(1, &m_linebuffer);
         glBindBuffer(GL_ARRAY_BUFFER, m_linebuffer);
         glBufferData(GL_ARRAY_BUFFER, sizeof(line_data), line_data, GL_STATIC_DRAW);
+        m_lineVertexArray = createPositionVertexArray(m_linebuffer);
+    }
+
+    m_drawCalls++;
+
+    if (m_lineVertexArray) {
+        m_state.bindVertexArray(m_lineVertexArray);
+        glDrawArrays(GL_LINES, 0, 2);
+        return;
     }
 
+    m_state.bindVertexArray(nullptr);
+
     // 1st attribute buffer : vertices
     glEnableVertexAttribArray(shader->posAtt());
     glBindBuffer(GL_ARRAY_BUFFER, m_linebuffer);
@@ -400,6 +427,23 @@ void Drawer::drawLabel(const AbstractRenderItem &item, const LabelItem &labelIte
     }
 }
 
+// Returns null if vertex array objects are not supported
+QOpenGLVertexArrayObject *Drawer::createPositionVertexArray(GLuint buffer)
+{
+    QOpenGLVertexArrayObject *vertexArray = new QOpenGLVertexArrayObject;
+    if (!vertexArray->create()) {
+        delete vertexArray;
+        return nullptr;
+    }
+
+    m_state.bindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glEnableVertexAttribArray(ShaderHelper::PositionAttribute);
+    glVertexAttribPointer(ShaderHelper::PositionAttribute, 3, GL_FLOAT, GL_FALSE, 0, (void *)0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return vertexArray;
+}
+
 void Drawer::generateSelectionLabelTexture(Abstract3DRenderer *renderer)
 {
     LabelItem &labelItem = renderer->selectionLabelItem();
@@ -17,6 +17,7 @@
 #include <private/datavisualizationglobal_p.h>
 #include <private/labelitem_p.h>
 #include <private/abstractrenderitem_p.h>
+#include <private/glstatecache_p.h>
 
 #include <QtDataVisualization/q3dbars.h>
 #include <QtDataVisualization/q3dtheme.h>
@@ -55,6 +56,12 @@ public:
 
     void initializeOpenGL();
 
+    // Bindings are kept across draws within a frame and released at the end of it
+    void beginFrame();
+    void endFrame();
+    inline quint64 drawCalls() const { return m_drawCalls; }
+    inline quint64 bindsElided() const { return m_state.bindsElided(); }
+
     void setTheme(Q3DTheme *theme);
     Q3DTheme *theme() const;
     QFont font() const;
@@ -83,11 +90,18 @@ Q_SIGNALS:
     void drawerChanged();
 
 private:
+    QOpenGLVertexArrayObject *createPositionVertexArray(GLuint buffer);
+    void drawElements(AbstractObjectHelper *object, bool vertexArrayBound);
+
     Q3DTheme *m_theme;
     TextureHelper *m_textureHelper;
     GLuint m_pointbuffer;
     GLuint m_linebuffer;
+    QOpenGLVertexArrayObject *m_pointVertexArray;
+    QOpenGLVertexArrayObject *m_lineVertexArray;
     GLfloat m_scaledFontSize;
+    GLStateCache m_state;
+    quint64 m_drawCalls;
 };
 
 QT_END_NAMESPACE
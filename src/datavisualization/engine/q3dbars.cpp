@@ -397,6 +397,35 @@ float Q3DBars::floorLevel() const
     return dptrc()->m_shared->floorLevel();
 }
 
+/*!
+ * \property Q3DBars::occlusionCulling
+ * \since 6.10
+ *
+ * \brief Whether bars hidden behind bars closer to the camera are skipped
+ * when drawing.
+ *
+ * Bars are drawn from front to back, and the solid parts of the drawn bars are
+ * recorded into a coarse depth buffer on the CPU. Bars that are completely
+ * behind the recorded bars are not drawn. This reduces drawing considerably
+ * for large bar graphs viewed from low camera angles, where the front rows hide
+ * most of the graph, but adds processing for each bar. Only the main pass is
+ * affected, so shadows and reflections are unchanged.
+ *
+ * Defaults to \c{false}.
+ */
+void Q3DBars::setOcclusionCulling(bool enable)
+{
+    if (enable != isOcclusionCulling()) {
+        dptr()->m_shared->setOcclusionCulling(enable);
+        emit occlusionCullingChanged(enable);
+    }
+}
+
+bool Q3DBars::isOcclusionCulling() const
+{
+    return dptrc()->m_shared->isOcclusionCulling();
+}
+
 /*!
  * Adds \a axis to the graph. The axes added via addAxis are not yet taken to use,
  * addAxis is simply used to give the ownership of the \a axis to the graph.
@@ -27,6 +27,7 @@ class Q_DATAVISUALIZATION_EXPORT Q3DBars : public QAbstract3DGraph
     Q_PROPERTY(QBar3DSeries *primarySeries READ primarySeries WRITE setPrimarySeries NOTIFY primarySeriesChanged)
     Q_PROPERTY(QBar3DSeries *selectedSeries READ selectedSeries NOTIFY selectedSeriesChanged)
     Q_PROPERTY(float floorLevel READ floorLevel WRITE setFloorLevel NOTIFY floorLevelChanged)
+    Q_PROPERTY(bool occlusionCulling READ isOcclusionCulling WRITE setOcclusionCulling NOTIFY occlusionCullingChanged REVISION(6, 10))
 
 public:
     explicit Q3DBars(const QSurfaceFormat *format = nullptr, QWindow *parent = nullptr);
@@ -67,6 +68,8 @@ public:
     QBar3DSeries *selectedSeries() const;
     void setFloorLevel(float level);
     float floorLevel() const;
+    void setOcclusionCulling(bool enable);
+    bool isOcclusionCulling() const;
 
 Q_SIGNALS:
     void multiSeriesUniformChanged(bool uniform);
@@ -80,6 +83,7 @@ Q_SIGNALS:
     void primarySeriesChanged(QBar3DSeries *series);
     void selectedSeriesChanged(QBar3DSeries *series);
     void floorLevelChanged(float level);
+    Q_REVISION(6, 10) void occlusionCullingChanged(bool enable);
 
 private:
     Q3DBarsPrivate *dptr();
@@ -797,6 +797,23 @@ void Q3DScenePrivate::markDirty()
     emit needRender();
 }
 
+// Returns true if pending changes affect the rendered view, as opposed to only carrying new
+// selection or graph position queries.
+bool Q3DScenePrivate::isViewDirty() const
+{
+    return m_changeTracker.windowSizeChanged
+            || m_changeTracker.viewportChanged
+            || m_changeTracker.subViewportOrderChanged
+            || m_changeTracker.primarySubViewportChanged
+            || m_changeTracker.secondarySubViewportChanged
+            || m_changeTracker.cameraChanged
+            || m_changeTracker.lightChanged
+            || m_changeTracker.slicingActivatedChanged
+            || m_changeTracker.devicePixelRatioChanged
+            || m_camera->isDirty()
+            || m_light->isDirty();
+}
+
 bool Q3DScenePrivate::isInArea(const QRect &area, int x, int y) const
 {
     int areaMinX = area.x();
@@ -77,6 +77,7 @@ public:
                                           float distanceModifier = 0.0f);
 
     void markDirty();
+    bool isViewDirty() const;
 
     bool isInArea(const QRect &area, int x, int y) const;
 
@@ -15,6 +15,9 @@
 #include <QtGui/QPainter>
 #include <QtOpenGL/QOpenGLFramebufferObject>
 #include <QtGui/QOffscreenSurface>
+#include <QtCore/QThread>
+#include <QtGui/private/qguiapplication_p.h>
+#include <qpa/qplatformintegration.h>
 #if defined(Q_OS_MACOS)
 #include <qpa/qplatformnativeinterface.h>
 #endif
@@ -140,6 +143,10 @@ QT_BEGIN_NAMESPACE
            Provides the full feature set at a reasonable performance.
     \value OptimizationStatic
            Optimizes the rendering of static data sets at the expense of some features.
+    \value OptimizationProgressive
+           Draws a subset of large scatter series and a coarser mesh of large surfaces
+           first, and refines the result over the following idle frames. Can be combined
+           with the other hints. Available since Qt 6.10.
 */
 
 /*!
@@ -689,9 +696,16 @@ qreal QAbstract3DGraph::aspectRatio() const
  * performance. The static mode optimizes graph rendering and is ideal for
  * large non-changing data sets. It is slower with dynamic data changes and item rotations.
  * Selection is not optimized, so using the static mode with massive data sets is not advisable.
- * Static optimization works only on scatter graphs.
+ * Static optimization works only on scatter graphs. Series using the point mesh are drawn
+ * as round points that get smaller with distance from the camera when static optimization
+ * is used.
  * Defaults to \l{OptimizationDefault}.
  *
+ * The progressive flag can be combined with either mode. When it is set, scatter series
+ * and smooth surfaces that are too large to draw quickly are first drawn with a
+ * subset of their items, and the full data set is drawn over the following frames
+ * while the graph is not changing. The selection is always done against the full data.
+ *
  * \note On some environments, large graphs using static optimization may not render, because
  * all of the items are rendered using a single draw call, and different graphics drivers
  * support different maximum vertice counts per call.
@@ -822,6 +836,10 @@ bool QAbstract3DGraph::isReflection() const
  * Larger numbers make the floor more reflective. The valid range is \c{[0...1]}.
  * Defaults to \c{0.5}.
  *
+ * Reflections are rendered into a texture at reduced resolution and reused for as long as
+ * the view does not change. Values above \c{0.5} render the reflection texture at half of the
+ * graph resolution, smaller values at a quarter of it.
+ *
  * \note Affects only Q3DBars.
  *
  * \sa reflection
@@ -928,6 +946,92 @@ bool QAbstract3DGraph::hasContext() const
         return false;
 }
 
+/*!
+ * \property QAbstract3DGraph::threadedRendering
+ * \since 6.10
+ *
+ * \brief Whether the graph is rendered in a dedicated thread.
+ *
+ * When \c{true}, the OpenGL context of the graph is moved to a render thread of its own. Changes
+ * made to the graph are synchronized to the renderer in that thread while the GUI thread waits,
+ * after which the frame is rendered and swapped without blocking the GUI thread. Input handling
+ * and camera updates remain responsive while large data sets are rendered, and are shown in the
+ * next frame.
+ *
+ * Threaded rendering is only available if the platform supports making OpenGL contexts current
+ * in threads other than the GUI thread. Setting this property has no effect otherwise. Defaults
+ * to \c{false}.
+ *
+ * \note Signals emitted by the graph, its series, and its scene while changes are synchronized
+ * and rendered are emitted from the render thread, so they are delivered to objects living in
+ * the GUI thread via queued connections.
+ *
+ * Graphs with shared OpenGL contexts only share shader programs and meshes with graphs that
+ * render in the same thread. When this property changes, the graph replaces the shared resources
+ * it uses with ones of its new render thread in the next frame.
+ */
+void QAbstract3DGraph::setThreadedRendering(bool enable)
+{
+    if (enable != isThreadedRendering() && d_ptr->setThreadedRendering(enable))
+        emit threadedRenderingChanged(enable);
+}
+
+bool QAbstract3DGraph::isThreadedRendering() const
+{
+    return d_ptr->m_renderThread != nullptr;
+}
+
+/*!
+ * \property QAbstract3DGraph::adaptiveQuality
+ * \since 6.10
+ *
+ * \brief Whether rendering quality is reduced temporarily to keep the graph responsive.
+ *
+ * When \c{true}, the graph is rendered at reduced quality while the camera is being moved, for
+ * example by the input handler, and when rendering a changed frame takes longer than
+ * frameTimeBudget. Reduced quality frames skip the shadow pass and are rendered without
+ * reflections, and volume items are rendered with the low definition shader at half the sample
+ * count. Full quality is restored once the graph has not changed for half a second. If rendering
+ * at full quality is still over the budget after that, the wait before the next restore is
+ * doubled, up to eight seconds.
+ *
+ * The shadowQuality and reflection properties are not changed by the reduction, and the shadow
+ * resources are kept, so switching between the quality levels does not stall rendering.
+ * Defaults to \c{false}.
+ *
+ * \sa frameTimeBudget
+ */
+void QAbstract3DGraph::setAdaptiveQuality(bool enable)
+{
+    d_ptr->m_visualController->setAdaptiveQuality(enable);
+}
+
+bool QAbstract3DGraph::isAdaptiveQuality() const
+{
+    return d_ptr->m_visualController->isAdaptiveQuality();
+}
+
+/*!
+ * \property QAbstract3DGraph::frameTimeBudget
+ * \since 6.10
+ *
+ * \brief The time in milliseconds a frame may take to render before adaptive quality
+ * reduces the rendering quality.
+ *
+ * The value must be positive. Defaults to \c{33.0}, which corresponds to 30 frames per second.
+ *
+ * \sa adaptiveQuality
+ */
+void QAbstract3DGraph::setFrameTimeBudget(qreal msecs)
+{
+    d_ptr->m_visualController->setFrameTimeBudget(msecs);
+}
+
+qreal QAbstract3DGraph::frameTimeBudget() const
+{
+    return d_ptr->m_visualController->frameTimeBudget();
+}
+
 /*!
  * \internal
  */
@@ -1030,12 +1134,20 @@ QAbstract3DGraphPrivate::QAbstract3DGraphPrivate(QAbstract3DGraph *q)
       m_visualController(0),
       m_devicePixelRatio(1.f),
       m_offscreenSurface(0),
-      m_initialized(false)
+      m_initialized(false),
+      m_renderThread(nullptr),
+      m_renderThreadContext(nullptr),
+      m_syncDone(false),
+      m_frameInFlight(false),
+      m_frameQueued(false)
 {
 }
 
 QAbstract3DGraphPrivate::~QAbstract3DGraphPrivate()
 {
+    // Bring the context back to this thread before the renderer is destroyed
+    stopRenderThread();
+
     if (m_offscreenSurface) {
         m_offscreenSurface->destroy();
         delete m_offscreenSurface;
@@ -1102,6 +1214,10 @@ void QAbstract3DGraphPrivate::setVisualController(Abstract3DController *controll
                      &QAbstract3DGraph::queriedGraphPositionChanged);
     QObject::connect(m_visualController, &Abstract3DController::marginChanged, q_ptr,
                      &QAbstract3DGraph::marginChanged);
+    QObject::connect(m_visualController, &Abstract3DController::adaptiveQualityChanged, q_ptr,
+                     &QAbstract3DGraph::adaptiveQualityChanged);
+    QObject::connect(m_visualController, &Abstract3DController::frameTimeBudgetChanged, q_ptr,
+                     &QAbstract3DGraph::frameTimeBudgetChanged);
 }
 
 void QAbstract3DGraphPrivate::handleDevicePixelRatioChange()
@@ -1135,6 +1251,11 @@ void QAbstract3DGraphPrivate::renderNow()
 
     m_updatePending = false;
 
+    if (m_renderThread) {
+        requestThreadedFrame();
+        return;
+    }
+
     m_context->makeCurrent(q_ptr);
 
     render();
@@ -1142,17 +1263,153 @@ void QAbstract3DGraphPrivate::renderNow()
     m_context->swapBuffers(q_ptr);
 }
 
+bool QAbstract3DGraphPrivate::setThreadedRendering(bool enable)
+{
+    if (!enable) {
+        stopRenderThread();
+        return true;
+    }
+    return startRenderThread();
+}
+
+bool QAbstract3DGraphPrivate::startRenderThread()
+{
+    if (!m_initialized || m_renderThread)
+        return false;
+
+    if (!QGuiApplicationPrivate::platformIntegration()->hasCapability(
+                QPlatformIntegration::ThreadedOpenGL)) {
+        qWarning("Threaded rendering is not supported on this platform");
+        return false;
+    }
+
+    if (QOpenGLContext::currentContext() == m_context)
+        m_context->doneCurrent();
+
+    m_renderThread = new QThread;
+    m_renderThread->setObjectName(QStringLiteral("QtDataVisualization render thread"));
+    m_renderThreadContext = new QObject;
+    m_renderThreadContext->moveToThread(m_renderThread);
+
+    // Objects with a parent cannot be moved to another thread
+    m_context->setParent(nullptr);
+    m_context->moveToThread(m_renderThread);
+
+    m_renderThread->start();
+    renderLater();
+    return true;
+}
+
+void QAbstract3DGraphPrivate::stopRenderThread()
+{
+    if (!m_renderThread)
+        return;
+
+    // Waits for any frame in flight to finish first
+    QThread *guiThread = thread();
+    QMetaObject::invokeMethod(m_renderThreadContext, [this, guiThread]() {
+        m_context->doneCurrent();
+        m_context->moveToThread(guiThread);
+    }, Qt::BlockingQueuedConnection);
+
+    m_renderThread->quit();
+    m_renderThread->wait();
+    delete m_renderThreadContext;
+    m_renderThreadContext = nullptr;
+    delete m_renderThread;
+    m_renderThread = nullptr;
+
+    m_context->setParent(q_ptr);
+    m_context->makeCurrent(q_ptr);
+
+    m_frameInFlight = false;
+    if (m_frameQueued) {
+        m_frameQueued = false;
+        renderLater();
+    }
+}
+
+void QAbstract3DGraphPrivate::requestThreadedFrame()
+{
+    // Only one frame is in flight at a time, later requests are served by the next frame
+    if (m_frameInFlight) {
+        m_frameQueued = true;
+        return;
+    }
+    m_frameInFlight = true;
+
+    QMutexLocker locker(&m_syncMutex);
+    m_syncDone = false;
+    QMetaObject::invokeMethod(m_renderThreadContext, [this]() {
+        renderThreadedFrame();
+    }, Qt::QueuedConnection);
+
+    // The controller state must not change while it is synced to the renderer
+    while (!m_syncDone)
+        m_syncCondition.wait(&m_syncMutex);
+}
+
+void QAbstract3DGraphPrivate::renderThreadedFrame()
+{
+    const bool isCurrent = m_context->makeCurrent(q_ptr);
+
+    {
+        QMutexLocker locker(&m_syncMutex);
+        if (isCurrent) {
+            handleDevicePixelRatioChange();
+            m_visualController->synchDataToRenderer();
+        }
+        m_syncDone = true;
+        m_syncCondition.wakeOne();
+    }
+
+    if (isCurrent) {
+        m_visualController->render();
+        m_context->swapBuffers(q_ptr);
+    }
+
+    QMetaObject::invokeMethod(this, &QAbstract3DGraphPrivate::handleThreadedFrameSwapped,
+                              Qt::QueuedConnection);
+}
+
+void QAbstract3DGraphPrivate::handleThreadedFrameSwapped()
+{
+    if (!m_frameInFlight)
+        return;
+
+    m_frameInFlight = false;
+    if (m_frameQueued) {
+        m_frameQueued = false;
+        renderLater();
+    }
+}
+
 QImage QAbstract3DGraphPrivate::renderToImage(int msaaSamples, const QSize &imageSize)
 {
-    QImage image;
-    QOpenGLFramebufferObject *fbo;
-    QOpenGLFramebufferObjectFormat fboFormat;
     if (!m_offscreenSurface) {
         // Create an offscreen surface for rendering to images without rendering on screen
         m_offscreenSurface = new QOffscreenSurface(q_ptr->screen());
         m_offscreenSurface->setFormat(q_ptr->requestedFormat());
         m_offscreenSurface->create();
     }
+
+    if (m_renderThread) {
+        // The context is only usable in the render thread
+        QImage image;
+        QMetaObject::invokeMethod(m_renderThreadContext, [&]() {
+            image = renderToImageNow(msaaSamples, imageSize);
+        }, Qt::BlockingQueuedConnection);
+        return image;
+    }
+
+    return renderToImageNow(msaaSamples, imageSize);
+}
+
+QImage QAbstract3DGraphPrivate::renderToImageNow(int msaaSamples, const QSize &imageSize)
+{
+    QImage image;
+    QOpenGLFramebufferObject *fbo;
+    QOpenGLFramebufferObjectFormat fboFormat;
     // Render the wanted frame offscreen
     m_context->makeCurrent(m_offscreenSurface);
     fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
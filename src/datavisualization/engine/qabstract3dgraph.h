@@ -43,6 +43,9 @@ class Q_DATAVISUALIZATION_EXPORT QAbstract3DGraph : public QWindow, protected QO
     Q_PROPERTY(QLocale locale READ locale WRITE setLocale NOTIFY localeChanged)
     Q_PROPERTY(QVector3D queriedGraphPosition READ queriedGraphPosition NOTIFY queriedGraphPositionChanged)
     Q_PROPERTY(qreal margin READ margin WRITE setMargin NOTIFY marginChanged)
+    Q_PROPERTY(bool threadedRendering READ isThreadedRendering WRITE setThreadedRendering NOTIFY threadedRenderingChanged REVISION(6, 10))
+    Q_PROPERTY(bool adaptiveQuality READ isAdaptiveQuality WRITE setAdaptiveQuality NOTIFY adaptiveQualityChanged REVISION(6, 10))
+    Q_PROPERTY(qreal frameTimeBudget READ frameTimeBudget WRITE setFrameTimeBudget NOTIFY frameTimeBudgetChanged REVISION(6, 10))
 
 protected:
     explicit QAbstract3DGraph(QAbstract3DGraphPrivate *d, const QSurfaceFormat *format,
@@ -87,7 +90,8 @@ public:
 
     enum OptimizationHint {
         OptimizationDefault = 0,
-        OptimizationStatic  = 1
+        OptimizationStatic  = 1,
+        OptimizationProgressive = 2
     };
     Q_ENUM(OptimizationHint)
     Q_DECLARE_FLAGS(OptimizationHints, OptimizationHint)
@@ -175,6 +179,15 @@ public:
 
     bool hasContext() const;
 
+    void setThreadedRendering(bool enable);
+    bool isThreadedRendering() const;
+
+    void setAdaptiveQuality(bool enable);
+    bool isAdaptiveQuality() const;
+
+    void setFrameTimeBudget(qreal msecs);
+    qreal frameTimeBudget() const;
+
 protected:
     bool event(QEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
@@ -208,6 +221,9 @@ Q_SIGNALS:
     void localeChanged(const QLocale &locale);
     void queriedGraphPositionChanged(const QVector3D &data);
     void marginChanged(qreal margin);
+    Q_REVISION(6, 10) void threadedRenderingChanged(bool enabled);
+    Q_REVISION(6, 10) void adaptiveQualityChanged(bool enabled);
+    Q_REVISION(6, 10) void frameTimeBudgetChanged(qreal msecs);
 
 private:
     Q_DISABLE_COPY(QAbstract3DGraph)
@@ -216,6 +232,7 @@ private:
     friend class Q3DBars;
     friend class Q3DScatter;
     friend class Q3DSurface;
+    friend class QAbstract3DGraphPrivate;
 };
 Q_DECLARE_OPERATORS_FOR_FLAGS(QAbstract3DGraph::SelectionFlags)
 Q_DECLARE_OPERATORS_FOR_FLAGS(QAbstract3DGraph::OptimizationHints)
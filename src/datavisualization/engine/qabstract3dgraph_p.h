@@ -15,10 +15,14 @@
 #define QABSTRACT3DGRAPH_P_H
 
 #include "datavisualizationglobal_p.h"
+#include "qabstract3dgraph.h"
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
 
 QT_BEGIN_NAMESPACE
 class QOpenGLContext;
 class QOffscreenSurface;
+class QThread;
 QT_END_NAMESPACE
 
 QT_BEGIN_NAMESPACE
@@ -41,6 +45,22 @@ public:
 
     QImage renderToImage(int msaaSamples, const QSize &imageSize);
 
+    bool setThreadedRendering(bool enable);
+
+    // Gives manual tests and benchmarks access to the frame statistics of the controller
+    static inline Abstract3DController *controller(QAbstract3DGraph *graph)
+    {
+        return graph->d_ptr->m_visualController;
+    }
+
+private:
+    bool startRenderThread();
+    void stopRenderThread();
+    void requestThreadedFrame();
+    void renderThreadedFrame();
+    void handleThreadedFrameSwapped();
+    QImage renderToImageNow(int msaaSamples, const QSize &imageSize);
+
 public Q_SLOTS:
     void renderLater();
     void renderNow();
@@ -58,6 +78,17 @@ public:
     float m_devicePixelRatio;
     QOffscreenSurface *m_offscreenSurface;
     bool m_initialized;
+
+    // Threaded rendering. The context is current on m_renderThread, where changes are synced
+    // while the GUI thread waits on m_syncCondition. Rendering and swapping then proceed
+    // without blocking the GUI thread.
+    QThread *m_renderThread;
+    QObject *m_renderThreadContext;
+    QMutex m_syncMutex;
+    QWaitCondition m_syncCondition;
+    bool m_syncDone;
+    bool m_frameInFlight;
+    bool m_frameQueued;
 };
 
 QT_END_NAMESPACE
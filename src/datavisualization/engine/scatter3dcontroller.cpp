@@ -57,17 +57,23 @@ void Scatter3DController::synchDataToRenderer()
     if (!isInitialized())
         return;
 
+    // Data snapshotted in the previous pass must be applied before new snapshots are taken,
+    // in case no frame was rendered in between
+    m_renderer->flushDataUpdates();
+
     Abstract3DController::synchDataToRenderer();
 
     // Notify changes to renderer
     if (m_changeTracker.itemChanged) {
         m_renderer->updateItems(m_changedItems);
+        m_renderer->markFrameChanges(FrameChangeData);
         m_changeTracker.itemChanged = false;
         m_changedItems.clear();
     }
 
     if (m_changeTracker.selectedItemChanged) {
         m_renderer->updateSelectedItem(m_selectedItem, m_selectedItemSeries);
+        m_renderer->markFrameChanges(FrameChangeSelection);
         m_changeTracker.selectedItemChanged = false;
     }
 }
@@ -11,6 +11,9 @@
 #include "scatterseriesrendercache_p.h"
 #include "scatterobjectbufferhelper_p.h"
 #include "scatterpointbufferhelper_p.h"
+#include "scatteraggregator_p.h"
+#include "frustum_p.h"
+#include "qlogvalue3daxisformatter.h"
 
 #include <QtCore/qmath.h>
 
@@ -23,10 +26,23 @@ QT_BEGIN_NAMESPACE
 const GLfloat defaultMinSize = 0.01f;
 const GLfloat defaultMaxSize = 0.1f;
 const GLfloat itemScaler = 3.0f;
+// Number of items per series drawn on the first frame with progressive optimization
+const int progressiveItemBudget = 50000;
+// Bounds that include all translations, but not the hidden point positions
+const QVector3D unboundedPosition(1.0e30f, 1.0e30f, 1.0e30f);
+// Approximate size of an aggregation cell on screen in pixels
+const float aggregationCellPixels = 4.0f;
+// Items are drawn individually when zoomed in further than this many cells per axis
+const int maxAggregationResolution = 1024;
+// Cells per axis of the grid used for culling items against the view frustum
+const int cullingGridResolution = 16;
+// Item meshes span [-1, 1] scaled by the item size, so they fit in a sphere of radius sqrt(3)
+const float itemBoundingRadius = 1.7320508f;
 
 Scatter3DRenderer::Scatter3DRenderer(Scatter3DController *controller)
     : Abstract3DRenderer(controller),
-      m_selectedItem(0),
+      m_labelSeriesCache(0),
+      m_labelItemIndex(-1),
       m_updateLabels(false),
       m_dotShader(0),
       m_dotGradientShader(0),
@@ -36,7 +52,9 @@ Scatter3DRenderer::Scatter3DRenderer(Scatter3DController *controller)
       m_depthShader(0),
       m_selectionShader(0),
       m_backgroundShader(0),
-      m_staticGradientPointShader(0),
+      m_pointSpriteShader(0),
+      m_pointSpriteGradientShader(0),
+      m_pointSpriteDepthShader(0),
       m_bgrTexture(0),
       m_selectionTexture(0),
       m_depthFrameBuffer(0),
@@ -56,7 +74,11 @@ Scatter3DRenderer::Scatter3DRenderer(Scatter3DController *controller)
       m_havePointSeries(false),
       m_haveMeshSeries(false),
       m_haveUniformColorMeshSeries(false),
-      m_haveGradientMeshSeries(false)
+      m_haveGradientMeshSeries(false),
+      m_dataSnapshotPending(false),
+      m_selectionPending(false),
+      m_pendingSelectedItemIndex(Scatter3DController::invalidSelectionIndex()),
+      m_pendingSelectedSeries(0)
 {
     initializeOpenGL();
 }
@@ -71,7 +93,9 @@ Scatter3DRenderer::~Scatter3DRenderer()
     delete m_depthShader;
     delete m_selectionShader;
     delete m_backgroundShader;
-    delete m_staticGradientPointShader;
+    delete m_pointSpriteShader;
+    delete m_pointSpriteGradientShader;
+    delete m_pointSpriteDepthShader;
 }
 
 void Scatter3DRenderer::contextCleanup()
@@ -159,6 +183,36 @@ void Scatter3DRenderer::getVisibleItemBounds(QVector3D &minBounds, QVector3D &ma
 }
 
 void Scatter3DRenderer::updateData()
+{
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        ScatterSeriesRenderCache *cache = static_cast<ScatterSeriesRenderCache *>(baseCache);
+        if (cache->isVisible() && cache->dataDirty())
+            cache->takeDataSnapshot();
+    }
+    m_dataSnapshotPending = true;
+    m_dataUpdatesPending = true;
+}
+
+void Scatter3DRenderer::applyDataUpdates()
+{
+    if (m_dataSnapshotPending) {
+        applyData();
+        m_dataSnapshotPending = false;
+    }
+    if (!m_pendingItems.isEmpty()) {
+        applyItems(m_pendingItems);
+        m_pendingItems.clear();
+    }
+    if (m_selectionPending) {
+        m_selectionPending = false;
+        updateSelectedItem(m_pendingSelectedItemIndex, m_pendingSelectedSeries);
+    }
+
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList)
+        static_cast<ScatterSeriesRenderCache *>(baseCache)->releaseDataSnapshot();
+}
+
+void Scatter3DRenderer::applyData()
 {
     calculateSceneScalingFactors();
     int totalDataSize = 0;
@@ -166,24 +220,28 @@ void Scatter3DRenderer::updateData()
     foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
         ScatterSeriesRenderCache *cache = static_cast<ScatterSeriesRenderCache *>(baseCache);
         if (cache->isVisible()) {
-            const QScatter3DSeries *currentSeries = cache->series();
             ScatterRenderItemArray &renderArray = cache->renderArray();
-            QScatterDataProxy *dataProxy = currentSeries->dataProxy();
-            const QScatterDataArray &dataArray = *dataProxy->array();
-            int dataSize = dataArray.size();
-            totalDataSize += dataSize;
-            if (cache->dataDirty()) {
+            if (cache->dataDirty() && cache->hasDataSnapshot()) {
+                const QScatterDataArray &dataArray = cache->dataSnapshot();
+                int dataSize = dataArray.size();
                 if (dataSize != renderArray.size())
                     renderArray.resize(dataSize);
 
                 for (int i = 0; i < dataSize; i++)
-                    updateRenderItem(dataArray.at(i), renderArray[i]);
+                    updateRenderItem(dataArray.at(i), renderArray, i);
+
+                // Binned again before the next frame is drawn
+                if (cache->aggregator())
+                    cache->aggregator()->clear();
+                cache->cullingGrid()->clear();
 
                 if (m_cachedOptimizationHint.testFlag(QAbstract3DGraph::OptimizationStatic))
                     cache->setStaticBufferDirty(true);
 
                 cache->setDataDirty(false);
+                cache->setTranslationsDirty(false);
             }
+            totalDataSize += renderArray.size();
         }
     }
 
@@ -206,14 +264,25 @@ void Scatter3DRenderer::updateData()
                         points = new ScatterPointBufferHelper();
                         cache->setBufferPoints(points);
                     }
-                    points->setScaleY(m_scaleY);
-                    points->load(cache);
+                    // Axis changes need no reload when the buffer holds data positions
+                    const bool dataPositions = isAxisMappingInShader();
+                    if (!points->m_meshDataLoaded
+                            || points->hasDataPositions() != dataPositions
+                            || renderArraySize != cache->oldArraySize()
+                            || cache->object()->objectFile() != cache->oldMeshFileName()
+                            || cache->staticBufferDirty()) {
+                        points->load(cache, dataPositions);
+                        cache->setOldArraySize(renderArraySize);
+                        cache->setOldMeshFileName(cache->object()->objectFile());
+                    }
                 } else {
                     ScatterObjectBufferHelper *object = cache->bufferObject();
                     if (!object) {
                         object = new ScatterObjectBufferHelper();
                         cache->setBufferObject(object);
                     }
+                    if (cache->translationsDirty())
+                        updateTranslations(cache);
                     if (renderArraySize != cache->oldArraySize()
                             || cache->object()->objectFile() != cache->oldMeshFileName()
                             || cache->staticBufferDirty()) {
@@ -278,6 +347,7 @@ void Scatter3DRenderer::updateSeries(const QList<QAbstract3DSeries *> &seriesLis
                 maxItemSize = itemSize;
             if (cache->itemSize() != itemSize)
                 cache->setItemSize(itemSize);
+            cache->setAggregationEnabled(scatterSeries->isAggregationEnabled());
             if (noSelection
                     && scatterSeries->selectedItem() != QScatter3DSeries::invalidSelectionIndex()) {
                 if (m_selectionLabel != cache->itemLabel())
@@ -303,10 +373,8 @@ void Scatter3DRenderer::updateSeries(const QList<QAbstract3DSeries *> &seriesLis
                 cache->setStaticBufferDirty(false);
             }
             if (cache->staticObjectUVDirty()) {
-                if (cache->mesh() == QAbstract3DSeries::MeshPoint) {
-                    ScatterPointBufferHelper *object = cache->bufferPoints();
-                    object->updateUVs(cache);
-                } else {
+                // Point sprites calculate the gradient coordinates in the vertex shader
+                if (cache->mesh() != QAbstract3DSeries::MeshPoint) {
                     ScatterObjectBufferHelper *object = cache->bufferObject();
                     object->updateUVs(cache);
                 }
@@ -330,6 +398,22 @@ SeriesRenderCache *Scatter3DRenderer::createNewCache(QAbstract3DSeries *series)
 }
 
 void Scatter3DRenderer::updateItems(const QList<Scatter3DController::ChangeItem> &items)
+{
+    const QScatter3DSeries *prevSeries = 0;
+    foreach (const Scatter3DController::ChangeItem &item, items) {
+        if (item.series != prevSeries) {
+            ScatterSeriesRenderCache *cache =
+                    static_cast<ScatterSeriesRenderCache *>(m_renderCacheList.value(item.series));
+            if (cache && cache->isVisible())
+                cache->takeDataSnapshot();
+            prevSeries = item.series;
+        }
+    }
+    m_pendingItems.append(items);
+    m_dataUpdatesPending = true;
+}
+
+void Scatter3DRenderer::applyItems(const QList<Scatter3DController::ChangeItem> &items)
 {
     ScatterSeriesRenderCache *cache = 0;
     const QScatter3DSeries *prevSeries = 0;
@@ -342,7 +426,7 @@ void Scatter3DRenderer::updateItems(const QList<Scatter3DController::ChangeItem>
         if (currentSeries != prevSeries) {
             cache = static_cast<ScatterSeriesRenderCache *>(m_renderCacheList.value(currentSeries));
             prevSeries = currentSeries;
-            dataArray = item.series->dataProxy()->array();
+            dataArray = &cache->dataSnapshot();
             // Invisible series render caches are not updated, but instead just marked dirty, so that
             // they can be completely recalculated when they are turned visible.
             if (!cache->isVisible() && !cache->dataDirty())
@@ -353,12 +437,15 @@ void Scatter3DRenderer::updateItems(const QList<Scatter3DController::ChangeItem>
             if (index >= cache->renderArray().size())
                 continue; // Items removed from array for same render
             bool oldVisibility = false;
-            ScatterRenderItem &item = cache->renderArray()[index];
+            ScatterRenderItemArray &renderArray = cache->renderArray();
             if (optimizationStatic)
-                oldVisibility = item.isVisible();
-            updateRenderItem(dataArray->at(index), item);
+                oldVisibility = renderArray.isVisible(index);
+            updateRenderItem(dataArray->at(index), renderArray, index);
+            if (cache->aggregator())
+                cache->aggregator()->updateItem(renderArray, index);
+            cache->cullingGrid()->updateItem(renderArray, index);
             if (optimizationStatic) {
-                if (!cache->visibilityChanged() && oldVisibility != item.isVisible())
+                if (!cache->visibilityChanged() && oldVisibility != renderArray.isVisible(index))
                     cache->setVisibilityChanged(true);
                 cache->updateIndices().append(index);
             }
@@ -370,9 +457,9 @@ void Scatter3DRenderer::updateItems(const QList<Scatter3DController::ChangeItem>
             if (cache->isVisible() && cache->updateIndices().size()) {
                 if (cache->mesh() == QAbstract3DSeries::MeshPoint) {
                     cache->bufferPoints()->update(cache);
-                    if (cache->colorStyle() == Q3DTheme::ColorStyleRangeGradient)
-                        cache->bufferPoints()->updateUVs(cache);
                 } else {
+                    if (cache->translationsDirty())
+                        updateTranslations(cache);
                     if (cache->visibilityChanged()) {
                         // If any change changes item visibility, full load is needed to
                         // resize the buffers.
@@ -424,11 +511,8 @@ void Scatter3DRenderer::updateOptimizationHint(QAbstract3DGraph::OptimizationHin
 
     Abstract3DRenderer::reInitShaders();
 
-    if (m_isOpenGLES && hint.testFlag(QAbstract3DGraph::OptimizationStatic)
-            && !m_staticGradientPointShader) {
-        initStaticPointShaders(QStringLiteral(":/shaders/vertexPointES2_UV"),
-                               QStringLiteral(":/shaders/fragmentLabel"));
-    }
+    if (hint.testFlag(QAbstract3DGraph::OptimizationStatic) && !m_pointSpriteShader)
+        initPointSpriteShaders();
 }
 
 void Scatter3DRenderer::updateMargin(float margin)
@@ -437,6 +521,24 @@ void Scatter3DRenderer::updateMargin(float margin)
     calculateSceneScalingFactors();
 }
 
+void Scatter3DRenderer::handleAxisMappingChanged()
+{
+    // Point buffers holding data positions are mapped to the axes in the vertex shader, so
+    // only the render item translations need updating, and only once they are used
+    const bool mapInShader = isAxisMappingInShader();
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        ScatterSeriesRenderCache *cache = static_cast<ScatterSeriesRenderCache *>(baseCache);
+        ScatterPointBufferHelper *points = cache->bufferPoints();
+        if (mapInShader && m_cachedOptimizationHint.testFlag(QAbstract3DGraph::OptimizationStatic)
+                && cache->mesh() == QAbstract3DSeries::MeshPoint
+                && points && points->hasDataPositions()) {
+            cache->setTranslationsDirty(true);
+        } else {
+            cache->setDataDirty(true);
+        }
+    }
+}
+
 void Scatter3DRenderer::resetClickedStatus()
 {
     m_clickedIndex = Scatter3DController::invalidSelectionIndex();
@@ -494,6 +596,7 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
     // Calculate view matrix
     QMatrix4x4 viewMatrix = activeCamera->d_ptr->viewMatrix();
     QMatrix4x4 projectionViewMatrix = projectionMatrix * viewMatrix;
+    const Frustum frustum(projectionViewMatrix);
 
     // Calculate label flipping
     if (viewMatrix.row(0).x() > 0)
@@ -525,6 +628,11 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
     // Get light position from the scene
     QVector3D lightPos = m_cachedScene->activeLight()->position();
 
+    if (optimizationDefault) {
+        updateAggregation();
+        updateCullingGrids();
+    }
+
     // Introduce regardless of shadow quality to simplify logic
     QMatrix4x4 depthProjectionViewMatrix;
 
@@ -564,111 +672,96 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
             // Set the depth projection matrix
             depthProjectionMatrix.perspective(15.0f, viewPortRatio, 3.0f, 100.0f);
             depthProjectionViewMatrix = depthProjectionMatrix * depthViewMatrix;
+            // Adaptive quality skips drawing the shadow casters. The cleared depth texture leaves
+            // the scene unshadowed without switching shaders or recreating the depth buffer.
+            if (!m_skipShadowPass) {
+                const Frustum depthFrustum(depthProjectionViewMatrix);
+
+                // Draw dots to depth buffer, culled against the light frustum
+                foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+                    if (baseCache->isVisible()) {
+                        ScatterSeriesRenderCache *cache =
+                                static_cast<ScatterSeriesRenderCache *>(baseCache);
+                        ObjectHelper *dotObj = cache->object();
+                        QQuaternion seriesRotation(cache->meshRotation());
+                        const ScatterRenderItemArray &renderArray = cache->renderArray();
+                        const int renderArraySize = renderArray.size();
+                        bool drawingPoints = (cache->mesh() == QAbstract3DSeries::MeshPoint);
+                        float itemSize = cache->itemSize() / itemScaler;
+                        if (itemSize == 0.0f)
+                            itemSize = m_dotSizeScale;
+                        if (drawingPoints) {
+                            // Scale points based on shadow quality for shadows, not by zoom level
+                            m_funcs_2_1->glPointSize(itemSize * 100.0f * m_shadowQualityMultiplier);
+                        }
+                        QVector3D modelScaler(itemSize, itemSize, itemSize);
 
-            // Draw dots to depth buffer
-            foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-                if (baseCache->isVisible()) {
-                    ScatterSeriesRenderCache *cache =
-                            static_cast<ScatterSeriesRenderCache *>(baseCache);
-                    ObjectHelper *dotObj = cache->object();
-                    QQuaternion seriesRotation(cache->meshRotation());
-                    const ScatterRenderItemArray &renderArray = cache->renderArray();
-                    const int renderArraySize = renderArray.size();
-                    bool drawingPoints = (cache->mesh() == QAbstract3DSeries::MeshPoint);
-                    float itemSize = cache->itemSize() / itemScaler;
-                    if (itemSize == 0.0f)
-                        itemSize = m_dotSizeScale;
-                    if (drawingPoints) {
-                        // Scale points based on shadow quality for shadows, not by zoom level
-                        m_funcs_2_1->glPointSize(itemSize * 100.0f * m_shadowQualityMultiplier);
-                    }
-                    QVector3D modelScaler(itemSize, itemSize, itemSize);
-
-                    if (!optimizationDefault
-                            && ((drawingPoints && cache->bufferPoints()->indexCount() == 0)
-                                || (!drawingPoints && cache->bufferObject()->indexCount() == 0))) {
-                        continue;
-                    }
-
-                    int loopCount = 1;
-                    if (optimizationDefault)
-                        loopCount = renderArraySize;
-                    for (int dot = 0; dot < loopCount; dot++) {
-                        const ScatterRenderItem &item = renderArray.at(dot);
-                        if (!item.isVisible() && optimizationDefault)
+                        if (!optimizationDefault
+                                && ((drawingPoints && cache->bufferPoints()->indexCount() == 0)
+                                    || (!drawingPoints
+                                        && cache->bufferObject()->indexCount() == 0))) {
                             continue;
+                        }
 
-                        QMatrix4x4 modelMatrix;
-                        QMatrix4x4 MVPMatrix;
-
+                        const QList<int> *items = visibleItems(cache, depthFrustum,
+                                                               itemSize * itemBoundingRadius);
+                        int loopCount = 1;
+                        int stride = 1;
                         if (optimizationDefault) {
-                            modelMatrix.translate(item.translation());
-                            if (!drawingPoints) {
-                                if (!seriesRotation.isIdentity() || !item.rotation().isIdentity())
-                                    modelMatrix.rotate(seriesRotation * item.rotation());
-                                modelMatrix.scale(modelScaler);
-                            }
+                            loopCount = items ? int(items->size()) : renderArraySize;
+                            stride = progressiveStride(loopCount, progressiveItemBudget);
                         }
+                        for (int n = 0; n < loopCount; n++) {
+                            if (n & (stride - 1))
+                                continue;
+                            const int dot = items ? items->at(n) : n;
+                            if (optimizationDefault && !renderArray.isVisible(dot))
+                                continue;
 
-                        MVPMatrix = depthProjectionViewMatrix * modelMatrix;
-
-                        m_depthShader->setUniformValue(m_depthShader->MVP(), MVPMatrix);
+                            QMatrix4x4 modelMatrix;
+                            QMatrix4x4 MVPMatrix;
 
-                        if (drawingPoints) {
-                            if (optimizationDefault)
-                                m_drawer->drawPoint(m_depthShader);
-                            else
-                                m_drawer->drawPoints(m_depthShader, cache->bufferPoints(), 0);
-                        } else {
                             if (optimizationDefault) {
-                                // 1st attribute buffer : vertices
-                                glEnableVertexAttribArray(m_depthShader->posAtt());
-                                glBindBuffer(GL_ARRAY_BUFFER, dotObj->vertexBuf());
-                                glVertexAttribPointer(m_depthShader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0,
-                                                      (void *)0);
-
-                                // Index buffer
-                                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, dotObj->elementBuf());
+                                modelMatrix.translate(renderArray.translation(dot));
+                                if (!drawingPoints) {
+                                    const QQuaternion itemRotation = renderArray.rotation(dot);
+                                    if (!seriesRotation.isIdentity() || !itemRotation.isIdentity())
+                                        modelMatrix.rotate(seriesRotation * itemRotation);
+                                    modelMatrix.scale(modelScaler);
+                                }
+                            }
 
-                                // Draw the triangles
-                                glDrawElements(GL_TRIANGLES, dotObj->indexCount(),
-                                               GL_UNSIGNED_INT, (void *)0);
+                            MVPMatrix = depthProjectionViewMatrix * modelMatrix;
 
-                                // Free buffers
-                                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-                                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                            m_depthShader->setUniformValue(m_depthShader->MVP(), MVPMatrix);
 
-                                glDisableVertexAttribArray(m_depthShader->posAtt());
+                            if (drawingPoints) {
+                                if (optimizationDefault) {
+                                    m_drawer->drawPoint(m_depthShader);
+                                } else {
+                                    m_pointSpriteDepthShader->bind();
+                                    drawPointSprites(m_pointSpriteDepthShader, cache, MVPMatrix,
+                                                     itemSize * 100.0f * m_shadowQualityMultiplier,
+                                                     0);
+                                    m_depthShader->bind();
+                                }
                             } else {
-                                ScatterObjectBufferHelper *object = cache->bufferObject();
-                                // 1st attribute buffer : vertices
-                                glEnableVertexAttribArray(m_depthShader->posAtt());
-                                glBindBuffer(GL_ARRAY_BUFFER, object->vertexBuf());
-                                glVertexAttribPointer(m_depthShader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0,
-                                                      (void *)0);
-
-                                // Index buffer
-                                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->elementBuf());
-
-                                // Draw the triangles
-                                glDrawElements(GL_TRIANGLES, object->indexCount(),
-                                               GL_UNSIGNED_INT, (void *)0);
-
-                                // Free buffers
-                                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-                                glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-                                glDisableVertexAttribArray(m_depthShader->posAtt());
+                                if (optimizationDefault) {
+                                    m_drawer->drawSelectionObject(m_depthShader, dotObj);
+                                } else {
+                                    m_drawer->drawSelectionObject(m_depthShader,
+                                                                  cache->bufferObject());
+                                }
                             }
                         }
                     }
                 }
-            }
 
-            Abstract3DRenderer::drawCustomItems(RenderingDepth, m_depthShader, viewMatrix,
-                                                projectionViewMatrix,
-                                                depthProjectionViewMatrix, m_depthTexture,
-                                                m_shadowQualityToShader);
+                Abstract3DRenderer::drawCustomItems(RenderingDepth, m_depthShader, viewMatrix,
+                                                    projectionViewMatrix,
+                                                    depthProjectionViewMatrix, m_depthTexture,
+                                                    m_shadowQualityToShader);
+            }
 
             // Disable drawing to framebuffer (= enable drawing to screen)
             glBindFramebuffer(GL_FRAMEBUFFER, defaultFboHandle);
@@ -708,83 +801,90 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                    m_primarySubViewport.width(),
                    m_primarySubViewport.height());
 
-        glEnable(GL_DEPTH_TEST); // Needed, otherwise the depth render buffer is not used
-        glClearColor(1.0f, 1.0f, 1.0f, 1.0f); // Set clear color to white (= skipColor)
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Needed for clearing the frame buffer
-        glDisable(GL_DITHER); // disable dithering, it may affect colors if enabled
+        if (!reuseSelectionBuffer()) {
+            glEnable(GL_DEPTH_TEST); // Needed, otherwise the depth render buffer is not used
+            glClearColor(1.0f, 1.0f, 1.0f, 1.0f); // Set clear color to white (= skipColor)
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Needed for clearing the frame buffer
+            glDisable(GL_DITHER); // disable dithering, it may affect colors if enabled
 
-        bool previousDrawingPoints = false;
-        int totalIndex = 0;
-        foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-            if (baseCache->isVisible()) {
-                ScatterSeriesRenderCache *cache =
-                        static_cast<ScatterSeriesRenderCache *>(baseCache);
-                ObjectHelper *dotObj = cache->object();
-                QQuaternion seriesRotation(cache->meshRotation());
-                const ScatterRenderItemArray &renderArray = cache->renderArray();
-                const int renderArraySize = renderArray.size();
-                bool drawingPoints = (cache->mesh() == QAbstract3DSeries::MeshPoint);
-                float itemSize = cache->itemSize() / itemScaler;
-                if (itemSize == 0.0f)
-                    itemSize = m_dotSizeScale;
+            bool previousDrawingPoints = false;
+            int totalIndex = 0;
+            foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+                if (baseCache->isVisible()) {
+                    ScatterSeriesRenderCache *cache =
+                            static_cast<ScatterSeriesRenderCache *>(baseCache);
+                    if (cache->translationsDirty())
+                        updateTranslations(cache);
+                    ObjectHelper *dotObj = cache->object();
+                    QQuaternion seriesRotation(cache->meshRotation());
+                    const ScatterRenderItemArray &renderArray = cache->renderArray();
+                    const int renderArraySize = renderArray.size();
+                    bool drawingPoints = (cache->mesh() == QAbstract3DSeries::MeshPoint);
+                    float itemSize = cache->itemSize() / itemScaler;
+                    if (itemSize == 0.0f)
+                        itemSize = m_dotSizeScale;
 #if !QT_CONFIG(opengles2)
-                if (drawingPoints && !m_isOpenGLES)
-                    m_funcs_2_1->glPointSize(itemSize * activeCamera->zoomLevel());
+                    if (drawingPoints && !m_isOpenGLES)
+                        m_funcs_2_1->glPointSize(itemSize * activeCamera->zoomLevel());
 #endif
-                QVector3D modelScaler(itemSize, itemSize, itemSize);
+                    QVector3D modelScaler(itemSize, itemSize, itemSize);
 
-                // Rebind selection shader if it has changed
-                if (!totalIndex || drawingPoints != previousDrawingPoints) {
-                    previousDrawingPoints = drawingPoints;
-                    if (drawingPoints)
-                        selectionShader = pointSelectionShader;
-                    else
-                        selectionShader = m_selectionShader;
+                    // Rebind selection shader if it has changed
+                    if (!totalIndex || drawingPoints != previousDrawingPoints) {
+                        previousDrawingPoints = drawingPoints;
+                        if (drawingPoints)
+                            selectionShader = pointSelectionShader;
+                        else
+                            selectionShader = m_selectionShader;
 
-                    selectionShader->bind();
-                }
-                cache->setSelectionIndexOffset(totalIndex);
-                for (int dot = 0; dot < renderArraySize; dot++) {
-                    const ScatterRenderItem &item = renderArray.at(dot);
-                    if (!item.isVisible()) {
-                        totalIndex++;
-                        continue;
+                        selectionShader->bind();
                     }
+                    cache->setSelectionIndexOffset(totalIndex);
+                    const QList<int> *items = visibleItems(cache, frustum,
+                                                           itemSize * itemBoundingRadius);
+                    const int loopCount = items ? int(items->size()) : renderArraySize;
+                    for (int n = 0; n < loopCount; n++) {
+                        const int dot = items ? items->at(n) : n;
+                        if (!renderArray.isVisible(dot))
+                            continue;
 
-                    QMatrix4x4 modelMatrix;
-                    QMatrix4x4 MVPMatrix;
+                        QMatrix4x4 modelMatrix;
+                        QMatrix4x4 MVPMatrix;
 
-                    modelMatrix.translate(item.translation());
-                    if (!drawingPoints) {
-                        if (!seriesRotation.isIdentity() || !item.rotation().isIdentity())
-                            modelMatrix.rotate(seriesRotation * item.rotation());
-                        modelMatrix.scale(modelScaler);
-                    }
+                        modelMatrix.translate(renderArray.translation(dot));
+                        if (!drawingPoints) {
+                            const QQuaternion itemRotation = renderArray.rotation(dot);
+                            if (!seriesRotation.isIdentity() || !itemRotation.isIdentity())
+                                modelMatrix.rotate(seriesRotation * itemRotation);
+                            modelMatrix.scale(modelScaler);
+                        }
 
-                    MVPMatrix = projectionViewMatrix * modelMatrix;
+                        MVPMatrix = projectionViewMatrix * modelMatrix;
 
-                    QVector4D dotColor = indexToSelectionColor(totalIndex++);
-                    dotColor /= 255.0f;
+                        QVector4D dotColor = indexToSelectionColor(totalIndex + dot);
+                        dotColor /= 255.0f;
 
-                    selectionShader->setUniformValue(selectionShader->MVP(), MVPMatrix);
-                    selectionShader->setUniformValue(selectionShader->color(), dotColor);
+                        selectionShader->setUniformValue(selectionShader->MVP(), MVPMatrix);
+                        selectionShader->setUniformValue(selectionShader->color(), dotColor);
 
-                    if (drawingPoints)
-                        m_drawer->drawPoint(selectionShader);
-                    else
-                        m_drawer->drawSelectionObject(selectionShader, dotObj);
+                        if (drawingPoints)
+                            m_drawer->drawPoint(selectionShader);
+                        else
+                            m_drawer->drawSelectionObject(selectionShader, dotObj);
+                    }
+                    totalIndex += renderArraySize;
                 }
             }
-        }
 
-        Abstract3DRenderer::drawCustomItems(RenderingSelection, m_selectionShader,
-                                            viewMatrix, projectionViewMatrix,
-                                            depthProjectionViewMatrix, m_depthTexture,
-                                            m_shadowQualityToShader);
+            Abstract3DRenderer::drawCustomItems(RenderingSelection, m_selectionShader,
+                                                viewMatrix, projectionViewMatrix,
+                                                depthProjectionViewMatrix, m_depthTexture,
+                                                m_shadowQualityToShader);
 
-        drawLabels(true, activeCamera, viewMatrix, projectionMatrix);
+            drawLabels(true, activeCamera, viewMatrix, projectionMatrix);
 
-        glEnable(GL_DITHER);
+            glEnable(GL_DITHER);
+        }
 
         // Read color under cursor
         QVector4D clickedColor = Utils::getSelection(m_inputPosition,
@@ -806,7 +906,8 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
     ShaderHelper *dotShader = 0;
     GLuint gradientTexture = 0;
     bool dotSelectionFound = false;
-    ScatterRenderItem *selectedItem(0);
+    AbstractRenderItem selectedItem;
+    ScatterSeriesRenderCache *selectedItemCache = 0;
     QVector4D baseColor;
     QVector4D dotColor;
 
@@ -882,14 +983,12 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                     || (!optimizationDefault && drawingPoints)) {
                 previousDrawingPoints = drawingPoints;
                 if (drawingPoints) {
-                    if (!optimizationDefault && rangeGradientPoints) {
-                        if (m_isOpenGLES)
-                            dotShader = m_staticGradientPointShader;
-                        else
-                            dotShader = m_labelShader;
-                    } else {
+                    if (!optimizationDefault && rangeGradientPoints)
+                        dotShader = m_pointSpriteGradientShader;
+                    else if (!optimizationDefault)
+                        dotShader = m_pointSpriteShader;
+                    else
                         dotShader = pointSelectionShader;
-                    }
                 } else {
                     if (colorStyleIsUniform)
                         dotShader = m_dotShader;
@@ -918,24 +1017,36 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                 baseColor = cache->baseColor();
                 dotColor = baseColor;
             }
+            // The selected item is drawn even if it is culled or does not represent its cell,
+            // as the selection label is positioned by it
+            const QList<int> *items = visibleItems(cache, frustum, itemSize * itemBoundingRadius,
+                                                   selectedSeries ? m_selectedItemIndex : -1);
             int loopCount = 1;
-            if (optimizationDefault)
-                loopCount = renderArraySize;
+            int stride = 1;
+            if (optimizationDefault) {
+                loopCount = items ? int(items->size()) : renderArraySize;
+                stride = progressiveStride(loopCount, progressiveItemBudget);
+            }
 
-            for (int i = 0; i < loopCount; i++) {
-                ScatterRenderItem &item = renderArray[i];
-                if (!item.isVisible() && optimizationDefault)
+            for (int n = 0; n < loopCount; n++) {
+                const int i = items ? items->at(n) : n;
+                // The stride is a power of four, and the selected item is always drawn
+                if ((n & (stride - 1)) && !(selectedSeries && m_selectedItemIndex == i))
+                    continue;
+                if (optimizationDefault && !renderArray.isVisible(i))
                     continue;
+                const QVector3D &translation = renderArray.translation(i);
 
                 QMatrix4x4 modelMatrix;
                 QMatrix4x4 MVPMatrix;
                 QMatrix4x4 itModelMatrix;
 
                 if (optimizationDefault) {
-                    modelMatrix.translate(item.translation());
+                    modelMatrix.translate(translation);
                     if (!drawingPoints) {
-                        if (!seriesRotation.isIdentity() || !item.rotation().isIdentity()) {
-                            QQuaternion totalRotation = seriesRotation * item.rotation();
+                        const QQuaternion itemRotation = renderArray.rotation(i);
+                        if (!seriesRotation.isIdentity() || !itemRotation.isIdentity()) {
+                            QQuaternion totalRotation = seriesRotation * itemRotation;
                             modelMatrix.rotate(totalRotation);
                             itModelMatrix.rotate(totalRotation);
                         }
@@ -953,7 +1064,7 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                     if (rangeGradientPoints) {
                         // Drawing points with range gradient
                         // Get color from gradient based on items y position converted to percent
-                        int position = ((item.translation().y() + m_scaleY) * rangeGradientYScaler) * gradientImageHeight;
+                        int position = ((translation.y() + m_scaleY) * rangeGradientYScaler) * gradientImageHeight;
                         position = qMin(maxGradientPositition, position); // clamp to edge
                         dotColor = Utils::vectorFromColor(
                                     cache->gradientImage().pixel(0, position));
@@ -974,8 +1085,9 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                     else
                         gradientTexture = cache->singleHighlightGradientTexture();
                     lightStrength = m_cachedTheme->highlightLightStrength();
-                    // Save the reference to the item to be used in label drawing
-                    selectedItem = &item;
+                    // Save the item to be used in label drawing
+                    selectedItem.setTranslation(translation);
+                    selectedItemCache = cache;
                     dotSelectionFound = true;
                     // Save selected item size (adjusted with font size) for selection label
                     // positioning
@@ -994,7 +1106,7 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                     dotShader->setUniformValue(dotShader->color(), dotColor);
                 } else if (colorStyle == Q3DTheme::ColorStyleRangeGradient) {
                     dotShader->setUniformValue(dotShader->gradientMin(),
-                                               (item.translation().y() + m_scaleY)
+                                               (translation.y() + m_scaleY)
                                                * rangeGradientYScaler);
                 }
                 if (m_cachedShadowQuality > QAbstract3DGraph::ShadowQualityNone && !m_isOpenGLES) {
@@ -1015,10 +1127,13 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                         }
                     } else {
                         // Draw the object
-                        if (optimizationDefault)
+                        if (optimizationDefault) {
                             m_drawer->drawPoint(dotShader);
-                        else
-                            m_drawer->drawPoints(dotShader, cache->bufferPoints(), gradientTexture);
+                        } else {
+                            drawPointSprites(dotShader, cache, MVPMatrix,
+                                             itemSize * activeCamera->zoomLevel(),
+                                             rangeGradientPoints ? gradientTexture : 0);
+                        }
                     }
                 } else {
                     if (!drawingPoints) {
@@ -1031,10 +1146,13 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                             m_drawer->drawObject(dotShader, cache->bufferObject(), gradientTexture);
                     } else {
                         // Draw the object
-                        if (optimizationDefault)
+                        if (optimizationDefault) {
                             m_drawer->drawPoint(dotShader);
-                        else
-                            m_drawer->drawPoints(dotShader, cache->bufferPoints(), gradientTexture);
+                        } else {
+                            drawPointSprites(dotShader, cache, MVPMatrix,
+                                             itemSize * activeCamera->zoomLevel(),
+                                             rangeGradientPoints ? gradientTexture : 0);
+                        }
                     }
                 }
             }
@@ -1043,8 +1161,10 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
             // Draw the selected item on static optimization
             if (!optimizationDefault && selectedSeries
                     && m_selectedItemIndex != Scatter3DController::invalidSelectionIndex()) {
-                ScatterRenderItem &item = renderArray[m_selectedItemIndex];
-                if (item.isVisible()) {
+                if (cache->translationsDirty())
+                    updateItemTranslation(renderArray, m_selectedItemIndex);
+                const QVector3D &translation = renderArray.translation(m_selectedItemIndex);
+                if (renderArray.isVisible(m_selectedItemIndex)) {
                     ShaderHelper *selectionShader;
                     if (drawingPoints) {
                         selectionShader = pointSelectionShader;
@@ -1061,10 +1181,11 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                     QMatrix4x4 modelMatrix;
                     QMatrix4x4 itModelMatrix;
 
-                    modelMatrix.translate(item.translation());
+                    modelMatrix.translate(translation);
                     if (!drawingPoints) {
-                        if (!seriesRotation.isIdentity() || !item.rotation().isIdentity()) {
-                            QQuaternion totalRotation = seriesRotation * item.rotation();
+                        const QQuaternion itemRotation = renderArray.rotation(m_selectedItemIndex);
+                        if (!seriesRotation.isIdentity() || !itemRotation.isIdentity()) {
+                            QQuaternion totalRotation = seriesRotation * itemRotation;
                             modelMatrix.rotate(totalRotation);
                             itModelMatrix.rotate(totalRotation);
                         }
@@ -1093,8 +1214,9 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                     else
                         gradientTexture = cache->singleHighlightGradientTexture();
                     GLfloat lightStrength = m_cachedTheme->highlightLightStrength();
-                    // Save the reference to the item to be used in label drawing
-                    selectedItem = &item;
+                    // Save the item to be used in label drawing
+                    selectedItem.setTranslation(translation);
+                    selectedItemCache = cache;
                     dotSelectionFound = true;
                     // Save selected item size (adjusted with font size) for selection label
                     // positioning
@@ -1116,7 +1238,7 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                                 selectionShader->setUniformValue(selectionShader->gradientHeight(),
                                                                  0.0f);
                                 selectionShader->setUniformValue(selectionShader->gradientMin(),
-                                                                 (item.translation().y() + m_scaleY)
+                                                                 (translation.y() + m_scaleY)
                                                                  * rangeGradientYScaler);
                             }
                         }
@@ -1590,14 +1712,14 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
 
     // Handle selection clearing and selection label drawing
     if (!dotSelectionFound) {
-        // We have no ownership, don't delete. Just NULL the pointer.
-        m_selectedItem = NULL;
+        m_labelSeriesCache = 0;
+        m_labelItemIndex = -1;
     } else {
         glDisable(GL_DEPTH_TEST);
         // Draw the selection label
         LabelItem &labelItem = selectionLabelItem();
-        if (m_selectedItem != selectedItem || m_updateLabels
-                || !labelItem.textureId() || m_selectionLabelDirty) {
+        if (m_labelSeriesCache != selectedItemCache || m_labelItemIndex != m_selectedItemIndex
+                || m_updateLabels || !labelItem.textureId() || m_selectionLabelDirty) {
             QString labelText = selectionLabel();
             if (labelText.isNull() || m_selectionLabelDirty) {
                 labelText = m_selectedSeriesCache->itemLabel();
@@ -1605,10 +1727,11 @@ void Scatter3DRenderer::drawScene(const GLuint defaultFboHandle)
                 m_selectionLabelDirty = false;
             }
             m_drawer->generateLabelItem(labelItem, labelText);
-            m_selectedItem = selectedItem;
+            m_labelSeriesCache = selectedItemCache;
+            m_labelItemIndex = m_selectedItemIndex;
         }
 
-        m_drawer->drawLabel(*selectedItem, labelItem, viewMatrix, projectionMatrix,
+        m_drawer->drawLabel(selectedItem, labelItem, viewMatrix, projectionMatrix,
                             zeroVector, identityQuaternion, selectedItemSize, m_cachedSelectionMode,
                             m_labelShader, m_labelObj, activeCamera, true, false,
                             Drawer::LabelOver);
@@ -2124,6 +2247,14 @@ void Scatter3DRenderer::drawLabels(bool drawSelection, const Q3DCamera *activeCa
 
 void Scatter3DRenderer::updateSelectedItem(int index, QScatter3DSeries *series)
 {
+    if (m_dataUpdatesPending) {
+        // The index is validated against the render items, so wait for the data updates
+        m_selectionPending = true;
+        m_pendingSelectedItemIndex = index;
+        m_pendingSelectedSeries = series;
+        return;
+    }
+
     m_selectionDirty = true;
     m_selectionLabelDirty = true;
     m_selectedSeriesCache =
@@ -2144,7 +2275,8 @@ void Scatter3DRenderer::updateSelectedItem(int index, QScatter3DSeries *series)
 
             if (m_cachedOptimizationHint.testFlag(QAbstract3DGraph::OptimizationStatic)
                     && m_selectedSeriesCache->mesh() == QAbstract3DSeries::MeshPoint) {
-                m_selectedSeriesCache->bufferPoints()->pushPoint(m_selectedItemIndex);
+                m_selectedSeriesCache->bufferPoints()->pushPoint(m_selectedSeriesCache,
+                                                                 m_selectedItemIndex);
                 m_oldSelectedSeriesCache = m_selectedSeriesCache;
             }
         }
@@ -2219,10 +2351,10 @@ void Scatter3DRenderer::fixMeshFileName(QString &fileName, QAbstract3DSeries::Me
     }
 }
 
-void Scatter3DRenderer::calculateTranslation(ScatterRenderItem &item)
+void Scatter3DRenderer::calculateTranslation(ScatterRenderItemArray &renderArray, int index)
 {
     // We need to normalize translations
-    const QVector3D &pos = item.position();
+    const QVector3D &pos = renderArray.position(index);
     float xTrans;
     float yTrans = m_axisCacheY.positionAt(pos.y());
     float zTrans;
@@ -2232,7 +2364,28 @@ void Scatter3DRenderer::calculateTranslation(ScatterRenderItem &item)
         xTrans = m_axisCacheX.positionAt(pos.x());
         zTrans = m_axisCacheZ.positionAt(pos.z());
     }
-    item.setTranslation(QVector3D(xTrans, yTrans, zTrans));
+    renderArray.setTranslation(index, QVector3D(xTrans, yTrans, zTrans));
+}
+
+void Scatter3DRenderer::updateItemTranslation(ScatterRenderItemArray &renderArray, int index)
+{
+    const QVector3D &dotPos = renderArray.position(index);
+    renderArray.setVisible(index, (dotPos.x() >= m_axisCacheX.min()
+                                   && dotPos.x() <= m_axisCacheX.max())
+                           && (dotPos.y() >= m_axisCacheY.min()
+                               && dotPos.y() <= m_axisCacheY.max())
+                           && (dotPos.z() >= m_axisCacheZ.min()
+                               && dotPos.z() <= m_axisCacheZ.max()));
+    calculateTranslation(renderArray, index);
+}
+
+void Scatter3DRenderer::updateTranslations(ScatterSeriesRenderCache *cache)
+{
+    ScatterRenderItemArray &renderArray = cache->renderArray();
+    const int renderArraySize = renderArray.size();
+    for (int i = 0; i < renderArraySize; i++)
+        updateItemTranslation(renderArray, i);
+    cache->setTranslationsDirty(false);
 }
 
 void Scatter3DRenderer::calculateSceneScalingFactors()
@@ -2339,6 +2492,7 @@ void Scatter3DRenderer::initSelectionShader()
 void Scatter3DRenderer::initSelectionBuffer()
 {
     m_textureHelper->deleteTexture(&m_selectionTexture);
+    m_selectionBufferValid = false;
 
     if (m_primarySubViewport.size().isEmpty())
         return;
@@ -2397,13 +2551,241 @@ void Scatter3DRenderer::initBackgroundShaders(const QString &vertexShader,
     m_backgroundShader->initialize();
 }
 
-void Scatter3DRenderer::initStaticPointShaders(const QString &vertexShader,
-                                               const QString &fragmentShader)
+void Scatter3DRenderer::initPointSpriteShaders()
 {
-    if (m_staticGradientPointShader)
-        delete m_staticGradientPointShader;
-    m_staticGradientPointShader = new ShaderHelper(this, vertexShader, fragmentShader);
-    m_staticGradientPointShader->initialize();
+    delete m_pointSpriteShader;
+    m_pointSpriteShader = new ShaderHelper(this, QStringLiteral(":/shaders/vertexPointSprite"),
+                                           QStringLiteral(":/shaders/fragmentPointSprite"));
+    m_pointSpriteShader->initialize();
+
+    delete m_pointSpriteGradientShader;
+    m_pointSpriteGradientShader =
+            new ShaderHelper(this, QStringLiteral(":/shaders/vertexPointSprite"),
+                             QStringLiteral(":/shaders/fragmentPointSpriteGradient"));
+    m_pointSpriteGradientShader->initialize();
+
+    if (!m_isOpenGLES) {
+        delete m_pointSpriteDepthShader;
+        m_pointSpriteDepthShader =
+                new ShaderHelper(this, QStringLiteral(":/shaders/vertexPointSprite"),
+                                 QStringLiteral(":/shaders/fragmentPointSpriteDepth"));
+        m_pointSpriteDepthShader->initialize();
+    }
+}
+
+void Scatter3DRenderer::drawPointSprites(ShaderHelper *shader, ScatterSeriesRenderCache *cache,
+                                         const QMatrix4x4 &MVPMatrix, float pointSize,
+                                         GLuint gradientTexture)
+{
+    // The size applies at the center of the graph, and the points further away get smaller
+    shader->setUniformValue(shader->pointSize(), pointSize * MVPMatrix(3, 3));
+    shader->setUniformValue(shader->minBounds(), QVector3D(m_axisCacheX.min(),
+                                                           m_axisCacheY.min(),
+                                                           m_axisCacheZ.min()));
+    shader->setUniformValue(shader->maxBounds(), QVector3D(m_axisCacheX.max(),
+                                                           m_axisCacheY.max(),
+                                                           m_axisCacheZ.max()));
+    shader->setUniformValue(shader->gradientMin(), 0.5f);
+    shader->setUniformValue(shader->gradientHeight(), 0.5f / m_scaleY);
+    if (cache->bufferPoints()->hasDataPositions()) {
+        setAxisMappingUniforms(shader);
+    } else {
+        // The buffer holds translations, and the hidden items are moved out of any bounds
+        shader->setUniformValue(shader->minBounds(), -unboundedPosition);
+        shader->setUniformValue(shader->maxBounds(), unboundedPosition);
+        shader->setUniformValue(shader->axisMin(), zeroVector);
+        shader->setUniformValue(shader->axisRange(), oneVector);
+        shader->setUniformValue(shader->axisLog(), zeroVector);
+        shader->setUniformValue(shader->axisScale(), oneVector);
+        shader->setUniformValue(shader->axisOffset(), zeroVector);
+        shader->setUniformValue(shader->polarRadius(), 0.0f);
+    }
+#if !QT_CONFIG(opengles2)
+    if (!m_isOpenGLES)
+        glEnable(GL_POINT_SPRITE);
+#endif
+    m_drawer->drawPoints(shader, cache->bufferPoints(), gradientTexture);
+#if !QT_CONFIG(opengles2)
+    if (!m_isOpenGLES)
+        glDisable(GL_POINT_SPRITE);
+#endif
+}
+
+bool Scatter3DRenderer::isAxisMappingInShader() const
+{
+    // Custom formatters may map the values in any way, so only the built-in mappings are
+    // done in the vertex shader
+    const AxisRenderCache *axisCaches[] = { &m_axisCacheX, &m_axisCacheY, &m_axisCacheZ };
+    for (const AxisRenderCache *axisCache : axisCaches) {
+        const QValue3DAxisFormatter *formatter = axisCache->formatter();
+        if (!formatter
+                || (formatter->metaObject() != &QValue3DAxisFormatter::staticMetaObject
+                    && formatter->metaObject() != &QLogValue3DAxisFormatter::staticMetaObject)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Scatter3DRenderer::setAxisMappingUniforms(ShaderHelper *shader)
+{
+    // Matches AxisRenderCache::positionAt() and calculatePolarXZ()
+    AxisRenderCache *axisCaches[] = { &m_axisCacheX, &m_axisCacheY, &m_axisCacheZ };
+    QVector3D axisMin;
+    QVector3D axisRange;
+    QVector3D axisLog;
+    QVector3D axisScale;
+    QVector3D axisOffset;
+    for (int i = 0; i < 3; i++) {
+        AxisRenderCache *axisCache = axisCaches[i];
+        const QValue3DAxisFormatter *formatter = axisCache->formatter();
+        float min = formatter->valueAt(0.0f);
+        float max = formatter->valueAt(1.0f);
+        if (formatter->metaObject() == &QLogValue3DAxisFormatter::staticMetaObject) {
+            axisLog[i] = 1.0f;
+            min = float(qLn(qreal(min)));
+            max = float(qLn(qreal(max)));
+        }
+        axisMin[i] = min;
+        axisRange[i] = max - min;
+        if (axisCache->reversed()) {
+            axisScale[i] = -axisCache->scale();
+            axisOffset[i] = axisCache->scale() + axisCache->translate();
+        } else {
+            axisScale[i] = axisCache->scale();
+            axisOffset[i] = axisCache->translate();
+        }
+    }
+    shader->setUniformValue(shader->axisMin(), axisMin);
+    shader->setUniformValue(shader->axisRange(), axisRange);
+    shader->setUniformValue(shader->axisLog(), axisLog);
+    shader->setUniformValue(shader->axisScale(), axisScale);
+    shader->setUniformValue(shader->axisOffset(), axisOffset);
+    shader->setUniformValue(shader->polarRadius(), m_polarGraph ? m_polarRadius : 0.0f);
+}
+
+// Returns the number of aggregation cells per axis for the current view size and zoom level,
+// or zero when the items are drawn individually
+int Scatter3DRenderer::aggregationResolution() const
+{
+    const float viewSize = float(qMax(m_primarySubViewport.width(),
+                                      m_primarySubViewport.height()));
+    const float cells = viewSize * m_cachedScene->activeCamera()->zoomLevel()
+            / (100.0f * aggregationCellPixels);
+    // Power of two resolutions avoid binning the items again on every zoom step
+    const int resolution = int(qNextPowerOfTwo(quint32(qMax(cells, 1.0f))));
+    return resolution > maxAggregationResolution ? 0 : resolution;
+}
+
+void Scatter3DRenderer::updateAggregation()
+{
+    const int resolution = aggregationResolution();
+    const QVector3D extent = m_polarGraph ? QVector3D(m_polarRadius, m_scaleY, m_polarRadius)
+                                          : QVector3D(m_scaleX, m_scaleY, m_scaleZ);
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        ScatterSeriesRenderCache *cache = static_cast<ScatterSeriesRenderCache *>(baseCache);
+        ScatterAggregator *aggregator = cache->aggregator();
+        if (!aggregator || !cache->isVisible())
+            continue;
+        if (!resolution) {
+            if (aggregator->isActive())
+                aggregator->clear();
+        } else if (aggregator->resolution() != resolution || aggregator->extent() != extent) {
+            aggregator->build(cache->renderArray(), resolution, extent);
+        }
+    }
+}
+
+// Returns the items to draw for the series while it is aggregated, or null when all the items
+// are drawn
+const QList<int> *Scatter3DRenderer::aggregatedItems(ScatterSeriesRenderCache *cache) const
+{
+    if (m_cachedOptimizationHint.testFlag(QAbstract3DGraph::OptimizationStatic)
+            || !cache->aggregator() || !cache->aggregator()->isActive()) {
+        return 0;
+    }
+    return &cache->aggregator()->representatives();
+}
+
+void Scatter3DRenderer::updateCullingGrids()
+{
+    const QVector3D extent = m_polarGraph ? QVector3D(m_polarRadius, m_scaleY, m_polarRadius)
+                                          : QVector3D(m_scaleX, m_scaleY, m_scaleZ);
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        ScatterSeriesRenderCache *cache = static_cast<ScatterSeriesRenderCache *>(baseCache);
+        ScatterAggregator *grid = cache->cullingGrid();
+        if (cache->isVisible() && (!grid->isActive() || grid->extent() != extent))
+            grid->build(cache->renderArray(), cullingGridResolution, extent);
+    }
+}
+
+// Returns the items of the series to draw in a pass, or null when all the items are drawn.
+// Whole cells of the culling grid are tested first, and single items only in the cells that
+// intersect the frustum. The forced item is included even if it is culled.
+const QList<int> *Scatter3DRenderer::visibleItems(ScatterSeriesRenderCache *cache,
+                                                  const Frustum &frustum, float radius,
+                                                  int forcedItem)
+{
+    if (m_cachedOptimizationHint.testFlag(QAbstract3DGraph::OptimizationStatic))
+        return 0;
+
+    const ScatterRenderItemArray &renderArray = cache->renderArray();
+    const QList<int> *aggregate = aggregatedItems(cache);
+    const ScatterAggregator *grid = cache->cullingGrid();
+    if (!aggregate && !grid->isActive())
+        return 0;
+
+    m_visibleItems.clear();
+    bool forcedItemFound = forcedItem < 0 || forcedItem >= renderArray.size();
+    int candidates = 0;
+    if (aggregate) {
+        // There is at most one representative per cell, so they are tested one by one
+        candidates = aggregate->size();
+        for (int index : *aggregate) {
+            if (frustum.intersectsSphere(renderArray.translation(index), radius)) {
+                m_visibleItems.append(index);
+                if (index == forcedItem)
+                    forcedItemFound = true;
+            }
+        }
+    } else {
+        const QHash<quint64, int> &cells = grid->cells();
+        const QVector3D margin(radius, radius, radius);
+        QList<Frustum::Containment> containments;
+        containments.reserve(cells.size());
+        bool allInside = true;
+        for (auto it = cells.cbegin(); it != cells.cend(); ++it) {
+            QVector3D minimum;
+            QVector3D maximum;
+            grid->cellBounds(it.key(), minimum, maximum);
+            containments.append(frustum.containsBox(minimum - margin, maximum + margin));
+            if (containments.last() != Frustum::Inside)
+                allInside = false;
+        }
+        if (allInside)
+            return 0;
+
+        candidates = grid->binnedItemCount();
+        int cell = 0;
+        for (auto it = cells.cbegin(); it != cells.cend(); ++it, ++cell) {
+            const Frustum::Containment containment = containments.at(cell);
+            if (containment == Frustum::Outside)
+                continue;
+            for (int index = it.value(); index >= 0; index = grid->nextItem(index)) {
+                if (containment == Frustum::Inside
+                        || frustum.intersectsSphere(renderArray.translation(index), radius)) {
+                    m_visibleItems.append(index);
+                    if (index == forcedItem)
+                        forcedItemFound = true;
+                }
+            }
+        }
+    }
+    m_frameStatistics.culledItems += candidates - m_visibleItems.size();
+
+    if (!forcedItemFound)
+        m_visibleItems.append(forcedItem);
+    return &m_visibleItems;
 }
 
 void Scatter3DRenderer::selectionColorToSeriesAndIndex(const QVector4D &color,
@@ -2464,22 +2846,16 @@ void Scatter3DRenderer::selectionColorToSeriesAndIndex(const QVector4D &color,
 }
 
 void Scatter3DRenderer::updateRenderItem(const QScatterDataItem &dataItem,
-                                         ScatterRenderItem &renderItem)
+                                         ScatterRenderItemArray &renderArray, int index)
 {
-    QVector3D dotPos = dataItem.position();
-    if ((dotPos.x() >= m_axisCacheX.min() && dotPos.x() <= m_axisCacheX.max() )
-            && (dotPos.y() >= m_axisCacheY.min() && dotPos.y() <= m_axisCacheY.max())
-            && (dotPos.z() >= m_axisCacheZ.min() && dotPos.z() <= m_axisCacheZ.max())) {
-        renderItem.setPosition(dotPos);
-        renderItem.setVisible(true);
-        if (!dataItem.rotation().isIdentity())
-            renderItem.setRotation(dataItem.rotation().normalized());
-        else
-            renderItem.setRotation(identityQuaternion);
-        calculateTranslation(renderItem);
-    } else {
-        renderItem.setVisible(false);
-    }
+    // Items outside the axis ranges are stored too, so that axis changes can be applied
+    // without the data
+    renderArray.setPosition(index, dataItem.position());
+    if (!dataItem.rotation().isIdentity())
+        renderArray.setRotation(index, dataItem.rotation().normalized());
+    else
+        renderArray.setRotation(index, identityQuaternion);
+    updateItemTranslation(renderArray, index);
 }
 
 QVector3D Scatter3DRenderer::convertPositionToTranslation(const QVector3D &position,
@@ -17,6 +17,7 @@
 #include "datavisualizationglobal_p.h"
 #include "scatter3dcontroller_p.h"
 #include "abstract3drenderer_p.h"
+#include "abstractrenderitem_p.h"
 #include "scatterrenderitem_p.h"
 
 QT_FORWARD_DECLARE_CLASS(QSizeF)
@@ -27,6 +28,7 @@ class ShaderHelper;
 class Q3DScene;
 class ScatterSeriesRenderCache;
 class QScatterDataItem;
+class Frustum;
 
 class Q_DATAVISUALIZATION_EXPORT Scatter3DRenderer : public Abstract3DRenderer
 {
@@ -34,7 +36,9 @@ class Q_DATAVISUALIZATION_EXPORT Scatter3DRenderer : public Abstract3DRenderer
 
 private:
     // Internal state
-    ScatterRenderItem *m_selectedItem; // points to renderitem array
+    // Series and index of the item the selection label was last generated for
+    ScatterSeriesRenderCache *m_labelSeriesCache;
+    int m_labelItemIndex;
     bool m_updateLabels;
     ShaderHelper *m_dotShader;
     ShaderHelper *m_dotGradientShader;
@@ -44,7 +48,9 @@ private:
     ShaderHelper *m_depthShader;
     ShaderHelper *m_selectionShader;
     ShaderHelper *m_backgroundShader;
-    ShaderHelper *m_staticGradientPointShader;
+    ShaderHelper *m_pointSpriteShader;
+    ShaderHelper *m_pointSpriteGradientShader;
+    ShaderHelper *m_pointSpriteDepthShader;
     GLuint m_bgrTexture;
     GLuint m_selectionTexture;
     GLuint m_depthFrameBuffer;
@@ -59,7 +65,7 @@ private:
     ScatterSeriesRenderCache *m_selectedSeriesCache;
     ScatterSeriesRenderCache *m_oldSelectedSeriesCache;
     GLfloat m_dotSizeScale;
-    ScatterRenderItem m_dummyRenderItem;
+    AbstractRenderItem m_dummyRenderItem;
     GLfloat m_maxItemSize;
     int m_clickedIndex;
     bool m_havePointSeries;
@@ -67,6 +73,16 @@ private:
     bool m_haveUniformColorMeshSeries;
     bool m_haveGradientMeshSeries;
 
+    // Data updates waiting for applyDataUpdates()
+    bool m_dataSnapshotPending;
+    QList<Scatter3DController::ChangeItem> m_pendingItems;
+    bool m_selectionPending;
+    int m_pendingSelectedItemIndex;
+    QScatter3DSeries *m_pendingSelectedSeries;
+
+    // Items of the series being drawn that are inside the frustum of the pass
+    QList<int> m_visibleItems;
+
 public:
     explicit Scatter3DRenderer(Scatter3DController *controller);
     ~Scatter3DRenderer();
@@ -98,6 +114,8 @@ protected:
     void initializeOpenGL() override;
     void fixCameraTarget(QVector3D &target) override;
     void getVisibleItemBounds(QVector3D &minBounds, QVector3D &maxBounds) override;
+    void applyDataUpdates() override;
+    void handleAxisMappingChanged() override;
 
 private:
     void initShaders(const QString &vertexShader, const QString &fragmentShader) override;
@@ -117,17 +135,33 @@ private:
     void loadBackgroundMesh();
     void initSelectionShader();
     void initBackgroundShaders(const QString &vertexShader, const QString &fragmentShader) override;
-    void initStaticPointShaders(const QString &vertexShader, const QString &fragmentShader);
+    void initPointSpriteShaders();
+    void drawPointSprites(ShaderHelper *shader, ScatterSeriesRenderCache *cache,
+                          const QMatrix4x4 &MVPMatrix, float pointSize, GLuint gradientTexture);
     void initSelectionBuffer() override;
     void initDepthShader();
     void updateDepthBuffer() override;
     void initPointShader();
-    void calculateTranslation(ScatterRenderItem &item);
+    void calculateTranslation(ScatterRenderItemArray &renderArray, int index);
+    void updateItemTranslation(ScatterRenderItemArray &renderArray, int index);
+    void updateTranslations(ScatterSeriesRenderCache *cache);
+    bool isAxisMappingInShader() const;
+    void setAxisMappingUniforms(ShaderHelper *shader);
+    int aggregationResolution() const;
+    void updateAggregation();
+    const QList<int> *aggregatedItems(ScatterSeriesRenderCache *cache) const;
+    void updateCullingGrids();
+    const QList<int> *visibleItems(ScatterSeriesRenderCache *cache, const Frustum &frustum,
+                                   float radius, int forcedItem = -1);
     void calculateSceneScalingFactors();
 
+    void applyData();
+    void applyItems(const QList<Scatter3DController::ChangeItem> &items);
+
     void selectionColorToSeriesAndIndex(const QVector4D &color, int &index,
                                         QAbstract3DSeries *&series);
-    inline void updateRenderItem(const QScatterDataItem &dataItem, ScatterRenderItem &renderItem);
+    inline void updateRenderItem(const QScatterDataItem &dataItem,
+                                 ScatterRenderItemArray &renderArray, int index);
 
     Q_DISABLE_COPY(Scatter3DRenderer)
 };
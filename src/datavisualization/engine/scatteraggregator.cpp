@@ -0,0 +1,154 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "scatteraggregator_p.h"
+#include "scatterrenderitem_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// Cell key of items that are not binned
+const quint64 noCell = ~quint64(0);
+const int cellKeyBits = 21;
+
+ScatterAggregator::ScatterAggregator()
+    : m_resolution(0),
+      m_binnedItemCount(0),
+      m_representativesDirty(false)
+{
+}
+
+ScatterAggregator::~ScatterAggregator()
+{
+}
+
+void ScatterAggregator::build(const ScatterRenderItemArray &renderArray, int resolution,
+                              const QVector3D &extent)
+{
+    Q_ASSERT(resolution > 0 && resolution < (1 << cellKeyBits));
+
+    m_resolution = resolution;
+    m_extent = extent;
+    for (int i = 0; i < 3; i++)
+        m_cellScale[i] = extent[i] > 0.0f ? float(resolution) / (2.0f * extent[i]) : 0.0f;
+
+    const int size = renderArray.size();
+    m_itemCells.fill(noCell, size);
+    m_next.fill(-1, size);
+    m_previous.fill(-1, size);
+    m_cellHeads.clear();
+    m_binnedItemCount = 0;
+    for (int i = 0; i < size; i++)
+        insertItem(renderArray, i);
+    m_representativesDirty = true;
+}
+
+void ScatterAggregator::clear()
+{
+    m_resolution = 0;
+    m_itemCells.clear();
+    m_next.clear();
+    m_previous.clear();
+    m_cellHeads.clear();
+    m_binnedItemCount = 0;
+    m_representatives.clear();
+    m_representativesDirty = false;
+}
+
+void ScatterAggregator::updateItem(const ScatterRenderItemArray &renderArray, int index)
+{
+    if (!isActive() || index >= m_itemCells.size())
+        return;
+
+    const quint64 key = renderArray.isVisible(index)
+            ? cellKey(renderArray.translation(index)) : noCell;
+    if (key == m_itemCells.at(index))
+        return;
+
+    removeItem(index);
+    insertItem(renderArray, index);
+}
+
+const QList<int> &ScatterAggregator::representatives()
+{
+    if (m_representativesDirty) {
+        m_representatives = m_cellHeads.values();
+        std::sort(m_representatives.begin(), m_representatives.end());
+        m_representativesDirty = false;
+    }
+    return m_representatives;
+}
+
+void ScatterAggregator::cellBounds(quint64 key, QVector3D &minimum, QVector3D &maximum) const
+{
+    const quint64 mask = (quint64(1) << cellKeyBits) - 1;
+    const QVector3D cell(float((key >> (2 * cellKeyBits)) & mask),
+                         float((key >> cellKeyBits) & mask),
+                         float(key & mask));
+    const QVector3D cellSize = 2.0f * m_extent / float(m_resolution);
+    minimum = cell * cellSize - m_extent;
+    maximum = minimum + cellSize;
+}
+
+quint64 ScatterAggregator::cellKey(const QVector3D &translation) const
+{
+    const QVector3D cell = (translation + m_extent) * m_cellScale;
+    const quint64 x = quint64(qBound(0, int(cell.x()), m_resolution - 1));
+    const quint64 y = quint64(qBound(0, int(cell.y()), m_resolution - 1));
+    const quint64 z = quint64(qBound(0, int(cell.z()), m_resolution - 1));
+    return (x << (2 * cellKeyBits)) | (y << cellKeyBits) | z;
+}
+
+void ScatterAggregator::insertItem(const ScatterRenderItemArray &renderArray, int index)
+{
+    if (!renderArray.isVisible(index))
+        return;
+
+    const quint64 key = cellKey(renderArray.translation(index));
+    m_itemCells[index] = key;
+    m_binnedItemCount++;
+
+    auto head = m_cellHeads.find(key);
+    if (head == m_cellHeads.end()) {
+        m_cellHeads.insert(key, index);
+        m_representativesDirty = true;
+    } else {
+        // Link after the head, so that the representative of the cell does not change
+        const int headIndex = head.value();
+        const int next = m_next.at(headIndex);
+        m_next[index] = next;
+        m_previous[index] = headIndex;
+        if (next >= 0)
+            m_previous[next] = index;
+        m_next[headIndex] = index;
+    }
+}
+
+void ScatterAggregator::removeItem(int index)
+{
+    const quint64 key = m_itemCells.at(index);
+    if (key == noCell)
+        return;
+
+    const int previous = m_previous.at(index);
+    const int next = m_next.at(index);
+    if (previous >= 0) {
+        m_next[previous] = next;
+    } else {
+        if (next >= 0)
+            m_cellHeads[key] = next;
+        else
+            m_cellHeads.remove(key);
+        m_representativesDirty = true;
+    }
+    if (next >= 0)
+        m_previous[next] = previous;
+
+    m_itemCells[index] = noCell;
+    m_binnedItemCount--;
+    m_next[index] = -1;
+    m_previous[index] = -1;
+}
+
+QT_END_NAMESPACE
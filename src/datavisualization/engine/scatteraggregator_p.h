@@ -0,0 +1,76 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef SCATTERAGGREGATOR_P_H
+#define SCATTERAGGREGATOR_P_H
+
+#include "datavisualizationglobal_p.h"
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+QT_BEGIN_NAMESPACE
+
+class ScatterRenderItemArray;
+
+// Bins the visible items of a scatter series into a grid of cells in scene space. The first
+// item of each occupied cell represents the cell, so that dense regions can be drawn with one
+// item per cell. The items of a cell are kept in a linked list, which allows moving single
+// items between cells without binning the whole series again. A coarse grid also serves as
+// the spatial index for frustum culling.
+class Q_DATAVISUALIZATION_EXPORT ScatterAggregator
+{
+public:
+    ScatterAggregator();
+    ~ScatterAggregator();
+
+    // Cells per axis, or zero when the items are not binned
+    inline int resolution() const { return m_resolution; }
+    inline bool isActive() const { return m_resolution > 0; }
+    // Half of the size of the binned volume on each axis, centered at the origin
+    inline const QVector3D &extent() const { return m_extent; }
+    // Number of visible items in the cells
+    inline int binnedItemCount() const { return m_binnedItemCount; }
+
+    void build(const ScatterRenderItemArray &renderArray, int resolution,
+               const QVector3D &extent);
+    void clear();
+    void updateItem(const ScatterRenderItemArray &renderArray, int index);
+
+    // Representative items in ascending order
+    const QList<int> &representatives();
+
+    // Occupied cells mapped to their first item, the rest are linked with nextItem()
+    inline const QHash<quint64, int> &cells() const { return m_cellHeads; }
+    inline int nextItem(int index) const { return m_next.at(index); }
+    void cellBounds(quint64 key, QVector3D &minimum, QVector3D &maximum) const;
+
+private:
+    quint64 cellKey(const QVector3D &translation) const;
+    void insertItem(const ScatterRenderItemArray &renderArray, int index);
+    void removeItem(int index);
+
+    int m_resolution;
+    QVector3D m_extent;
+    QVector3D m_cellScale;
+    QList<quint64> m_itemCells;
+    QList<int> m_next;
+    QList<int> m_previous;
+    QHash<quint64, int> m_cellHeads;
+    int m_binnedItemCount;
+    QList<int> m_representatives;
+    bool m_representativesDirty;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "scatterseriesrendercache_p.h"
+#include "scatteraggregator_p.h"
 #include "scatterobjectbufferhelper_p.h"
 #include "scatterpointbufferhelper_p.h"
 
@@ -17,7 +18,11 @@ ScatterSeriesRenderCache::ScatterSeriesRenderCache(QAbstract3DSeries *series,
       m_oldMeshFileName(QString()),
       m_scatterBufferObj(0),
       m_scatterBufferPoints(0),
-      m_visibilityChanged(false)
+      m_visibilityChanged(false),
+      m_translationsDirty(false),
+      m_aggregator(0),
+      m_cullingGrid(new ScatterAggregator()),
+      m_hasDataSnapshot(false)
 {
 }
 
@@ -25,13 +30,46 @@ ScatterSeriesRenderCache::~ScatterSeriesRenderCache()
 {
     delete m_scatterBufferObj;
     delete m_scatterBufferPoints;
+    delete m_aggregator;
+    delete m_cullingGrid;
 }
 
 void ScatterSeriesRenderCache::cleanup(TextureHelper *texHelper)
 {
     m_renderArray.clear();
+    releaseDataSnapshot();
+    if (m_aggregator)
+        m_aggregator->clear();
+    m_cullingGrid->clear();
 
     SeriesRenderCache::cleanup(texHelper);
 }
 
+void ScatterSeriesRenderCache::setAggregationEnabled(bool enable)
+{
+    if (enable && !m_aggregator) {
+        m_aggregator = new ScatterAggregator();
+    } else if (!enable) {
+        delete m_aggregator;
+        m_aggregator = 0;
+    }
+}
+
+void ScatterSeriesRenderCache::takeDataSnapshot()
+{
+    if (m_hasDataSnapshot)
+        return;
+
+    // The array is implicitly shared, so copying it is cheap. Any later change made to
+    // the proxy array detaches it from the snapshot.
+    m_dataSnapshot = *series()->dataProxy()->array();
+    m_hasDataSnapshot = true;
+}
+
+void ScatterSeriesRenderCache::releaseDataSnapshot()
+{
+    m_dataSnapshot.clear();
+    m_hasDataSnapshot = false;
+}
+
 QT_END_NAMESPACE
@@ -21,6 +21,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class ScatterAggregator;
 class ScatterObjectBufferHelper;
 class ScatterPointBufferHelper;
 
@@ -52,6 +53,20 @@ public:
     inline QList<int> &bufferIndices() { return m_bufferIndices; }
     inline void setVisibilityChanged(bool changed) { m_visibilityChanged = changed; }
     inline bool visibilityChanged() const { return m_visibilityChanged; }
+    // Set when the axis mapping changed but the point buffer maps it in the vertex shader, so
+    // the visibility and translations of the render items are out of date
+    inline void setTranslationsDirty(bool dirty) { m_translationsDirty = dirty; }
+    inline bool translationsDirty() const { return m_translationsDirty; }
+    // Null unless aggregation is enabled for the series
+    inline ScatterAggregator *aggregator() const { return m_aggregator; }
+    void setAggregationEnabled(bool enable);
+    // Coarse grid of the items used for frustum culling
+    inline ScatterAggregator *cullingGrid() const { return m_cullingGrid; }
+
+    void takeDataSnapshot();
+    void releaseDataSnapshot();
+    inline bool hasDataSnapshot() const { return m_hasDataSnapshot; }
+    inline const QScatterDataArray &dataSnapshot() const { return m_dataSnapshot; }
 
 protected:
     ScatterRenderItemArray m_renderArray;
@@ -65,6 +80,11 @@ protected:
     QList<int> m_updateIndices; // Used as temporary cache during item updates
     QList<int> m_bufferIndices; // Cache for mapping renderarray to mesh buffer
     bool m_visibilityChanged; // Used to detect if full buffer change needed
+    bool m_translationsDirty;
+    ScatterAggregator *m_aggregator;
+    ScatterAggregator *m_cullingGrid;
+    QScatterDataArray m_dataSnapshot; // Shares the data with the proxy array
+    bool m_hasDataSnapshot;
 };
 
 QT_END_NAMESPACE
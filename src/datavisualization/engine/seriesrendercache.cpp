@@ -169,6 +169,11 @@ void SeriesRenderCache::populate(bool newSeries)
     }
 }
 
+void SeriesRenderCache::rekeyObject()
+{
+    ObjectHelper::rekeyObjectHelper(m_renderer, m_object);
+}
+
 void SeriesRenderCache::cleanup(TextureHelper *texHelper)
 {
     ObjectHelper::releaseObjectHelper(m_renderer, m_object);
@@ -31,6 +31,7 @@ public:
 
     virtual void populate(bool newSeries);
     virtual void cleanup(TextureHelper *texHelper);
+    void rekeyObject();
 
     // NOTE: Series pointer can only be used to access the series when syncing with controller.
     // It is not guaranteed to be valid while rendering and should only be used as an identifier.
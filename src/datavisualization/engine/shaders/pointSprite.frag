@@ -0,0 +1,8 @@
+uniform highp vec4 color_mdl;
+
+void main() {
+    highp vec2 coord = 2.0 * gl_PointCoord - 1.0;
+    if (dot(coord, coord) > 1.0)
+        discard;
+    gl_FragColor = color_mdl;
+}
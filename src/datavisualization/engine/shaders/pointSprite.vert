@@ -0,0 +1,40 @@
+uniform highp mat4 MVP;
+uniform highp float pointSize;
+uniform highp vec3 minBounds;
+uniform highp vec3 maxBounds;
+// Axis mapping: logarithmic components (axisLog = 1.0) are mapped with the natural logarithm
+// before normalizing with axisMin and axisRange
+uniform highp vec3 axisMin;
+uniform highp vec3 axisRange;
+uniform highp vec3 axisLog;
+uniform highp vec3 axisScale;
+uniform highp vec3 axisOffset;
+// Non-zero for polar graphs, where x is angular and z is radial
+uniform highp float polarRadius;
+uniform highp float gradMin;
+uniform highp float gradHeight;
+
+attribute highp vec3 vertexPosition_mdl;
+
+varying highp vec2 UV;
+
+void main() {
+    highp vec3 value = mix(vertexPosition_mdl,
+                           log(max(vertexPosition_mdl, vec3(1.0e-30))), axisLog);
+    highp vec3 normalized = (value - axisMin) / axisRange;
+    highp vec3 position = normalized * axisScale + axisOffset;
+    if (polarRadius > 0.0) {
+        highp float angle = normalized.x * 6.28318531;
+        position.x = normalized.z * sin(angle) * polarRadius;
+        position.z = -normalized.z * cos(angle) * polarRadius;
+    }
+    gl_Position = MVP * vec4(position, 1.0);
+    // pointSize is the size at a clip space w of one, so points shrink with distance
+    gl_PointSize = pointSize / gl_Position.w;
+    // Items outside the axis ranges are moved outside the clip volume
+    if (any(lessThan(vertexPosition_mdl, minBounds))
+            || any(greaterThan(vertexPosition_mdl, maxBounds))) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    }
+    UV = vec2(0.0, gradMin + position.y * gradHeight);
+}
@@ -0,0 +1,6 @@
+void main() {
+    highp vec2 coord = 2.0 * gl_PointCoord - 1.0;
+    if (dot(coord, coord) > 1.0)
+        discard;
+    gl_FragDepth = gl_FragCoord.z;
+}
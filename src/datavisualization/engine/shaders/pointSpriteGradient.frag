@@ -0,0 +1,10 @@
+uniform sampler2D textureSampler;
+
+varying highp vec2 UV;
+
+void main() {
+    highp vec2 coord = 2.0 * gl_PointCoord - 1.0;
+    if (dot(coord, coord) > 1.0)
+        discard;
+    gl_FragColor = texture2D(textureSampler, UV);
+}
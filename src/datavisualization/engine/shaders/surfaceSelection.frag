@@ -0,0 +1,15 @@
+uniform highp vec3 selectionGrid;
+
+varying highp vec2 UV;
+
+void main() {
+    // Identify the data point nearest to the fragment by its index in the sample space.
+    // selectionGrid holds the column and row counts minus one, and the series id.
+    highp vec2 point = clamp(floor(UV * selectionGrid.xy + 0.5), vec2(0.0), selectionGrid.xy);
+    highp float index = point.y * (selectionGrid.x + 1.0) + point.x;
+    highp float low = mod(index, 256.0);
+    index = floor(index / 256.0);
+    highp float middle = mod(index, 256.0);
+    highp float high = floor(index / 256.0);
+    gl_FragColor = vec4(low, middle, high, selectionGrid.z) / 255.0;
+}
@@ -53,33 +53,42 @@ void Surface3DController::synchDataToRenderer()
     if (!isInitialized())
         return;
 
+    // Data snapshotted in the previous pass must be applied before new snapshots are taken,
+    // in case no frame was rendered in between
+    m_renderer->flushDataUpdates();
+
     Abstract3DController::synchDataToRenderer();
 
     // Notify changes to renderer
     if (m_changeTracker.rowsChanged) {
         m_renderer->updateRows(m_changedRows);
+        m_renderer->markFrameChanges(FrameChangeData);
         m_changeTracker.rowsChanged = false;
         m_changedRows.clear();
     }
 
     if (m_changeTracker.itemChanged) {
         m_renderer->updateItems(m_changedItems);
+        m_renderer->markFrameChanges(FrameChangeData);
         m_changeTracker.itemChanged = false;
         m_changedItems.clear();
     }
 
     if (m_changeTracker.selectedPointChanged) {
         m_renderer->updateSelectedPoint(m_selectedPoint, m_selectedSeries);
+        m_renderer->markFrameChanges(FrameChangeSelection);
         m_changeTracker.selectedPointChanged = false;
     }
 
     if (m_changeTracker.flipHorizontalGridChanged) {
         m_renderer->updateFlipHorizontalGrid(m_flipHorizontalGrid);
+        m_renderer->markFrameChanges(FrameChangeOther);
         m_changeTracker.flipHorizontalGridChanged = false;
     }
 
     if (m_changeTracker.surfaceTextureChanged) {
         m_renderer->updateSurfaceTextures(m_changedTextures);
+        m_renderer->markFrameChanges(FrameChangeOther);
         m_changeTracker.surfaceTextureChanged = false;
         m_changedTextures.clear();
     }
@@ -11,8 +11,6 @@
 
 #include <QtCore/qmath.h>
 
-static const int ID_TO_RGBA_MASK = 0xff;
-
 QT_BEGIN_NAMESPACE
 
 //#define SHOW_DEPTH_TEXTURE_SCENE
@@ -22,6 +20,18 @@ const GLfloat sliceUnits = 2.5f;
 const uint greenMultiplier = 256;
 const uint blueMultiplier = 65536;
 const uint alphaMultiplier = 16777216;
+// Number of quads per series drawn on the first frame with progressive optimization
+const int progressiveQuadBudget = 250000;
+
+// Rows covering the full width of the sample space share their data with the snapshot
+static void copySampleRow(QSurfaceDataRow &dst, const QSurfaceDataRow &src,
+                          const QRect &sampleSpace)
+{
+    if (sampleSpace.x() == 0 && sampleSpace.width() == src.size())
+        dst = src;
+    else
+        dst = src.mid(sampleSpace.x(), sampleSpace.width());
+}
 
 Surface3DRenderer::Surface3DRenderer(Surface3DController *controller)
     : Abstract3DRenderer(controller),
@@ -51,8 +61,8 @@ Surface3DRenderer::Surface3DRenderer(Surface3DController *controller)
       m_selectedPoint(Surface3DController::invalidSelectionPosition()),
       m_selectedSeries(0),
       m_clickedPosition(Surface3DController::invalidSelectionPosition()),
-      m_selectionTexturesDirty(false),
-      m_noShadowTexture(0)
+      m_noShadowTexture(0),
+      m_dataSnapshotPending(false)
 {
     // Check if flat feature is supported
     ShaderHelper tester(this, QStringLiteral(":/shaders/vertexSurfaceFlat"),
@@ -173,15 +183,51 @@ void Surface3DRenderer::getVisibleItemBounds(QVector3D &minBounds, QVector3D &ma
 }
 
 void Surface3DRenderer::updateData()
+{
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
+        if (cache->isVisible() && cache->dataDirty())
+            cache->takeDataSnapshot();
+    }
+    m_dataSnapshotPending = true;
+    m_dataUpdatesPending = true;
+}
+
+void Surface3DRenderer::applyDataUpdates()
+{
+    if (m_dataSnapshotPending) {
+        applyData();
+        m_dataSnapshotPending = false;
+    }
+    if (!m_pendingRows.isEmpty()) {
+        applyRows(m_pendingRows);
+        m_pendingRows.clear();
+    }
+    if (!m_pendingItems.isEmpty()) {
+        applyItems(m_pendingItems);
+        m_pendingItems.clear();
+    }
+
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList)
+        static_cast<SurfaceSeriesRenderCache *>(baseCache)->releaseDataSnapshot();
+}
+
+void Surface3DRenderer::takeDataSnapshot(QSurface3DSeries *series)
+{
+    SurfaceSeriesRenderCache *cache =
+            static_cast<SurfaceSeriesRenderCache *>(m_renderCacheList.value(series));
+    if (cache)
+        cache->takeDataSnapshot();
+}
+
+void Surface3DRenderer::applyData()
 {
     calculateSceneScalingFactors();
 
     foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
         SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
-        if (cache->isVisible() && cache->dataDirty()) {
-            const QSurface3DSeries *currentSeries = cache->series();
-            QSurfaceDataProxy *dataProxy = currentSeries->dataProxy();
-            const QSurfaceDataArray &array = *dataProxy->array();
+        if (cache->isVisible() && cache->dataDirty() && cache->hasDataSnapshot()) {
+            const QSurfaceDataArray &array = cache->dataSnapshot();
             QSurfaceDataArray &dataArray = cache->dataArray();
             QRect sampleSpace;
 
@@ -191,9 +237,6 @@ void Surface3DRenderer::updateData()
 
             bool dimensionsChanged = false;
             if (cache->sampleSpace() != sampleSpace) {
-                if (sampleSpace.width() >= 2)
-                    m_selectionTexturesDirty = true;
-
                 dimensionsChanged = true;
                 cache->setSampleSpace(sampleSpace);
 
@@ -206,17 +249,13 @@ void Surface3DRenderer::updateData()
                 if (dimensionsChanged) {
                     dataArray.reserve(sampleSpace.height());
                     for (int i = 0; i < sampleSpace.height(); i++)
-                        dataArray << new QSurfaceDataRow(sampleSpace.width());
-                }
-                for (int i = 0; i < sampleSpace.height(); i++) {
-                    for (int j = 0; j < sampleSpace.width(); j++) {
-                        (*(dataArray.at(i)))[j] = array.at(i + sampleSpace.y())->at(
-                                    j + sampleSpace.x());
-                    }
+                        dataArray << new QSurfaceDataRow;
                 }
+                for (int i = 0; i < sampleSpace.height(); i++)
+                    copySampleRow(*dataArray.at(i), *array.at(i + sampleSpace.y()), sampleSpace);
 
                 checkFlatSupport(cache);
-                updateObjects(cache, dimensionsChanged);
+                updateObjects(cache, array, dimensionsChanged);
                 cache->setFlatStatusDirty(false);
             } else {
                 cache->surfaceObject()->clear();
@@ -225,9 +264,6 @@ void Surface3DRenderer::updateData()
         }
     }
 
-    if (m_selectionTexturesDirty && m_cachedSelectionMode > QAbstract3DGraph::SelectionNone)
-        updateSelectionTextures();
-
     updateSelectedPoint(m_selectedPoint, m_selectedSeries);
 }
 
@@ -249,7 +285,7 @@ void Surface3DRenderer::updateSeries(const QList<QAbstract3DSeries *> &seriesLis
 
         if (cache->isFlatStatusDirty() && cache->sampleSpace().width()) {
             checkFlatSupport(cache);
-            updateObjects(cache, true);
+            updateObjects(cache, *cache->series()->dataProxy()->array(), true);
             cache->setFlatStatusDirty(false);
         }
     }
@@ -314,17 +350,28 @@ void Surface3DRenderer::updateSurfaceTextures(QList<QSurface3DSeries *> seriesLi
 
 SeriesRenderCache *Surface3DRenderer::createNewCache(QAbstract3DSeries *series)
 {
-    m_selectionTexturesDirty = true;
     return new SurfaceSeriesRenderCache(series, this);
 }
 
 void Surface3DRenderer::cleanCache(SeriesRenderCache *cache)
 {
     Abstract3DRenderer::cleanCache(cache);
-    m_selectionTexturesDirty = true;
 }
 
 void Surface3DRenderer::updateRows(const QList<Surface3DController::ChangeRow> &rows)
+{
+    const QSurface3DSeries *prevSeries = 0;
+    foreach (const Surface3DController::ChangeRow &item, rows) {
+        if (item.series != prevSeries) {
+            takeDataSnapshot(item.series);
+            prevSeries = item.series;
+        }
+    }
+    m_pendingRows.append(rows);
+    m_dataUpdatesPending = true;
+}
+
+void Surface3DRenderer::applyRows(const QList<Surface3DController::ChangeRow> &rows)
 {
     foreach (Surface3DController::ChangeRow item, rows) {
         SurfaceSeriesRenderCache *cache =
@@ -332,22 +379,15 @@ void Surface3DRenderer::updateRows(const QList<Surface3DController::ChangeRow> &
         QSurfaceDataArray &dstArray = cache->dataArray();
         const QRect &sampleSpace = cache->sampleSpace();
 
-        const QSurfaceDataArray *srcArray = 0;
-        QSurfaceDataProxy *dataProxy = item.series->dataProxy();
-        if (dataProxy)
-            srcArray = dataProxy->array();
+        const QSurfaceDataArray *srcArray = &cache->dataSnapshot();
 
         if (cache && srcArray->size() >= 2 && srcArray->at(0)->size() >= 2 &&
                 sampleSpace.width() >= 2 && sampleSpace.height() >= 2) {
-            bool updateBuffers = false;
             int sampleSpaceTop = sampleSpace.y() + sampleSpace.height();
             int row = item.row;
             if (row >= sampleSpace.y() && row <= sampleSpaceTop) {
-                updateBuffers = true;
-                for (int j = 0; j < sampleSpace.width(); j++) {
-                    (*(dstArray.at(row - sampleSpace.y())))[j] =
-                            srcArray->at(row)->at(j + sampleSpace.x());
-                }
+                copySampleRow(*dstArray.at(row - sampleSpace.y()), *srcArray->at(row),
+                              sampleSpace);
 
                 if (cache->isFlatShadingEnabled()) {
                     cache->surfaceObject()->updateCoarseRow(dstArray, row - sampleSpace.y(),
@@ -357,15 +397,32 @@ void Surface3DRenderer::updateRows(const QList<Surface3DController::ChangeRow> &
                                                             m_polarGraph);
                 }
             }
-            if (updateBuffers)
-                cache->surfaceObject()->uploadBuffers();
         }
     }
 
+    // Upload the changed vertex ranges once for all the rows
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
+        cache->surfaceObject()->uploadChangedVertices();
+    }
+
     updateSelectedPoint(m_selectedPoint, m_selectedSeries);
 }
 
 void Surface3DRenderer::updateItems(const QList<Surface3DController::ChangeItem> &points)
+{
+    const QSurface3DSeries *prevSeries = 0;
+    foreach (const Surface3DController::ChangeItem &item, points) {
+        if (item.series != prevSeries) {
+            takeDataSnapshot(item.series);
+            prevSeries = item.series;
+        }
+    }
+    m_pendingItems.append(points);
+    m_dataUpdatesPending = true;
+}
+
+void Surface3DRenderer::applyItems(const QList<Surface3DController::ChangeItem> &points)
 {
     foreach (Surface3DController::ChangeItem item, points) {
         SurfaceSeriesRenderCache *cache =
@@ -373,22 +430,17 @@ void Surface3DRenderer::updateItems(const QList<Surface3DController::ChangeItem>
         QSurfaceDataArray &dstArray = cache->dataArray();
         const QRect &sampleSpace = cache->sampleSpace();
 
-        const QSurfaceDataArray *srcArray = 0;
-        QSurfaceDataProxy *dataProxy = item.series->dataProxy();
-        if (dataProxy)
-            srcArray = dataProxy->array();
+        const QSurfaceDataArray *srcArray = &cache->dataSnapshot();
 
         if (cache && srcArray->size() >= 2 && srcArray->at(0)->size() >= 2 &&
                 sampleSpace.width() >= 2 && sampleSpace.height() >= 2) {
             int sampleSpaceTop = sampleSpace.y() + sampleSpace.height();
             int sampleSpaceRight = sampleSpace.x() + sampleSpace.width();
-            bool updateBuffers = false;
             // Note: Point is (row, column), samplespace is (columns x rows)
             QPoint point = item.point;
 
             if (point.x() <= sampleSpaceTop && point.x() >= sampleSpace.y() &&
                     point.y() <= sampleSpaceRight && point.y() >= sampleSpace.x()) {
-                updateBuffers = true;
                 int x = point.y() - sampleSpace.x();
                 int y = point.x() - sampleSpace.y();
                 (*(dstArray.at(y)))[x] = srcArray->at(point.x())->at(point.y());
@@ -398,10 +450,12 @@ void Surface3DRenderer::updateItems(const QList<Surface3DController::ChangeItem>
                 else
                     cache->surfaceObject()->updateSmoothItem(dstArray, y, x, m_polarGraph);
             }
-            if (updateBuffers)
-                cache->surfaceObject()->uploadBuffers();
         }
+    }
 
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
+        cache->surfaceObject()->uploadChangedVertices();
     }
 
     updateSelectedPoint(m_selectedPoint, m_selectedSeries);
@@ -918,7 +972,7 @@ void Surface3DRenderer::drawSlicedScene()
     if (m_cachedTheme->isGridEnabled()) {
         ShaderHelper *lineShader;
         if (m_isOpenGLES)
-            lineShader = m_selectionShader; // Plain color shader for GL_LINES
+            lineShader = m_surfaceGridShader; // Plain color shader for GL_LINES
         else
             lineShader = m_backgroundShader;
 
@@ -1092,6 +1146,23 @@ void Surface3DRenderer::drawScene(GLuint defaultFboHandle)
     GLfloat backgroundRotation = 0;
     QVector4D lightColor = Utils::vectorFromColor(m_cachedTheme->lightColor());
 
+    // Large smooth surfaces are first drawn with a coarser mesh when progressive
+    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+        SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
+        const QRect &sampleSpace = cache->sampleSpace();
+        int step = 1;
+        if (!cache->isFlatShadingEnabled() && sampleSpace.width() >= 2
+                && sampleSpace.height() >= 2) {
+            // The stride is a power of four, so the step per dimension is its square root
+            const int stride = progressiveStride((sampleSpace.width() - 1)
+                                                 * (sampleSpace.height() - 1),
+                                                 progressiveQuadBudget);
+            while (step * step < stride)
+                step *= 2;
+        }
+        cache->surfaceObject()->setLevelOfDetail(step);
+    }
+
     glViewport(m_primarySubViewport.x(),
                m_primarySubViewport.y(),
                m_primarySubViewport.width(),
@@ -1190,45 +1261,35 @@ void Surface3DRenderer::drawScene(GLuint defaultFboHandle)
                                           / (GLfloat)m_primarySubViewport.height(), 3.0f, 100.0f);
         depthProjectionViewMatrix = depthProjectionMatrix * depthViewMatrix;
 
-        // Surface is not closed, so don't cull anything
-        glDisable(GL_CULL_FACE);
+        // Adaptive quality skips drawing the shadow casters. The cleared depth texture leaves
+        // the scene unshadowed without switching shaders or recreating the depth buffer.
+        if (!m_skipShadowPass) {
+            // Surface is not closed, so don't cull anything
+            glDisable(GL_CULL_FACE);
 
-        foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-            SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
-            SurfaceObject *object = cache->surfaceObject();
-            if (object->indexCount() && cache->surfaceVisible() && cache->isVisible()
-                    && cache->sampleSpace().width() >= 2 && cache->sampleSpace().height() >= 2) {
-                // No translation nor scaling for surfaces, therefore no modelMatrix
-                // Use directly projectionViewMatrix
-                m_depthShader->setUniformValue(m_depthShader->MVP(), depthProjectionViewMatrix);
-
-                // 1st attribute buffer : vertices
-                glEnableVertexAttribArray(m_depthShader->posAtt());
-                glBindBuffer(GL_ARRAY_BUFFER, object->vertexBuf());
-                glVertexAttribPointer(m_depthShader->posAtt(), 3, GL_FLOAT, GL_FALSE, 0,
-                                      (void *)0);
-
-                // Index buffer
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->elementBuf());
-
-                // Draw the triangles
-                glDrawElements(GL_TRIANGLES, object->indexCount(), GL_UNSIGNED_INT, (void *)0);
+            foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+                SurfaceSeriesRenderCache *cache =
+                        static_cast<SurfaceSeriesRenderCache *>(baseCache);
+                SurfaceObject *object = cache->surfaceObject();
+                if (object->indexCount() && cache->surfaceVisible() && cache->isVisible()
+                        && cache->sampleSpace().width() >= 2
+                        && cache->sampleSpace().height() >= 2) {
+                    // No translation nor scaling for surfaces, therefore no modelMatrix
+                    // Use directly projectionViewMatrix
+                    m_depthShader->setUniformValue(m_depthShader->MVP(),
+                                                   depthProjectionViewMatrix);
+                    m_drawer->drawSelectionObject(m_depthShader, object);
+                }
             }
-        }
-
-        // Free buffers
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        glDisableVertexAttribArray(m_depthShader->posAtt());
+            glEnable(GL_CULL_FACE);
+            glCullFace(GL_FRONT);
 
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_FRONT);
-
-        Abstract3DRenderer::drawCustomItems(RenderingDepth, m_depthShader, viewMatrix,
-                                            projectionViewMatrix,
-                                            depthProjectionViewMatrix, m_depthTexture,
-                                            m_shadowQualityToShader);
+            Abstract3DRenderer::drawCustomItems(RenderingDepth, m_depthShader, viewMatrix,
+                                                projectionViewMatrix,
+                                                depthProjectionViewMatrix, m_depthTexture,
+                                                m_shadowQualityToShader);
+        }
 
         // Disable drawing to depth framebuffer (= enable drawing to screen)
         glBindFramebuffer(GL_FRAMEBUFFER, defaultFboHandle);
@@ -1264,32 +1325,48 @@ void Surface3DRenderer::drawScene(GLuint defaultFboHandle)
                    m_primarySubViewport.width(),
                    m_primarySubViewport.height());
 
-        glEnable(GL_DEPTH_TEST); // Needed, otherwise the depth render buffer is not used
-        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Needed for clearing the frame buffer
-        glDisable(GL_DITHER); // disable dithering, it may affect colors if enabled
+        if (!reuseSelectionBuffer()) {
+            glEnable(GL_DEPTH_TEST); // Needed, otherwise the depth render buffer is not used
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Needed for clearing the frame buffer
+            glDisable(GL_DITHER); // disable dithering, it may affect colors if enabled
 
-        glDisable(GL_CULL_FACE);
+            glDisable(GL_CULL_FACE);
 
-        foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-            SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
-            if (cache->surfaceObject()->indexCount() && cache->renderable()) {
-                m_selectionShader->setUniformValue(m_selectionShader->MVP(), projectionViewMatrix);
+            // The selection shader encodes the index of the nearest data point from the UVs,
+            // and the series id to the alpha channel below the reserved label and item ids.
+            uint seriesId = 0;
+            foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+                SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
+                cache->setSelectionId(0);
+                if (cache->surfaceObject()->indexCount() && cache->renderable()
+                        && seriesId < uint(customItemAlpha) - 1) {
+                    const QRect &sampleSpace = cache->sampleSpace();
+                    cache->setSelectionId(++seriesId);
+                    m_selectionShader->setUniformValue(m_selectionShader->MVP(), projectionViewMatrix);
+                    m_selectionShader->setUniformValue(m_selectionShader->selectionGrid(),
+                                                       QVector3D(sampleSpace.width() - 1,
+                                                                 sampleSpace.height() - 1,
+                                                                 seriesId));
 
-                cache->surfaceObject()->activateSurfaceTexture(false);
+                    cache->surfaceObject()->activateSurfaceTexture(false);
 
-                m_drawer->drawObject(m_selectionShader, cache->surfaceObject(),
-                                     cache->selectionTexture());
+                    // Selection always uses the full mesh
+                    const bool levelOfDetail = cache->surfaceObject()->isLevelOfDetailActive();
+                    cache->surfaceObject()->setLevelOfDetailActive(false);
+                    m_drawer->drawObject(m_selectionShader, cache->surfaceObject());
+                    cache->surfaceObject()->setLevelOfDetailActive(levelOfDetail);
+                }
             }
-        }
-        m_surfaceGridShader->bind();
-        Abstract3DRenderer::drawCustomItems(RenderingSelection, m_surfaceGridShader,
-                                            viewMatrix,
-                                            projectionViewMatrix, depthProjectionViewMatrix,
-                                            m_depthTexture, m_shadowQualityToShader);
-        drawLabels(true, activeCamera, viewMatrix, projectionMatrix);
+            m_surfaceGridShader->bind();
+            Abstract3DRenderer::drawCustomItems(RenderingSelection, m_surfaceGridShader,
+                                                viewMatrix,
+                                                projectionViewMatrix, depthProjectionViewMatrix,
+                                                m_depthTexture, m_shadowQualityToShader);
+            drawLabels(true, activeCamera, viewMatrix, projectionMatrix);
 
-        glEnable(GL_DITHER);
+            glEnable(GL_DITHER);
+        }
 
         QVector4D clickedColor = Utils::getSelection(m_inputPosition, m_viewport.height());
 
@@ -2419,106 +2496,17 @@ void Surface3DRenderer::drawLabels(bool drawSelection, const Q3DCamera *activeCa
         glDisable(GL_BLEND);
 }
 
-void Surface3DRenderer::updateSelectionMode(QAbstract3DGraph::SelectionFlags mode)
-{
-    Abstract3DRenderer::updateSelectionMode(mode);
-
-    if (m_cachedSelectionMode > QAbstract3DGraph::SelectionNone)
-        updateSelectionTextures();
-}
-
-void Surface3DRenderer::updateSelectionTextures()
-{
-    uint lastSelectionId = 1;
-
-    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-        SurfaceSeriesRenderCache *cache =
-                static_cast<SurfaceSeriesRenderCache *>(baseCache);
-        GLuint texture = cache->selectionTexture();
-        m_textureHelper->deleteTexture(&texture);
-        createSelectionTexture(cache, lastSelectionId);
-    }
-    m_selectionTexturesDirty = false;
-}
-
-void Surface3DRenderer::createSelectionTexture(SurfaceSeriesRenderCache *cache,
-                                               uint &lastSelectionId)
-{
-    // Create the selection ID image. Each grid corner gets 1 pixel area of
-    // ID color so that each vertex (data point) has 2x2 pixel area of ID color,
-    // except the vertices on the edges.
-    const QRect &sampleSpace = cache->sampleSpace();
-    int idImageWidth = (sampleSpace.width() - 1) * 2;
-    int idImageHeight = (sampleSpace.height() - 1) * 2;
-
-    if (idImageHeight <= 0 || idImageWidth <= 0) {
-        cache->setSelectionIdRange(~0U, ~0U);
-        cache->setSelectionTexture(0);
-        return;
-    }
-
-    int stride = idImageWidth * 4 * sizeof(uchar); // 4 = number of color components (rgba)
-
-    uint idStart = lastSelectionId;
-    uchar *bits = new uchar[idImageWidth * idImageHeight * 4 * sizeof(uchar)];
-    for (int i = 0; i < idImageHeight; i += 2) {
-        for (int j = 0; j < idImageWidth; j += 2) {
-            int p = (i * idImageWidth + j) * 4;
-            uchar r, g, b, a;
-            idToRGBA(lastSelectionId, &r, &g, &b, &a);
-            fillIdCorner(&bits[p], r, g, b, a);
-
-            idToRGBA(lastSelectionId + 1, &r, &g, &b, &a);
-            fillIdCorner(&bits[p + 4], r, g, b, a);
-
-            idToRGBA(lastSelectionId + sampleSpace.width(), &r, &g, &b, &a);
-            fillIdCorner(&bits[p + stride], r, g, b, a);
-
-            idToRGBA(lastSelectionId + sampleSpace.width() + 1, &r, &g, &b, &a);
-            fillIdCorner(&bits[p + stride + 4], r, g, b, a);
-
-            lastSelectionId++;
-        }
-        lastSelectionId++;
-    }
-    lastSelectionId += sampleSpace.width();
-    cache->setSelectionIdRange(idStart, lastSelectionId - 1);
-
-    // Move the ID image (bits) to the texture
-    QImage image = QImage(bits, idImageWidth, idImageHeight, QImage::Format_RGB32);
-    GLuint selectionTexture = m_textureHelper->create2DTexture(image, false, false, false);
-    cache->setSelectionTexture(selectionTexture);
-
-    // Release the temp bits allocation
-    delete[] bits;
-}
-
 void Surface3DRenderer::initSelectionBuffer()
 {
     // Create the result selection texture and buffers
     m_textureHelper->deleteTexture(&m_selectionResultTexture);
+    m_selectionBufferValid = false;
 
     m_selectionResultTexture = m_textureHelper->createSelectionTexture(m_primarySubViewport.size(),
                                                                        m_selectionFrameBuffer,
                                                                        m_selectionDepthBuffer);
 }
 
-void Surface3DRenderer::fillIdCorner(uchar *p, uchar r, uchar g, uchar b, uchar a)
-{
-    p[0] = r;
-    p[1] = g;
-    p[2] = b;
-    p[3] = a;
-}
-
-void Surface3DRenderer::idToRGBA(uint id, uchar *r, uchar *g, uchar *b, uchar *a)
-{
-    *r = id & ID_TO_RGBA_MASK;
-    *g = (id >> 8) & ID_TO_RGBA_MASK;
-    *b = (id >> 16) & ID_TO_RGBA_MASK;
-    *a = (id >> 24) & ID_TO_RGBA_MASK;
-}
-
 void Surface3DRenderer::calculateSceneScalingFactors()
 {
     // Margin for background (the default 0.10 makes it 10% larger to avoid
@@ -2594,15 +2582,12 @@ void Surface3DRenderer::checkFlatSupport(SurfaceSeriesRenderCache *cache)
     }
 }
 
-void Surface3DRenderer::updateObjects(SurfaceSeriesRenderCache *cache, bool dimensionChanged)
+void Surface3DRenderer::updateObjects(SurfaceSeriesRenderCache *cache,
+                                      const QSurfaceDataArray &array, bool dimensionChanged)
 {
     QSurfaceDataArray &dataArray = cache->dataArray();
     const QRect &sampleSpace = cache->sampleSpace();
 
-    const QSurface3DSeries *currentSeries = cache->series();
-    QSurfaceDataProxy *dataProxy = currentSeries->dataProxy();
-    const QSurfaceDataArray &array = *dataProxy->array();
-
     if (cache->isFlatShadingEnabled()) {
         cache->surfaceObject()->setUpData(dataArray, sampleSpace, dimensionChanged, m_polarGraph);
         if (cache->surfaceTexture())
@@ -2767,12 +2752,15 @@ QPoint Surface3DRenderer::selectionIdToSurfacePoint(uint id)
     }
 
     // Not a label selection
+    const uint seriesId = id / alphaMultiplier;
     SurfaceSeriesRenderCache *selectedCache = 0;
-    foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
-        SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
-        if (cache->isWithinIdRange(id)) {
-            selectedCache = cache;
-            break;
+    if (seriesId) {
+        foreach (SeriesRenderCache *baseCache, m_renderCacheList) {
+            SurfaceSeriesRenderCache *cache = static_cast<SurfaceSeriesRenderCache *>(baseCache);
+            if (cache->selectionId() == seriesId) {
+                selectedCache = cache;
+                break;
+            }
         }
     }
     if (!selectedCache) {
@@ -2780,10 +2768,10 @@ QPoint Surface3DRenderer::selectionIdToSurfacePoint(uint id)
         return Surface3DController::invalidSelectionPosition();
     }
 
-    uint idInSeries = id - selectedCache->selectionIdStart() + 1;
+    uint idInSeries = id % alphaMultiplier;
     const QRect &sampleSpace = selectedCache->sampleSpace();
-    int column = ((idInSeries - 1) % sampleSpace.width()) + sampleSpace.x();
-    int row = ((idInSeries - 1) / sampleSpace.width()) +  sampleSpace.y();
+    int column = (idInSeries % sampleSpace.width()) + sampleSpace.x();
+    int row = (idInSeries / sampleSpace.width()) +  sampleSpace.y();
 
     m_clickedSeries = selectedCache->series();
     m_clickedType = QAbstract3DGraph::ElementSeries;
@@ -2946,7 +2934,7 @@ void Surface3DRenderer::initSelectionShaders()
     if (m_selectionShader)
         delete m_selectionShader;
     m_selectionShader = new ShaderHelper(this, QStringLiteral(":/shaders/vertexLabel"),
-                                         QStringLiteral(":/shaders/fragmentLabel"));
+                                         QStringLiteral(":/shaders/fragmentSurfaceSelection"));
     m_selectionShader->initialize();
 }
 
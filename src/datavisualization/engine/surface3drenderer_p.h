@@ -58,10 +58,14 @@ private:
     QPoint m_selectedPoint;
     QSurface3DSeries *m_selectedSeries;
     QPoint m_clickedPosition;
-    bool m_selectionTexturesDirty;
     GLuint m_noShadowTexture;
     bool m_flipHorizontalGrid;
 
+    // Data updates waiting for applyDataUpdates()
+    bool m_dataSnapshotPending;
+    QList<Surface3DController::ChangeRow> m_pendingRows;
+    QList<Surface3DController::ChangeItem> m_pendingItems;
+
 public:
     explicit Surface3DRenderer(Surface3DController *controller);
     ~Surface3DRenderer();
@@ -71,7 +75,6 @@ public:
     void updateSurfaceTextures(QList<QSurface3DSeries *> seriesList);
     SeriesRenderCache *createNewCache(QAbstract3DSeries *series) override;
     void cleanCache(SeriesRenderCache *cache) override;
-    void updateSelectionMode(QAbstract3DGraph::SelectionFlags mode) override;
     void updateRows(const QList<Surface3DController::ChangeRow> &rows);
     void updateItems(const QList<Surface3DController::ChangeItem> &points);
     void updateScene(Q3DScene *scene) override;
@@ -94,13 +97,19 @@ protected:
     void initializeOpenGL() override;
     virtual void fixCameraTarget(QVector3D &target) override;
     virtual void getVisibleItemBounds(QVector3D &minBounds, QVector3D &maxBounds) override;
+    void applyDataUpdates() override;
 
 Q_SIGNALS:
     void flatShadingSupportedChanged(bool supported);
 
 private:
+    void applyData();
+    void applyRows(const QList<Surface3DController::ChangeRow> &rows);
+    void applyItems(const QList<Surface3DController::ChangeItem> &points);
+    void takeDataSnapshot(QSurface3DSeries *series);
     void checkFlatSupport(SurfaceSeriesRenderCache *cache);
-    void updateObjects(SurfaceSeriesRenderCache *cache, bool dimensionChanged);
+    void updateObjects(SurfaceSeriesRenderCache *cache, const QSurfaceDataArray &array,
+                       bool dimensionChanged);
     void updateSliceDataModel(const QPoint &point);
     QPoint mapCoordsToSampleSpace(SurfaceSeriesRenderCache *cache, const QPointF &coords);
     void findMatchingRow(float z, int &sample, int direction, QSurfaceDataArray &dataArray);
@@ -123,10 +132,6 @@ private:
     void initSurfaceShaders();
     void initSelectionBuffer() override;
     void initDepthShader();
-    void updateSelectionTextures();
-    void createSelectionTexture(SurfaceSeriesRenderCache *cache, uint &lastSelectionId);
-    void idToRGBA(uint id, uchar *r, uchar *g, uchar *b, uchar *a);
-    void fillIdCorner(uchar *p, uchar r, uchar g, uchar b, uchar a);
     void surfacePointSelected(const QPoint &point);
     void updateSelectionPoint(SurfaceSeriesRenderCache *cache, const QPoint &point, bool label);
     QPoint selectionIdToSurfacePoint(uint id);
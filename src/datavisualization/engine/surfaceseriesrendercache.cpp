@@ -16,16 +16,15 @@ SurfaceSeriesRenderCache::SurfaceSeriesRenderCache(QAbstract3DSeries *series,
       m_surfaceObj(new SurfaceObject(renderer)),
       m_sliceSurfaceObj(new SurfaceObject(renderer)),
       m_sampleSpace(QRect(0, 0, 0, 0)),
-      m_selectionTexture(0),
-      m_selectionIdStart(0),
-      m_selectionIdEnd(0),
+      m_selectionId(0),
       m_flatChangeAllowed(true),
       m_flatStatusDirty(true),
       m_sliceSelectionPointer(0),
       m_mainSelectionPointer(0),
       m_slicePointerActive(false),
       m_mainPointerActive(false),
-      m_surfaceTexture(0)
+      m_surfaceTexture(0),
+      m_hasDataSnapshot(false)
 {
 }
 
@@ -52,10 +51,8 @@ void SurfaceSeriesRenderCache::populate(bool newSeries)
 
 void SurfaceSeriesRenderCache::cleanup(TextureHelper *texHelper)
 {
-    if (QOpenGLContext::currentContext()) {
-        texHelper->deleteTexture(&m_selectionTexture);
+    if (QOpenGLContext::currentContext())
         texHelper->deleteTexture(&m_surfaceTexture);
-    }
 
     delete m_surfaceObj;
     delete m_sliceSurfaceObj;
@@ -67,10 +64,33 @@ void SurfaceSeriesRenderCache::cleanup(TextureHelper *texHelper)
         delete m_sliceDataArray.at(i);
     m_sliceDataArray.clear();
 
+    releaseDataSnapshot();
+
     delete m_sliceSelectionPointer;
     delete m_mainSelectionPointer;
 
     SeriesRenderCache::cleanup(texHelper);
 }
 
+void SurfaceSeriesRenderCache::takeDataSnapshot()
+{
+    if (m_hasDataSnapshot)
+        return;
+
+    // Rows are implicitly shared, so this does not copy the items. Any later change made to
+    // the proxy rows detaches them from the snapshot.
+    const QSurfaceDataArray &array = *series()->dataProxy()->array();
+    m_dataSnapshot.reserve(array.size());
+    for (const QSurfaceDataRow *row : array)
+        m_dataSnapshot.append(new QSurfaceDataRow(*row));
+    m_hasDataSnapshot = true;
+}
+
+void SurfaceSeriesRenderCache::releaseDataSnapshot()
+{
+    qDeleteAll(m_dataSnapshot);
+    m_dataSnapshot.clear();
+    m_hasDataSnapshot = false;
+}
+
 QT_END_NAMESPACE
@@ -49,13 +49,8 @@ public:
     inline QSurfaceDataArray &sliceDataArray() { return m_sliceDataArray; }
     inline bool renderable() const { return m_visible && (m_surfaceVisible ||
                                                           m_surfaceGridVisible); }
-    inline void setSelectionTexture(GLuint texture) { m_selectionTexture = texture; }
-    inline GLuint selectionTexture() const { return m_selectionTexture; }
-    inline void setSelectionIdRange(uint start, uint end) { m_selectionIdStart = start;
-                                                            m_selectionIdEnd = end; }
-    inline uint selectionIdStart() const { return m_selectionIdStart; }
-    inline bool isWithinIdRange(uint selection) const { return selection >= m_selectionIdStart &&
-                                                        selection <= m_selectionIdEnd; }
+    inline void setSelectionId(uint id) { m_selectionId = id; }
+    inline uint selectionId() const { return m_selectionId; }
     inline bool isFlatStatusDirty() const { return m_flatStatusDirty; }
     inline void setFlatStatusDirty(bool status) { m_flatStatusDirty = status; }
     inline void setMVPMatrix(const QMatrix4x4 &matrix) { m_MVPMatrix = matrix; }
@@ -73,6 +68,11 @@ public:
     inline void setSurfaceTexture(GLuint texture) { m_surfaceTexture = texture; }
     inline GLuint surfaceTexture() const { return m_surfaceTexture; }
 
+    void takeDataSnapshot();
+    void releaseDataSnapshot();
+    inline bool hasDataSnapshot() const { return m_hasDataSnapshot; }
+    inline const QSurfaceDataArray &dataSnapshot() const { return m_dataSnapshot; }
+
 protected:
     bool m_surfaceVisible;
     bool m_surfaceGridVisible;
@@ -82,9 +82,7 @@ protected:
     QRect m_sampleSpace;
     QSurfaceDataArray m_dataArray;
     QSurfaceDataArray m_sliceDataArray;
-    GLuint m_selectionTexture;
-    uint m_selectionIdStart;
-    uint m_selectionIdEnd;
+    uint m_selectionId;
     bool m_flatChangeAllowed;
     bool m_flatStatusDirty;
     QMatrix4x4 m_MVPMatrix;
@@ -93,6 +91,8 @@ protected:
     bool m_slicePointerActive;
     bool m_mainPointerActive;
     GLuint m_surfaceTexture;
+    QSurfaceDataArray m_dataSnapshot; // Owns the rows, which share the data with the proxy rows
+    bool m_hasDataSnapshot;
 };
 
 QT_END_NAMESPACE
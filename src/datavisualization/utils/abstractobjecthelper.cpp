@@ -2,28 +2,108 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "abstractobjecthelper_p.h"
+#include "glstatecache_p.h"
+#include "shaderhelper_p.h"
+#include "utils_p.h"
+#include <QtOpenGL/QOpenGLVertexArrayObject>
+
+#ifndef GL_INT_2_10_10_10_REV
+#define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// Layout of the interleaved vertex buffer
+struct InterleavedVertex {
+    QVector3D position;
+    quint32 normal;
+};
+static_assert(sizeof(InterleavedVertex) == 16, "Unexpected interleaved vertex size");
+
+inline quint32 packNormal(const QVector3D &normal, GLenum type)
+{
+    const QVector3D n = normal.normalized();
+    if (type == GL_INT_2_10_10_10_REV) {
+        auto component = [](float value) {
+            return quint32(qRound(qBound(-1.0f, value, 1.0f) * 511.0f)) & 0x3ff;
+        };
+        return component(n.x()) | (component(n.y()) << 10) | (component(n.z()) << 20);
+    }
+
+    qint8 bytes[4] = { qint8(qRound(qBound(-1.0f, n.x(), 1.0f) * 127.0f)),
+                       qint8(qRound(qBound(-1.0f, n.y(), 1.0f) * 127.0f)),
+                       qint8(qRound(qBound(-1.0f, n.z(), 1.0f) * 127.0f)),
+                       0 };
+    quint32 packed;
+    memcpy(&packed, bytes, sizeof(packed));
+    return packed;
+}
+
+// Number of vertices converted at a time when uploading packed data
+const int stagingVertexCount = 16384;
+
+inline quint16 packUV(float value)
+{
+    return quint16(qRound(qBound(0.0f, value, 1.0f) * 65535.0f));
+}
+
+// Signed 2_10_10_10 vertex attributes need OpenGL 3.3 or OpenGL ES 3.0,
+// otherwise the normals are packed into signed bytes.
+GLenum packedNormalType()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context)
+        return GL_BYTE;
+    const QSurfaceFormat format = context->format();
+    if (Utils::isOpenGLES())
+        return format.majorVersion() >= 3 ? GL_INT_2_10_10_10_REV : GL_BYTE;
+    if (format.version() >= qMakePair(3, 3)
+            || context->hasExtension(QByteArrayLiteral("GL_ARB_vertex_type_2_10_10_10_rev"))) {
+        return GL_INT_2_10_10_10_REV;
+    }
+    return GL_BYTE;
+}
+
+}
+
 AbstractObjectHelper::AbstractObjectHelper()
     : m_vertexbuffer(0),
       m_normalbuffer(0),
       m_uvbuffer(0),
       m_elementbuffer(0),
       m_indexCount(0),
-      m_meshDataLoaded(false)
+      m_meshDataLoaded(false),
+      m_indexType(GL_UNSIGNED_INT),
+      m_lodElementbuffer(0),
+      m_lodIndexCount(0),
+      m_lodIndexType(GL_UNSIGNED_INT),
+      m_lodActive(false),
+      m_vertexArray(nullptr),
+      m_vertexArrayContext(nullptr),
+      m_vertexArrayUVBuffer(0),
+      m_vertexArrayDirty(true),
+      m_vertexArrayUnsupported(false),
+      m_vertexFormat(SeparateBuffers),
+      m_interleavedNormals(false),
+      m_normalType(GL_FLOAT),
+      m_uvType(GL_FLOAT)
 {
     initializeOpenGLFunctions();
 }
 
 AbstractObjectHelper::~AbstractObjectHelper()
 {
-    if (QOpenGLContext::currentContext()) {
-        glDeleteBuffers(1, &m_vertexbuffer);
-        glDeleteBuffers(1, &m_uvbuffer);
-        glDeleteBuffers(1, &m_normalbuffer);
-        glDeleteBuffers(1, &m_elementbuffer);
+    if (m_vertexArray) {
+        releaseVertexArray();
+        delete m_vertexArray;
     }
+    deleteBuffer(m_vertexbuffer);
+    deleteBuffer(m_uvbuffer);
+    deleteBuffer(m_normalbuffer);
+    deleteBuffer(m_elementbuffer);
+    deleteBuffer(m_lodElementbuffer);
 }
 
 GLuint AbstractObjectHelper::vertexBuf()
@@ -59,4 +139,257 @@ GLuint AbstractObjectHelper::indexCount()
     return m_indexCount;
 }
 
+void AbstractObjectHelper::setupAttributes(GLint positionAttribute, GLint normalAttribute,
+                                           GLint uvAttribute)
+{
+    const GLsizei stride = m_interleavedNormals ? GLsizei(sizeof(InterleavedVertex)) : 0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
+    if (positionAttribute >= 0) {
+        glEnableVertexAttribArray(positionAttribute);
+        glVertexAttribPointer(positionAttribute, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    }
+    if (normalAttribute >= 0) {
+        if (m_interleavedNormals) {
+            glEnableVertexAttribArray(normalAttribute);
+            glVertexAttribPointer(normalAttribute, 4, m_normalType, GL_TRUE, stride,
+                                  (void *)sizeof(QVector3D));
+        } else if (m_normalbuffer) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_normalbuffer);
+            glEnableVertexAttribArray(normalAttribute);
+            glVertexAttribPointer(normalAttribute, 3, GL_FLOAT, GL_FALSE, 0, (void *)0);
+        }
+    }
+    if (uvAttribute >= 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, uvBuf());
+        glEnableVertexAttribArray(uvAttribute);
+        glVertexAttribPointer(uvAttribute, 2, m_uvType, m_uvType != GL_FLOAT, 0, (void *)0);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+QOpenGLVertexArrayObject *AbstractObjectHelper::vertexArray()
+{
+    if (!m_meshDataLoaded || !m_elementbuffer || !createVertexArray())
+        return nullptr;
+
+    const GLuint uvBuffer = uvBuf();
+    if (m_vertexArrayDirty || uvBuffer != m_vertexArrayUVBuffer) {
+        m_vertexArray->bind();
+
+        setupAttributes(ShaderHelper::PositionAttribute, ShaderHelper::NormalAttribute,
+                        uvBuffer ? ShaderHelper::UVAttribute : -1);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementbuffer);
+
+        m_vertexArray->release();
+        GLStateCache::markVertexArraysChanged();
+
+        m_vertexArrayUVBuffer = uvBuffer;
+        m_vertexArrayDirty = false;
+    }
+
+    return m_vertexArray;
+}
+
+void AbstractObjectHelper::beginBufferUpdate()
+{
+    // Element buffer bindings are part of the vertex array state, so make sure none is bound
+    // while buffers are uploaded, and record the buffers again before the next draw.
+    releaseVertexArray();
+    m_vertexArrayDirty = true;
+}
+
+void AbstractObjectHelper::uploadVertices(const QVector3D *vertices, int vertexCount,
+                                          const QVector3D *normals, int normalCount,
+                                          GLenum usage)
+{
+    beginBufferUpdate();
+
+    m_interleavedNormals = m_vertexFormat.testFlag(InterleavedNormals);
+    if (m_interleavedNormals) {
+        m_normalType = packedNormalType();
+        setBufferData(GL_ARRAY_BUFFER, m_vertexbuffer, vertexCount * sizeof(InterleavedVertex),
+                      nullptr, usage);
+        writeInterleavedVertices(0, vertices, normals, normalCount, vertexCount);
+        // Keep the normal buffer name so that it can still be released, but drop its data
+        if (m_normalbuffer)
+            setBufferData(GL_ARRAY_BUFFER, m_normalbuffer, 0, nullptr, usage);
+    } else {
+        m_normalType = GL_FLOAT;
+        setBufferData(GL_ARRAY_BUFFER, m_vertexbuffer, vertexCount * sizeof(QVector3D),
+                      vertices, usage);
+        setBufferData(GL_ARRAY_BUFFER, m_normalbuffer, normalCount * sizeof(QVector3D),
+                      normals, usage);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void AbstractObjectHelper::updateVertices(int first, const QVector3D *vertices,
+                                          const QVector3D *normals, int count)
+{
+    if (m_interleavedNormals) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
+        writeInterleavedVertices(first, vertices, normals, normals ? count : 0, count);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(QVector3D), count * sizeof(QVector3D),
+                        vertices);
+        if (normals && m_normalbuffer) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_normalbuffer);
+            glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(QVector3D),
+                            count * sizeof(QVector3D), normals);
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void AbstractObjectHelper::uploadUVs(GLuint &buffer, const QVector2D *uvs, int count,
+                                     GLenum usage)
+{
+    const GLenum uvType = m_vertexFormat.testFlag(PackedUVs) ? GL_UNSIGNED_SHORT : GL_FLOAT;
+    if (uvType != m_uvType) {
+        // Attribute type is recorded in the vertex array
+        beginBufferUpdate();
+        m_uvType = uvType;
+    }
+
+    if (m_uvType == GL_UNSIGNED_SHORT) {
+        setBufferData(GL_ARRAY_BUFFER, buffer, count * 2 * sizeof(quint16), nullptr, usage);
+        writePackedUVs(0, uvs, count);
+    } else {
+        setBufferData(GL_ARRAY_BUFFER, buffer, count * sizeof(QVector2D), uvs, usage);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void AbstractObjectHelper::updateUVs(GLuint buffer, int first, const QVector2D *uvs, int count)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (m_uvType == GL_UNSIGNED_SHORT) {
+        writePackedUVs(first, uvs, count);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(QVector2D), count * sizeof(QVector2D),
+                        uvs);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+GLenum AbstractObjectHelper::uploadIndices(GLuint &buffer, const GLuint *indices, int count,
+                                           GLenum usage)
+{
+    // Element buffer bindings are recorded in the vertex array
+    beginBufferUpdate();
+
+    GLuint maxIndex = 0;
+    if (m_vertexFormat.testFlag(ShortIndices)) {
+        for (int i = 0; i < count; i++)
+            maxIndex = qMax(maxIndex, indices[i]);
+    }
+
+    GLenum type = GL_UNSIGNED_INT;
+    if (m_vertexFormat.testFlag(ShortIndices) && maxIndex <= 0xffff) {
+        type = GL_UNSIGNED_SHORT;
+        QList<quint16> data(count);
+        for (int i = 0; i < count; i++)
+            data[i] = quint16(indices[i]);
+        setBufferData(GL_ELEMENT_ARRAY_BUFFER, buffer, count * sizeof(quint16),
+                      data.constData(), usage);
+    } else {
+        setBufferData(GL_ELEMENT_ARRAY_BUFFER, buffer, count * sizeof(GLuint), indices, usage);
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return type;
+}
+
+void AbstractObjectHelper::deleteBuffer(GLuint &buffer)
+{
+    if (!buffer)
+        return;
+    if (QOpenGLContext::currentContext())
+        glDeleteBuffers(1, &buffer);
+    m_bufferSizes.remove(buffer);
+    buffer = 0;
+}
+
+qint64 AbstractObjectHelper::bufferMemory() const
+{
+    qint64 total = 0;
+    for (qint64 size : m_bufferSizes)
+        total += size;
+    return total;
+}
+
+void AbstractObjectHelper::setBufferData(GLenum target, GLuint &buffer, qint64 size,
+                                         const void *data, GLenum usage)
+{
+    if (!buffer)
+        glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+    glBufferData(target, size, size ? data : nullptr, usage);
+    m_bufferSizes.insert(buffer, size);
+}
+
+void AbstractObjectHelper::writeInterleavedVertices(int first, const QVector3D *vertices,
+                                                    const QVector3D *normals, int normalCount,
+                                                    int count)
+{
+    QList<InterleavedVertex> data(qMin(count, stagingVertexCount));
+    for (int start = 0; start < count; start += stagingVertexCount) {
+        const int chunkCount = qMin(count - start, stagingVertexCount);
+        for (int i = 0; i < chunkCount; i++) {
+            const int index = start + i;
+            data[i].position = vertices[index];
+            data[i].normal = index < normalCount ? packNormal(normals[index], m_normalType) : 0;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, (first + start) * sizeof(InterleavedVertex),
+                        chunkCount * sizeof(InterleavedVertex), data.constData());
+    }
+}
+
+void AbstractObjectHelper::writePackedUVs(int first, const QVector2D *uvs, int count)
+{
+    QList<quint16> data(qMin(count, stagingVertexCount) * 2);
+    for (int start = 0; start < count; start += stagingVertexCount) {
+        const int chunkCount = qMin(count - start, stagingVertexCount);
+        for (int i = 0; i < chunkCount; i++) {
+            data[2 * i] = packUV(uvs[start + i].x());
+            data[2 * i + 1] = packUV(uvs[start + i].y());
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, (first + start) * 2 * sizeof(quint16),
+                        chunkCount * 2 * sizeof(quint16), data.constData());
+    }
+}
+
+bool AbstractObjectHelper::createVertexArray()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (m_vertexArray) {
+        // Vertex array objects cannot be shared between contexts. Shared meshes outlive the
+        // context of the renderer that created them, in which case the array is recreated.
+        if (m_vertexArrayContext || !context)
+            return m_vertexArrayContext == context;
+        delete m_vertexArray;
+        m_vertexArray = nullptr;
+    }
+    if (m_vertexArrayUnsupported || !context)
+        return false;
+
+    m_vertexArray = new QOpenGLVertexArrayObject;
+    if (!m_vertexArray->create()) {
+        delete m_vertexArray;
+        m_vertexArray = nullptr;
+        m_vertexArrayUnsupported = true;
+        return false;
+    }
+    m_vertexArrayContext = context;
+    m_vertexArrayDirty = true;
+    return true;
+}
+
+void AbstractObjectHelper::releaseVertexArray()
+{
+    // The bound vertex array is not necessarily ours, and may be from another context
+    GLStateCache::releaseCurrentBindings();
+}
+
 QT_END_NAMESPACE
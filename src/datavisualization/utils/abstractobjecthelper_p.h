@@ -15,11 +15,31 @@
 #define ABSTRACTOBJECTHELPER_H
 
 #include "datavisualizationglobal_p.h"
+#include <QtGui/QVector2D>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtGui/QOpenGLContext>
+
+QT_FORWARD_DECLARE_CLASS(QOpenGLVertexArrayObject)
 
 QT_BEGIN_NAMESPACE
 
 class AbstractObjectHelper: protected QOpenGLFunctions
 {
+public:
+    enum VertexFormatFlag {
+        SeparateBuffers = 0x0,
+        // Positions and normals share one buffer, with normals packed into 32 bits
+        InterleavedNormals = 0x1,
+        // UVs are stored as normalized 16-bit integers, so they are clamped to [0, 1] and
+        // quantized to 1/65535
+        PackedUVs = 0x2,
+        // Indices are stored as 16-bit integers whenever the vertex count allows
+        ShortIndices = 0x4,
+        CompactFormat = InterleavedNormals | PackedUVs | ShortIndices
+    };
+    Q_DECLARE_FLAGS(VertexFormat, VertexFormatFlag)
+
 protected:
     AbstractObjectHelper();
 public:
@@ -30,6 +50,45 @@ public:
     virtual GLuint uvBuf();
     GLuint elementBuf();
     GLuint indexCount();
+    inline GLenum indexType() const { return m_indexType; }
+
+    // Coarser index buffer drawn instead of the element buffer while active
+    inline bool isLevelOfDetailActive() const { return m_lodActive; }
+    inline void setLevelOfDetailActive(bool active) { m_lodActive = active && m_lodIndexCount; }
+    inline GLuint lodElementBuf() const { return m_lodElementbuffer; }
+    inline GLuint lodIndexCount() const { return m_lodIndexCount; }
+    inline GLenum lodIndexType() const { return m_lodIndexType; }
+
+    // Takes effect when the buffers are next uploaded
+    inline void setVertexFormat(VertexFormat format) { m_vertexFormat = format; }
+    inline VertexFormat vertexFormat() const { return m_vertexFormat; }
+
+    // Points the given attribute locations at the buffers of this object. Negative locations
+    // are skipped. The array buffer binding is left at zero.
+    void setupAttributes(GLint positionAttribute, GLint normalAttribute, GLint uvAttribute);
+
+    // Returns a vertex array object with the buffers of this object attached to the fixed
+    // attribute locations of ShaderHelper, or null if vertex array objects are not supported.
+    QOpenGLVertexArrayObject *vertexArray();
+
+    // Size of the buffers uploaded through the helpers below, in bytes
+    qint64 bufferMemory() const;
+
+protected:
+    // Must be called before changing or deleting the buffers of the object
+    void beginBufferUpdate();
+
+    // Buffer helpers that store the data in the current vertex format. Normals beyond
+    // normalCount are zero when interleaved.
+    void uploadVertices(const QVector3D *vertices, int vertexCount, const QVector3D *normals,
+                        int normalCount, GLenum usage);
+    void updateVertices(int first, const QVector3D *vertices, const QVector3D *normals,
+                        int count);
+    void uploadUVs(GLuint &buffer, const QVector2D *uvs, int count, GLenum usage);
+    void updateUVs(GLuint buffer, int first, const QVector2D *uvs, int count);
+    // Returns the index type used for the buffer
+    GLenum uploadIndices(GLuint &buffer, const GLuint *indices, int count, GLenum usage);
+    void deleteBuffer(GLuint &buffer);
 
 public:
     GLuint m_vertexbuffer;
@@ -39,8 +98,40 @@ public:
 
     GLuint m_indexCount;
     GLboolean m_meshDataLoaded;
+
+    GLenum m_indexType;
+
+    GLuint m_lodElementbuffer;
+    GLuint m_lodIndexCount;
+    GLenum m_lodIndexType;
+    bool m_lodActive;
+
+private:
+    bool createVertexArray();
+    void releaseVertexArray();
+    void setBufferData(GLenum target, GLuint &buffer, qint64 size, const void *data,
+                       GLenum usage);
+    // Convert the data into the bound buffer a chunk at a time, so that large meshes do not
+    // need a second full-size copy on the host
+    void writeInterleavedVertices(int first, const QVector3D *vertices,
+                                  const QVector3D *normals, int normalCount, int count);
+    void writePackedUVs(int first, const QVector2D *uvs, int count);
+
+    VertexFormat m_vertexFormat;
+    bool m_interleavedNormals;
+    GLenum m_normalType;
+    GLenum m_uvType;
+    QHash<GLuint, qint64> m_bufferSizes;
+
+    QOpenGLVertexArrayObject *m_vertexArray;
+    QPointer<QOpenGLContext> m_vertexArrayContext;
+    GLuint m_vertexArrayUVBuffer;
+    bool m_vertexArrayDirty;
+    bool m_vertexArrayUnsupported;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(AbstractObjectHelper::VertexFormat)
+
 QT_END_NAMESPACE
 
 #endif
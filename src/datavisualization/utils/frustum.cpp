@@ -0,0 +1,79 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "frustum_p.h"
+
+QT_BEGIN_NAMESPACE
+
+Frustum::Frustum()
+{
+}
+
+Frustum::Frustum(const QMatrix4x4 &projectionViewMatrix)
+{
+    // Each plane is a sum or difference of the w row and one of the other rows
+    const QVector4D w = projectionViewMatrix.row(3);
+    for (int i = 0; i < 3; i++) {
+        const QVector4D row = projectionViewMatrix.row(i);
+        m_planes[2 * i] = w + row;
+        m_planes[2 * i + 1] = w - row;
+    }
+
+    // Normalize, so that plane distances are in scene units for the sphere test
+    for (int i = 0; i < 6; i++) {
+        const float length = m_planes[i].toVector3D().length();
+        if (length > 0.0f)
+            m_planes[i] /= length;
+    }
+}
+
+Frustum::Containment Frustum::containsBox(const QVector3D &minimum,
+                                          const QVector3D &maximum) const
+{
+    Containment result = Inside;
+    for (int i = 0; i < 6; i++) {
+        const QVector4D &plane = m_planes[i];
+        // Corners furthest along and against the plane normal
+        QVector3D positive;
+        QVector3D negative;
+        for (int j = 0; j < 3; j++) {
+            if (plane[j] >= 0.0f) {
+                positive[j] = maximum[j];
+                negative[j] = minimum[j];
+            } else {
+                positive[j] = minimum[j];
+                negative[j] = maximum[j];
+            }
+        }
+        if (QVector3D::dotProduct(plane.toVector3D(), positive) + plane.w() < 0.0f)
+            return Outside;
+        if (QVector3D::dotProduct(plane.toVector3D(), negative) + plane.w() < 0.0f)
+            result = Intersecting;
+    }
+    return result;
+}
+
+bool Frustum::intersectsSphere(const QVector3D &center, float radius) const
+{
+    for (int i = 0; i < 6; i++) {
+        const QVector4D &plane = m_planes[i];
+        if (QVector3D::dotProduct(plane.toVector3D(), center) + plane.w() < -radius)
+            return false;
+    }
+    return true;
+}
+
+void Frustum::transformBox(const QMatrix4x4 &matrix, QVector3D &minimum, QVector3D &maximum)
+{
+    const QVector3D center = matrix.map((minimum + maximum) * 0.5f);
+    const QVector3D halfSize = (maximum - minimum) * 0.5f;
+    QVector3D extent;
+    for (int i = 0; i < 3; i++) {
+        extent[i] = qAbs(matrix(i, 0)) * halfSize.x() + qAbs(matrix(i, 1)) * halfSize.y()
+                + qAbs(matrix(i, 2)) * halfSize.z();
+    }
+    minimum = center - extent;
+    maximum = center + extent;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,52 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef FRUSTUM_P_H
+#define FRUSTUM_P_H
+
+#include "datavisualizationglobal_p.h"
+#include <QtGui/QMatrix4x4>
+
+QT_BEGIN_NAMESPACE
+
+// View frustum planes extracted from a projection view matrix. Bounds are tested in the space
+// the matrix maps from. A default constructed frustum contains everything.
+class Q_DATAVISUALIZATION_EXPORT Frustum
+{
+public:
+    enum Containment {
+        Outside = 0,
+        Intersecting,
+        Inside
+    };
+
+    Frustum();
+    explicit Frustum(const QMatrix4x4 &projectionViewMatrix);
+
+    Containment containsBox(const QVector3D &minimum, const QVector3D &maximum) const;
+    inline bool intersectsBox(const QVector3D &minimum, const QVector3D &maximum) const
+    {
+        return containsBox(minimum, maximum) != Outside;
+    }
+    bool intersectsSphere(const QVector3D &center, float radius) const;
+
+    // Replaces the box with the axis aligned box bounding it after transforming by the matrix
+    static void transformBox(const QMatrix4x4 &matrix, QVector3D &minimum, QVector3D &maximum);
+
+private:
+    QVector4D m_planes[6];
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,186 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "glstatecache_p.h"
+#include <QtGui/QOpenGLContext>
+#include <QtOpenGL/QOpenGLVertexArrayObject>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Resolves the function that binds vertex array objects, or returns null if they are unsupported
+QFunctionPointer bindVertexArrayFunction(QOpenGLContext *context)
+{
+    const QSurfaceFormat format = context->format();
+    if (context->isOpenGLES()) {
+        if (format.majorVersion() >= 3)
+            return context->getProcAddress("glBindVertexArray");
+        if (context->hasExtension(QByteArrayLiteral("GL_OES_vertex_array_object")))
+            return context->getProcAddress("glBindVertexArrayOES");
+        return nullptr;
+    }
+    if (format.version() >= qMakePair(3, 0)
+            || context->hasExtension(QByteArrayLiteral("GL_ARB_vertex_array_object"))) {
+        return context->getProcAddress("glBindVertexArray");
+    }
+    if (context->hasExtension(QByteArrayLiteral("GL_APPLE_vertex_array_object")))
+        return context->getProcAddress("glBindVertexArrayAPPLE");
+    return nullptr;
+}
+
+}
+
+QAtomicInt GLStateCache::s_vertexArrayGeneration;
+QAtomicInt GLStateCache::s_textureGeneration;
+
+GLStateCache::GLStateCache()
+    : m_vertexArray(nullptr),
+      m_activeTexture(0),
+      m_vertexArrayGeneration(0),
+      m_textureGeneration(0),
+      m_bindsElided(0)
+{
+    for (int i = 0; i < textureUnitCount; i++) {
+        m_textures[i] = 0;
+        m_textureTargets[i] = 0;
+        m_texturesKnown[i] = false;
+        m_usedTextureTargets[i] = 0;
+    }
+}
+
+void GLStateCache::initializeOpenGL()
+{
+    initializeOpenGLFunctions();
+}
+
+void GLStateCache::bindVertexArray(QOpenGLVertexArrayObject *vertexArray)
+{
+    syncGenerations();
+
+    if (m_vertexArray == vertexArray) {
+        if (vertexArray)
+            m_bindsElided++;
+        return;
+    }
+
+    if (vertexArray)
+        vertexArray->bind();
+    else
+        m_vertexArray->release();
+    m_vertexArray = vertexArray;
+}
+
+void GLStateCache::bindTexture(int unit, GLenum target, GLuint textureId)
+{
+    Q_ASSERT(unit >= 0 && unit < textureUnitCount);
+    syncGenerations();
+
+    if (m_texturesKnown[unit] && m_textures[unit] == textureId
+            && m_textureTargets[unit] == target) {
+        m_bindsElided++;
+        return;
+    }
+
+    const GLenum textureUnit = GL_TEXTURE0 + unit;
+    if (m_activeTexture != textureUnit) {
+        glActiveTexture(textureUnit);
+        m_activeTexture = textureUnit;
+    }
+    glBindTexture(target, textureId);
+
+    m_textures[unit] = textureId;
+    m_textureTargets[unit] = target;
+    m_texturesKnown[unit] = true;
+    m_usedTextureTargets[unit] = target;
+}
+
+void GLStateCache::invalidate()
+{
+    m_vertexArray = nullptr;
+    m_activeTexture = 0;
+    for (int i = 0; i < textureUnitCount; i++)
+        m_texturesKnown[i] = false;
+}
+
+void GLStateCache::release()
+{
+    syncGenerations();
+
+    if (m_vertexArray)
+        m_vertexArray->release();
+
+    // Units are unbound even if their exact binding is no longer known
+    GLenum activeTexture = m_activeTexture;
+    for (int i = textureUnitCount - 1; i >= 0; i--) {
+        if (m_usedTextureTargets[i]) {
+            if (activeTexture != GL_TEXTURE0 + i) {
+                activeTexture = GL_TEXTURE0 + i;
+                glActiveTexture(activeTexture);
+            }
+            glBindTexture(m_usedTextureTargets[i], 0);
+            m_usedTextureTargets[i] = 0;
+        }
+    }
+    // Leave the first unit active, like the rest of the renderer expects
+    if (activeTexture && activeTexture != GL_TEXTURE0)
+        glActiveTexture(GL_TEXTURE0);
+
+    invalidate();
+}
+
+void GLStateCache::markVertexArraysChanged()
+{
+    s_vertexArrayGeneration.fetchAndAddRelaxed(1);
+}
+
+void GLStateCache::markTexturesChanged()
+{
+    s_textureGeneration.fetchAndAddRelaxed(1);
+}
+
+void GLStateCache::releaseCurrentBindings()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context)
+        return;
+
+    // The bound vertex array may belong to a context sharing meshes with this one,
+    // so it is unbound directly instead of through any QOpenGLVertexArrayObject.
+    typedef void (QOPENGLF_APIENTRYP BindVertexArray)(GLuint array);
+    if (auto bindVertexArray = reinterpret_cast<BindVertexArray>(bindVertexArrayFunction(context)))
+        bindVertexArray(0);
+
+    QOpenGLFunctions *functions = context->functions();
+    for (int i = textureUnitCount - 1; i >= 0; i--) {
+        functions->glActiveTexture(GL_TEXTURE0 + i);
+        functions->glBindTexture(GL_TEXTURE_2D, 0);
+#if !QT_CONFIG(opengles2)
+        if (!context->isOpenGLES())
+            functions->glBindTexture(GL_TEXTURE_3D, 0);
+#endif
+    }
+
+    markVertexArraysChanged();
+    markTexturesChanged();
+}
+
+void GLStateCache::syncGenerations()
+{
+    // The generations are shared by all caches, so a change made for one context
+    // may needlessly invalidate others. That only costs a few extra binds.
+    const int vertexArrayGeneration = s_vertexArrayGeneration.loadRelaxed();
+    if (m_vertexArrayGeneration != vertexArrayGeneration) {
+        m_vertexArrayGeneration = vertexArrayGeneration;
+        m_vertexArray = nullptr;
+    }
+    const int textureGeneration = s_textureGeneration.loadRelaxed();
+    if (m_textureGeneration != textureGeneration) {
+        m_textureGeneration = textureGeneration;
+        m_activeTexture = 0;
+        for (int i = 0; i < textureUnitCount; i++)
+            m_texturesKnown[i] = false;
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,74 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef GLSTATECACHE_P_H
+#define GLSTATECACHE_P_H
+
+#include "datavisualizationglobal_p.h"
+#include <QtCore/QAtomicInt>
+
+QT_FORWARD_DECLARE_CLASS(QOpenGLVertexArrayObject)
+
+QT_BEGIN_NAMESPACE
+
+// Tracks the vertex array and texture bindings made by the Drawer, so that redundant binds can be
+// skipped and bindings only need to be released once at the end of a frame.
+// Code binding or deleting vertex arrays or textures outside the Drawer must call the matching
+// mark function, which makes every cache forget what it knows. Such code must leave no vertex
+// array bound, as the caches then assume the default one is.
+class GLStateCache : protected QOpenGLFunctions
+{
+public:
+    static const int textureUnitCount = 3;
+
+    GLStateCache();
+
+    void initializeOpenGL();
+
+    // Binds vertexArray, or releases the current one if null
+    void bindVertexArray(QOpenGLVertexArrayObject *vertexArray);
+    void bindTexture(int unit, GLenum target, GLuint textureId);
+
+    // Forgets all tracked bindings, for when something else may have changed them
+    void invalidate();
+    // Releases all bindings made through the cache
+    void release();
+
+    inline quint64 bindsElided() const { return m_bindsElided; }
+
+    static void markVertexArraysChanged();
+    static void markTexturesChanged();
+    // Unbinds the vertex array and textures of the current context, whoever bound them, and marks
+    // both changed. For code that needs a clean state in the middle of a frame.
+    static void releaseCurrentBindings();
+
+private:
+    void syncGenerations();
+
+    QOpenGLVertexArrayObject *m_vertexArray;
+    GLenum m_activeTexture;
+    GLuint m_textures[textureUnitCount];
+    GLenum m_textureTargets[textureUnitCount];
+    bool m_texturesKnown[textureUnitCount];
+    GLenum m_usedTextureTargets[textureUnitCount];
+    int m_vertexArrayGeneration;
+    int m_textureGeneration;
+    quint64 m_bindsElided;
+
+    static QAtomicInt s_vertexArrayGeneration;
+    static QAtomicInt s_textureGeneration;
+};
+
+QT_END_NAMESPACE
+
+#endif
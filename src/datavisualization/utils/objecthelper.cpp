@@ -5,11 +5,19 @@
 #include "vertexindexer_p.h"
 #include "objecthelper_p.h"
 
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtGui/QOpenGLContext>
+
 QT_BEGIN_NAMESPACE
 
 ObjectHelper::ObjectHelper(const QString &objectFile)
-    : m_objectFile(objectFile)
+    : m_objectFile(objectFile),
+      m_cacheKey(nullptr),
+      m_cacheThread(nullptr)
 {
+    // Mesh files may use texture coordinates outside [0, 1], so keep them as floats
+    setVertexFormat(InterleavedNormals | ShortIndices);
     load();
 }
 
@@ -18,8 +26,19 @@ struct ObjectHelperRef {
     ObjectHelper *obj;
 };
 
-// The "Abstract3DRenderer *" key identifies the renderer
-static QHash<const Abstract3DRenderer *, QHash<QString, ObjectHelperRef *> *> cacheTable;
+// Meshes are shared by all renderers on the same thread whose contexts share GPU resources,
+// so the key is the context share group and the thread. Without a current context the
+// "Abstract3DRenderer *" identifies the cache instead.
+typedef QPair<const void *, const QThread *> ObjectCacheKey;
+static QHash<ObjectCacheKey, QHash<QString, ObjectHelperRef *> *> cacheTable;
+static QMutex cacheTableMutex;
+
+static ObjectCacheKey cacheKey(const Abstract3DRenderer *cacheId)
+{
+    if (QOpenGLContext *context = QOpenGLContext::currentContext())
+        return ObjectCacheKey(context->shareGroup(), QThread::currentThread());
+    return ObjectCacheKey(cacheId, QThread::currentThread());
+}
 
 ObjectHelper::~ObjectHelper()
 {
@@ -42,9 +61,13 @@ void ObjectHelper::resetObjectHelper(const Abstract3DRenderer *cacheId, ObjectHe
 void ObjectHelper::releaseObjectHelper(const Abstract3DRenderer *cacheId, ObjectHelper *&obj)
 {
     Q_ASSERT(cacheId);
+    Q_UNUSED(cacheId);
 
     if (obj) {
-        QHash<QString, ObjectHelperRef *> *objectTable = cacheTable.value(cacheId, 0);
+        // The object may be released from a different context than the one it was created in
+        QMutexLocker locker(&cacheTableMutex);
+        const ObjectCacheKey key(obj->m_cacheKey, obj->m_cacheThread);
+        QHash<QString, ObjectHelperRef *> *objectTable = cacheTable.value(key, 0);
         if (objectTable) {
             // Delete object if last reference is released
             ObjectHelperRef *objRef = objectTable->value(obj->m_objectFile, 0);
@@ -58,7 +81,7 @@ void ObjectHelper::releaseObjectHelper(const Abstract3DRenderer *cacheId, Object
             }
             if (objectTable->isEmpty()) {
                 // Remove the entire cache if last object was removed
-                cacheTable.remove(cacheId);
+                cacheTable.remove(key);
                 delete objectTable;
             }
         } else {
@@ -69,16 +92,38 @@ void ObjectHelper::releaseObjectHelper(const Abstract3DRenderer *cacheId, Object
     }
 }
 
+void ObjectHelper::rekeyObjectHelper(const Abstract3DRenderer *cacheId, ObjectHelper *&obj)
+{
+    Q_ASSERT(cacheId);
+
+    if (!obj)
+        return;
+
+    {
+        QMutexLocker locker(&cacheTableMutex);
+        const ObjectCacheKey key = cacheKey(cacheId);
+        if (key.first == obj->m_cacheKey && key.second == obj->m_cacheThread)
+            return;
+    }
+
+    // Copied, as releasing may delete the object
+    const QString meshFile = obj->objectFile();
+    releaseObjectHelper(cacheId, obj);
+    obj = getObjectHelper(cacheId, meshFile);
+}
+
 ObjectHelper *ObjectHelper::getObjectHelper(const Abstract3DRenderer *cacheId,
                                             const QString &objectFile)
 {
     if (objectFile.isEmpty())
         return 0;
 
-    QHash<QString, ObjectHelperRef *> *objectTable = cacheTable.value(cacheId, 0);
+    QMutexLocker locker(&cacheTableMutex);
+    const ObjectCacheKey key = cacheKey(cacheId);
+    QHash<QString, ObjectHelperRef *> *objectTable = cacheTable.value(key, 0);
     if (!objectTable) {
         objectTable = new QHash<QString, ObjectHelperRef *>;
-        cacheTable.insert(cacheId, objectTable);
+        cacheTable.insert(key, objectTable);
     }
 
     // Check if object helper for this mesh already exists
@@ -87,6 +132,8 @@ ObjectHelper *ObjectHelper::getObjectHelper(const Abstract3DRenderer *cacheId,
         objRef = new ObjectHelperRef;
         objRef->refCount = 0;
         objRef->obj = new ObjectHelper(objectFile);
+        objRef->obj->m_cacheKey = key.first;
+        objRef->obj->m_cacheThread = key.second;
         if (objRef->obj->m_meshDataLoaded) {
             objectTable->insert(objectFile, objRef);
         } else {
@@ -104,20 +151,17 @@ ObjectHelper *ObjectHelper::getObjectHelper(const Abstract3DRenderer *cacheId,
 
 void ObjectHelper::load()
 {
+    beginBufferUpdate();
     if (m_meshDataLoaded) {
         // Delete old data
-        glDeleteBuffers(1, &m_vertexbuffer);
-        glDeleteBuffers(1, &m_uvbuffer);
-        glDeleteBuffers(1, &m_normalbuffer);
-        glDeleteBuffers(1, &m_elementbuffer);
+        deleteBuffer(m_vertexbuffer);
+        deleteBuffer(m_uvbuffer);
+        deleteBuffer(m_normalbuffer);
+        deleteBuffer(m_elementbuffer);
         m_indices.clear();
         m_indexedVertices.clear();
         m_indexedUVs.clear();
         m_indexedNormals.clear();
-        m_vertexbuffer = 0;
-        m_uvbuffer = 0;
-        m_normalbuffer = 0;
-        m_elementbuffer = 0;
     }
     QList<QVector3D> vertices;
     QList<QVector2D> uvs;
@@ -134,30 +178,22 @@ void ObjectHelper::load()
 
         m_indexCount = m_indices.size();
 
-        glGenBuffers(1, &m_vertexbuffer);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
-        glBufferData(GL_ARRAY_BUFFER, m_indexedVertices.size() * sizeof(QVector3D),
-                     &m_indexedVertices.at(0),
-                     GL_STATIC_DRAW);
-
-        glGenBuffers(1, &m_normalbuffer);
-        glBindBuffer(GL_ARRAY_BUFFER, m_normalbuffer);
-        glBufferData(GL_ARRAY_BUFFER, m_indexedNormals.size() * sizeof(QVector3D),
-                     &m_indexedNormals.at(0),
-                     GL_STATIC_DRAW);
-
-        glGenBuffers(1, &m_uvbuffer);
-        glBindBuffer(GL_ARRAY_BUFFER, m_uvbuffer);
-        glBufferData(GL_ARRAY_BUFFER, m_indexedUVs.size() * sizeof(QVector2D),
-                     &m_indexedUVs.at(0), GL_STATIC_DRAW);
-
-        glGenBuffers(1, &m_elementbuffer);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementbuffer);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(GLuint),
-                     &m_indices.at(0), GL_STATIC_DRAW);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        if (!m_indexedVertices.isEmpty()) {
+            m_minBounds = m_indexedVertices.at(0);
+            m_maxBounds = m_minBounds;
+            for (const QVector3D &vertex : std::as_const(m_indexedVertices)) {
+                for (int i = 0; i < 3; i++) {
+                    m_minBounds[i] = qMin(m_minBounds[i], vertex[i]);
+                    m_maxBounds[i] = qMax(m_maxBounds[i], vertex[i]);
+                }
+            }
+        }
+
+        uploadVertices(m_indexedVertices.constData(), m_indexedVertices.size(),
+                       m_indexedNormals.constData(), m_indexedNormals.size(), GL_STATIC_DRAW);
+        uploadUVs(m_uvbuffer, m_indexedUVs.constData(), m_indexedUVs.size(), GL_STATIC_DRAW);
+        m_indexType = uploadIndices(m_elementbuffer, m_indices.constData(), m_indices.size(),
+                                    GL_STATIC_DRAW);
 
         m_meshDataLoaded = true;
     }
@@ -20,6 +20,7 @@
 QT_BEGIN_NAMESPACE
 
 class Abstract3DRenderer;
+class QThread;
 
 class ObjectHelper : public AbstractObjectHelper
 {
@@ -31,12 +32,18 @@ public:
     static void resetObjectHelper(const Abstract3DRenderer *cacheId, ObjectHelper *&obj,
                                   const QString &meshFile);
     static void releaseObjectHelper(const Abstract3DRenderer *cacheId, ObjectHelper *&obj);
+    // Replaces obj with the same mesh from the cache of the current context and thread,
+    // if it was acquired for another one
+    static void rekeyObjectHelper(const Abstract3DRenderer *cacheId, ObjectHelper *&obj);
     inline const QString &objectFile() { return m_objectFile; }
 
     inline const QList<GLuint> &indices() const { return m_indices; }
     inline const QList<QVector3D> &indexedvertices() const { return m_indexedVertices; }
     inline const QList<QVector2D> &indexedUVs() const { return m_indexedUVs; }
     inline const QList<QVector3D> &indexedNormals() const { return m_indexedNormals; }
+    // Bounding box of the mesh vertices in model space
+    inline const QVector3D &minBounds() const { return m_minBounds; }
+    inline const QVector3D &maxBounds() const { return m_maxBounds; }
 
 private:
     static ObjectHelper *getObjectHelper(const Abstract3DRenderer *cacheId,
@@ -44,10 +51,14 @@ private:
     void load();
 
     QString m_objectFile;
+    const void *m_cacheKey;
+    const QThread *m_cacheThread;
     QList<GLuint> m_indices;
     QList<QVector3D> m_indexedVertices;
     QList<QVector2D> m_indexedUVs;
     QList<QVector3D> m_indexedNormals;
+    QVector3D m_minBounds;
+    QVector3D m_maxBounds;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,170 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "occlusionbuffer_p.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+// Size of the buffer cells in pixels
+const int occlusionCellSize = 8;
+// Scales tried when fitting the covered rectangle inside the outline of an occluder
+const float occluderRectScales[] = { 0.9f, 0.7f, 0.5f };
+
+static inline float cross(const QVector2D &origin, const QVector2D &a, const QVector2D &b)
+{
+    return (a.x() - origin.x()) * (b.y() - origin.y())
+            - (a.y() - origin.y()) * (b.x() - origin.x());
+}
+
+OcclusionBuffer::OcclusionBuffer()
+    : m_columns(0),
+      m_rows(0)
+{
+}
+
+void OcclusionBuffer::reset(const QMatrix4x4 &projectionViewMatrix, const QSize &viewportSize)
+{
+    m_projectionViewMatrix = projectionViewMatrix;
+    m_columns = qMax(1, (viewportSize.width() + occlusionCellSize - 1) / occlusionCellSize);
+    m_rows = qMax(1, (viewportSize.height() + occlusionCellSize - 1) / occlusionCellSize);
+    m_depths.fill(std::numeric_limits<float>::max(), m_columns * m_rows);
+}
+
+bool OcclusionBuffer::isOccluded(const QVector3D &minimum, const QVector3D &maximum) const
+{
+    QVector3D corners[8];
+    if (m_depths.isEmpty() || !projectBox(minimum, maximum, corners))
+        return false;
+
+    QVector3D low = corners[0];
+    QVector3D high = corners[0];
+    for (int i = 1; i < 8; i++) {
+        for (int j = 0; j < 3; j++) {
+            low[j] = qMin(low[j], corners[i][j]);
+            high[j] = qMax(high[j], corners[i][j]);
+        }
+    }
+
+    // Parts outside the viewport are not visible, so only the cells inside are checked
+    const int firstColumn = int(std::floor(qBound(0.0f, low.x(), float(m_columns))));
+    const int lastColumn = int(std::ceil(qBound(0.0f, high.x(), float(m_columns)))) - 1;
+    const int firstRow = int(std::floor(qBound(0.0f, low.y(), float(m_rows))));
+    const int lastRow = int(std::ceil(qBound(0.0f, high.y(), float(m_rows)))) - 1;
+    if (firstColumn > lastColumn || firstRow > lastRow)
+        return false;
+
+    const float nearest = low.z();
+    for (int row = firstRow; row <= lastRow; row++) {
+        const float *depths = m_depths.constData() + row * m_columns;
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            if (depths[column] >= nearest)
+                return false;
+        }
+    }
+    return true;
+}
+
+void OcclusionBuffer::addOccluder(const QVector3D &minimum, const QVector3D &maximum)
+{
+    QVector3D corners[8];
+    if (m_depths.isEmpty() || !projectBox(minimum, maximum, corners))
+        return;
+
+    QVector2D points[8];
+    float farthest = corners[0].z();
+    for (int i = 0; i < 8; i++) {
+        // Boxes reaching far outside the viewport are not worth the precision issues
+        if (qAbs(corners[i].x()) > 2.0f * m_columns || qAbs(corners[i].y()) > 2.0f * m_rows)
+            return;
+        points[i] = corners[i].toVector2D();
+        farthest = qMax(farthest, corners[i].z());
+    }
+
+    // Counterclockwise convex outline of the projected corners
+    std::sort(points, points + 8, [](const QVector2D &a, const QVector2D &b) {
+        return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+    });
+    QVector2D outline[16];
+    int count = 0;
+    for (int i = 0; i < 8; i++) {
+        while (count >= 2 && cross(outline[count - 2], outline[count - 1], points[i]) <= 0.0f)
+            count--;
+        outline[count++] = points[i];
+    }
+    for (int i = 6, lowerCount = count + 1; i >= 0; i--) {
+        while (count >= lowerCount
+               && cross(outline[count - 2], outline[count - 1], points[i]) <= 0.0f) {
+            count--;
+        }
+        outline[count++] = points[i];
+    }
+    // The last point repeats the first one
+    count--;
+    if (count < 3)
+        return;
+
+    QVector2D center;
+    QVector2D low = outline[0];
+    QVector2D high = outline[0];
+    for (int i = 0; i < count; i++) {
+        center += outline[i];
+        low.setX(qMin(low.x(), outline[i].x()));
+        low.setY(qMin(low.y(), outline[i].y()));
+        high.setX(qMax(high.x(), outline[i].x()));
+        high.setY(qMax(high.y(), outline[i].y()));
+    }
+    center /= float(count);
+
+    // Shrink the bounding rectangle towards the center until the outline contains it
+    for (float scale : occluderRectScales) {
+        const QVector2D rectLow = center + (low - center) * scale;
+        const QVector2D rectHigh = center + (high - center) * scale;
+        const QVector2D rectCorners[4] = { rectLow, QVector2D(rectHigh.x(), rectLow.y()),
+                                           rectHigh, QVector2D(rectLow.x(), rectHigh.y()) };
+        bool inside = true;
+        for (int i = 0; i < count && inside; i++) {
+            const QVector2D &edgeStart = outline[i];
+            const QVector2D &edgeEnd = outline[(i + 1) % count];
+            for (int j = 0; j < 4 && inside; j++)
+                inside = cross(edgeStart, edgeEnd, rectCorners[j]) >= 0.0f;
+        }
+        if (!inside)
+            continue;
+
+        // Only the cells completely inside the rectangle are covered
+        const int firstColumn = qMax(0, int(std::ceil(rectLow.x())));
+        const int lastColumn = qMin(m_columns, int(std::floor(rectHigh.x()))) - 1;
+        const int firstRow = qMax(0, int(std::ceil(rectLow.y())));
+        const int lastRow = qMin(m_rows, int(std::floor(rectHigh.y()))) - 1;
+        for (int row = firstRow; row <= lastRow; row++) {
+            float *depths = m_depths.data() + row * m_columns;
+            for (int column = firstColumn; column <= lastColumn; column++)
+                depths[column] = qMin(depths[column], farthest);
+        }
+        return;
+    }
+}
+
+bool OcclusionBuffer::projectBox(const QVector3D &minimum, const QVector3D &maximum,
+                                 QVector3D *corners) const
+{
+    for (int i = 0; i < 8; i++) {
+        const QVector4D corner((i & 1) ? maximum.x() : minimum.x(),
+                               (i & 2) ? maximum.y() : minimum.y(),
+                               (i & 4) ? maximum.z() : minimum.z(), 1.0f);
+        const QVector4D clip = m_projectionViewMatrix * corner;
+        // Corners at or behind the camera plane can not be projected
+        if (clip.w() <= 1.0e-5f)
+            return false;
+        corners[i] = QVector3D((clip.x() / clip.w() * 0.5f + 0.5f) * m_columns,
+                               (clip.y() / clip.w() * 0.5f + 0.5f) * m_rows,
+                               clip.z() / clip.w());
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
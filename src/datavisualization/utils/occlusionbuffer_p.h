@@ -0,0 +1,52 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef OCCLUSIONBUFFER_P_H
+#define OCCLUSIONBUFFER_P_H
+
+#include "datavisualizationglobal_p.h"
+#include <QtCore/QList>
+#include <QtCore/QSize>
+#include <QtGui/QMatrix4x4>
+
+QT_BEGIN_NAMESPACE
+
+// Coarse depth buffer on the CPU for skipping objects hidden behind solid boxes drawn earlier
+// in the same pass. Each cell holds the depth of the nearest occluder covering the whole cell,
+// so an object is only reported occluded when it is behind occluders in every cell it touches.
+// Objects should be added front to back for the buffer to be effective.
+class OcclusionBuffer
+{
+public:
+    OcclusionBuffer();
+
+    // Empties the buffer for a pass drawn with the matrix into a viewport of the given size
+    void reset(const QMatrix4x4 &projectionViewMatrix, const QSize &viewportSize);
+
+    bool isOccluded(const QVector3D &minimum, const QVector3D &maximum) const;
+    // The box must be completely inside the solid part of the occluding object
+    void addOccluder(const QVector3D &minimum, const QVector3D &maximum);
+
+private:
+    bool projectBox(const QVector3D &minimum, const QVector3D &maximum,
+                    QVector3D *corners) const;
+
+    QMatrix4x4 m_projectionViewMatrix;
+    int m_columns;
+    int m_rows;
+    QList<float> m_depths;
+};
+
+QT_END_NAMESPACE
+
+#endif
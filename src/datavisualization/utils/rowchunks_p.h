@@ -0,0 +1,52 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef ROWCHUNKS_P_H
+#define ROWCHUNKS_P_H
+
+#include "datavisualizationglobal_p.h"
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+
+QT_BEGIN_NAMESPACE
+
+// Calls function(firstRow, lastRow) for consecutive chunks of at least minRowsPerChunk rows,
+// with lastRow exclusive, and returns when all chunks are done. There are at most as many chunks
+// as the global thread pool has threads. The calling thread handles the first chunk itself.
+// Other chunks run on the pool when there are free threads, and inline otherwise, so this never
+// waits on a full pool. The function must be safe to call concurrently for different rows.
+template <typename Function>
+void forEachRowChunk(int rowCount, int minRowsPerChunk, const Function &function)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int chunkCount = qBound(1, rowCount / qMax(1, minRowsPerChunk), pool->maxThreadCount());
+    const int rowsPerChunk = (rowCount + chunkCount - 1) / chunkCount;
+
+    QSemaphore chunksDone;
+    for (int chunk = 1; chunk < chunkCount; chunk++) {
+        const int firstRow = chunk * rowsPerChunk;
+        const int lastRow = qMin(firstRow + rowsPerChunk, rowCount);
+        auto task = [&function, &chunksDone, firstRow, lastRow]() {
+            function(firstRow, lastRow);
+            chunksDone.release();
+        };
+        if (!pool->tryStart(task))
+            task();
+    }
+    function(0, qMin(rowsPerChunk, rowCount));
+    chunksDone.acquire(chunkCount - 1);
+}
+
+QT_END_NAMESPACE
+
+#endif
@@ -14,6 +14,8 @@ const GLfloat ScatterObjectBufferHelper::itemScaler = 3.0f;
 ScatterObjectBufferHelper::ScatterObjectBufferHelper()
     : m_scaleY(0.0f)
 {
+    // Gradient UVs are always within [0, 1]
+    setVertexFormat(CompactFormat);
 }
 
 ScatterObjectBufferHelper::~ScatterObjectBufferHelper()
@@ -34,16 +36,13 @@ void ScatterObjectBufferHelper::fullLoad(ScatterSeriesRenderCache *cache, qreal
     uint itemCount = 0;
     QQuaternion seriesRotation(cache->meshRotation());
 
+    beginBufferUpdate();
     if (m_meshDataLoaded) {
         // Delete old data
-        glDeleteBuffers(1, &m_vertexbuffer);
-        glDeleteBuffers(1, &m_uvbuffer);
-        glDeleteBuffers(1, &m_normalbuffer);
-        glDeleteBuffers(1, &m_elementbuffer);
-        m_vertexbuffer = 0;
-        m_uvbuffer = 0;
-        m_normalbuffer = 0;
-        m_elementbuffer = 0;
+        deleteBuffer(m_vertexbuffer);
+        deleteBuffer(m_uvbuffer);
+        deleteBuffer(m_normalbuffer);
+        deleteBuffer(m_elementbuffer);
         m_meshDataLoaded = false;
     }
 
@@ -94,21 +93,22 @@ void ScatterObjectBufferHelper::fullLoad(ScatterSeriesRenderCache *cache, qreal
     cache->bufferIndices().resize(renderArraySize);
 
     for (uint i = 0; i < renderArraySize; i++) {
-        const ScatterRenderItem &item = renderArray.at(i);
-        if (!item.isVisible())
+        if (!renderArray.isVisible(i))
             continue;
         else
             cache->bufferIndices()[i] = itemCount;
 
+        const QVector3D &translation = renderArray.translation(i);
+        const QQuaternion itemRotation = renderArray.rotation(i);
         int offset = itemCount * verticeCount;
-        if (item.rotation().isIdentity()) {
+        if (itemRotation.isIdentity()) {
             for (int j = 0; j < verticeCount; j++) {
-                buffered_vertices[j + offset] = scaled_vertices[j] + item.translation();
+                buffered_vertices[j + offset] = scaled_vertices[j] + translation;
                 buffered_normals[j + offset] = indexed_normals[j];
             }
         } else {
             QMatrix4x4 matrix;
-            QQuaternion totalRotation = seriesRotation * item.rotation();
+            QQuaternion totalRotation = seriesRotation * itemRotation;
             matrix.rotate(totalRotation);
             matrix.scale(modelScaler);
             QMatrix4x4 itModelMatrix = matrix.inverted();
@@ -117,7 +117,7 @@ void ScatterObjectBufferHelper::fullLoad(ScatterSeriesRenderCache *cache, qreal
             for (int j = 0; j < verticeCount; j++) {
                 buffered_vertices[j + offset]
                         = (QVector4D(indexed_vertices[j]) * modelMatrix).toVector3D()
-                        + item.translation();
+                        + translation;
                 buffered_normals[j + offset]
                         = (QVector4D(indexed_normals[j]) * itModelMatrix).toVector3D();
             }
@@ -140,30 +140,11 @@ void ScatterObjectBufferHelper::fullLoad(ScatterSeriesRenderCache *cache, qreal
     m_indexCount = indicesCount * itemCount;
 
     if (itemCount > 0) {
-        glGenBuffers(1, &m_vertexbuffer);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
-        glBufferData(GL_ARRAY_BUFFER, verticeCount * itemCount * sizeof(QVector3D),
-                     &buffered_vertices.at(0),
-                     GL_STATIC_DRAW);
-
-        glGenBuffers(1, &m_normalbuffer);
-        glBindBuffer(GL_ARRAY_BUFFER, m_normalbuffer);
-        glBufferData(GL_ARRAY_BUFFER, normalsCount * itemCount * sizeof(QVector3D),
-                     &buffered_normals.at(0),
-                     GL_STATIC_DRAW);
-
-        glGenBuffers(1, &m_uvbuffer);
-        glBindBuffer(GL_ARRAY_BUFFER, m_uvbuffer);
-        glBufferData(GL_ARRAY_BUFFER, uvsCount * itemCount * sizeof(QVector2D),
-                     &buffered_uvs.at(0), GL_STATIC_DRAW);
-
-        glGenBuffers(1, &m_elementbuffer);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementbuffer);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesCount * itemCount * sizeof(GLint),
-                     &buffered_indices.at(0), GL_STATIC_DRAW);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        uploadVertices(buffered_vertices.constData(), verticeCount * itemCount,
+                       buffered_normals.constData(), normalsCount * itemCount, GL_STATIC_DRAW);
+        uploadUVs(m_uvbuffer, buffered_uvs.constData(), uvsCount * itemCount, GL_STATIC_DRAW);
+        m_indexType = uploadIndices(m_elementbuffer, buffered_indices.constData(),
+                                    indicesCount * itemCount, GL_STATIC_DRAW);
 
         m_meshDataLoaded = true;
     }
@@ -191,22 +172,19 @@ void ScatterObjectBufferHelper::updateUVs(ScatterSeriesRenderCache *cache)
         itemCount = createObjectGradientUVs(cache, buffered_uvs, indexed_vertices);
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_uvbuffer);
-    int itemSize = uvsCount * sizeof(QVector2D);
     if (cache->updateIndices().size()) {
         int pos = 0;
         for (int i = 0; i < updateSize; i++) {
             int index = cache->updateIndices().at(i);
-            if (renderArray.at(index).isVisible()) {
+            if (renderArray.isVisible(index)) {
                 int dataPos = cache->bufferIndices().at(index);
-                glBufferSubData(GL_ARRAY_BUFFER, itemSize * dataPos, itemSize,
-                                &buffered_uvs.at(uvsCount * pos++));
+                updateUVs(m_uvbuffer, uvsCount * dataPos, &buffered_uvs.at(uvsCount * pos++),
+                          uvsCount);
             }
         }
     } else {
-        glBufferData(GL_ARRAY_BUFFER, itemSize * itemCount, &buffered_uvs.at(0), GL_STATIC_DRAW);
+        uploadUVs(m_uvbuffer, buffered_uvs.constData(), uvsCount * itemCount, GL_STATIC_DRAW);
     }
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 uint ScatterObjectBufferHelper::createRangeGradientUVs(ScatterSeriesRenderCache *cache,
@@ -225,11 +203,10 @@ uint ScatterObjectBufferHelper::createRangeGradientUVs(ScatterSeriesRenderCache
     uint pos = 0;
     for (int i = 0; i < updateSize; i++) {
         int index = updateAll ? i : cache->updateIndices().at(i);
-        const ScatterRenderItem &item = renderArray.at(index);
-        if (!item.isVisible())
+        if (!renderArray.isVisible(index))
             continue;
 
-        float y = ((item.translation().y() + m_scaleY) * 0.5f) / m_scaleY;
+        float y = ((renderArray.translation(index).y() + m_scaleY) * 0.5f) / m_scaleY;
 
         // Avoid values near gradient texel boundary, as this causes artifacts
         // with some graphics cards.
@@ -264,8 +241,7 @@ uint ScatterObjectBufferHelper::createObjectGradientUVs(ScatterSeriesRenderCache
     uv.setX(0.0f);
     uint pos = 0;
     for (uint i = 0; i < renderArraySize; i++) {
-        const ScatterRenderItem &item = renderArray.at(i);
-        if (!item.isVisible())
+        if (!renderArray.isVisible(i))
             continue;
 
         int offset = pos * uvsCount;
@@ -293,6 +269,7 @@ void ScatterObjectBufferHelper::update(ScatterSeriesRenderCache *cache, qreal do
 
     // Index vertices
     const QList<QVector3D> indexed_vertices = dotObj->indexedvertices();
+    const QList<QVector3D> indexed_normals = dotObj->indexedNormals();
     int verticeCount = indexed_vertices.size();
 
     float itemSize = cache->itemSize() / itemScaler;
@@ -312,54 +289,64 @@ void ScatterObjectBufferHelper::update(ScatterSeriesRenderCache *cache, qreal do
     for (int i = 0; i < verticeCount; i++)
         scaled_vertices[i] = (QVector4D(indexed_vertices[i]) * modelMatrix).toVector3D();
 
+    // Interleaved buffers store normals next to the positions, so those are updated as well
     QList<QVector3D> buffered_vertices;
+    QList<QVector3D> buffered_normals;
     buffered_vertices.resize(verticeCount * updateSize);
+    buffered_normals.resize(verticeCount * updateSize);
 
     int itemCount = 0;
     for (int i = 0; i < updateSize; i++) {
         int index = updateAll ? i : cache->updateIndices().at(i);
-        const ScatterRenderItem &item = renderArray.at(index);
-        if (!item.isVisible())
+        if (!renderArray.isVisible(index))
             continue;
 
+        const QVector3D &translation = renderArray.translation(index);
+        const QQuaternion itemRotation = renderArray.rotation(index);
         const int offset = itemCount * verticeCount;
-        if (item.rotation().isIdentity()) {
-            for (int j = 0; j < verticeCount; j++)
-                buffered_vertices[j + offset] = scaled_vertices[j] + item.translation();
+        if (itemRotation.isIdentity()) {
+            for (int j = 0; j < verticeCount; j++) {
+                buffered_vertices[j + offset] = scaled_vertices[j] + translation;
+                buffered_normals[j + offset] = indexed_normals[j];
+            }
         } else {
             QMatrix4x4 matrix;
-            matrix.rotate(seriesRotation * item.rotation());
+            matrix.rotate(seriesRotation * itemRotation);
+            // Scaling is uniform, so rotation alone orients the normals
+            QMatrix4x4 itModelMatrix = matrix.inverted();
             modelMatrix = matrix.transposed();
             modelMatrix.scale(modelScaler);
 
             for (int j = 0; j < verticeCount; j++) {
                 buffered_vertices[j + offset]
                         = (QVector4D(indexed_vertices[j]) * modelMatrix).toVector3D()
-                        + item.translation();
+                        + translation;
+                buffered_normals[j + offset]
+                        = (QVector4D(indexed_normals[j]) * itModelMatrix).toVector3D();
             }
         }
         itemCount++;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
-    int sizeOfItem = verticeCount * sizeof(QVector3D);
     if (updateAll) {
         if (itemCount) {
-            glBufferData(GL_ARRAY_BUFFER, itemCount * sizeOfItem,
-                         &buffered_vertices.at(0), GL_STATIC_DRAW);
+            uploadVertices(buffered_vertices.constData(), itemCount * verticeCount,
+                           buffered_normals.constData(), itemCount * verticeCount,
+                           GL_STATIC_DRAW);
         }
     } else {
         itemCount = 0;
         for (int i = 0; i < updateSize; i++) {
             int index = updateAll ? i : cache->updateIndices().at(i);
-            if (renderArray.at(index).isVisible()) {
-                glBufferSubData(GL_ARRAY_BUFFER, cache->bufferIndices().at(index) * sizeOfItem,
-                                sizeOfItem, &buffered_vertices.at(itemCount * verticeCount));
+            if (renderArray.isVisible(index)) {
+                const int offset = itemCount * verticeCount;
+                updateVertices(cache->bufferIndices().at(index) * verticeCount,
+                               &buffered_vertices.at(offset), &buffered_normals.at(offset),
+                               verticeCount);
                 itemCount++;
             }
         }
     }
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     m_meshDataLoaded = true;
 }
@@ -2,15 +2,19 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "scatterpointbufferhelper_p.h"
-#include <QtGui/QVector2D>
+
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
-const QVector3D hiddenPos(-1000.0f, -1000.0f, -1000.0f);
+// Outside of any axis range, so the vertex shader culls the point
+const QVector3D hiddenPos(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                          std::numeric_limits<float>::max());
 
 ScatterPointBufferHelper::ScatterPointBufferHelper()
     : m_pointbuffer(0),
-      m_oldRemoveIndex(-1)
+      m_oldRemoveIndex(-1),
+      m_dataPositions(false)
 {
 }
 
@@ -27,14 +31,14 @@ GLuint ScatterPointBufferHelper::pointBuf()
     return m_pointbuffer;
 }
 
-void ScatterPointBufferHelper::pushPoint(uint pointIndex)
+void ScatterPointBufferHelper::pushPoint(ScatterSeriesRenderCache *cache, uint pointIndex)
 {
     glBindBuffer(GL_ARRAY_BUFFER, m_pointbuffer);
 
     // Pop the previous point if it is still pushed
     if (m_oldRemoveIndex >= 0) {
         glBufferSubData(GL_ARRAY_BUFFER, m_oldRemoveIndex * sizeof(QVector3D),
-                        sizeof(QVector3D), &m_bufferedPoints.at(m_oldRemoveIndex));
+                        sizeof(QVector3D), &m_removedPoint);
     }
 
     glBufferSubData(GL_ARRAY_BUFFER, pointIndex * sizeof(QVector3D),
@@ -44,6 +48,7 @@ void ScatterPointBufferHelper::pushPoint(uint pointIndex)
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     m_oldRemoveIndex = pointIndex;
+    m_removedPoint = bufferedPoint(cache->renderArray(), pointIndex);
 }
 
 void ScatterPointBufferHelper::popPoint()
@@ -51,62 +56,48 @@ void ScatterPointBufferHelper::popPoint()
     if (m_oldRemoveIndex >= 0) {
         glBindBuffer(GL_ARRAY_BUFFER, m_pointbuffer);
         glBufferSubData(GL_ARRAY_BUFFER, m_oldRemoveIndex * sizeof(QVector3D),
-                        sizeof(QVector3D), &m_bufferedPoints.at(m_oldRemoveIndex));
+                        sizeof(QVector3D), &m_removedPoint);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
     m_oldRemoveIndex = -1;
 }
 
-void ScatterPointBufferHelper::load(ScatterSeriesRenderCache *cache)
+void ScatterPointBufferHelper::load(ScatterSeriesRenderCache *cache, bool dataPositions)
 {
-    ScatterRenderItemArray &renderArray = cache->renderArray();
+    const ScatterRenderItemArray &renderArray = cache->renderArray();
     const int renderArraySize = renderArray.size();
-    m_indexCount = 0;
 
     if (m_meshDataLoaded) {
         // Delete old data
         glDeleteBuffers(1, &m_pointbuffer);
-        glDeleteBuffers(1, &m_uvbuffer);
-        m_bufferedPoints.clear();
         m_pointbuffer = 0;
-        m_uvbuffer = 0;
         m_meshDataLoaded = false;
     }
+    // The new buffers have no hidden point
+    m_oldRemoveIndex = -1;
+    m_dataPositions = dataPositions;
 
-    bool itemsVisible = false;
-    m_bufferedPoints.resize(renderArraySize);
-    for (int i = 0; i < renderArraySize; i++) {
-        const ScatterRenderItem &item = renderArray.at(i);
-        if (!item.isVisible()) {
-            m_bufferedPoints[i] = hiddenPos;
-        } else {
-            itemsVisible = true;
-            m_bufferedPoints[i] = item.translation();
-        }
-    }
-
-    QList<QVector2D> buffered_uvs;
-    if (itemsVisible)
-        m_indexCount = renderArraySize;
+    // All items are buffered, and the items outside the axis ranges are culled in the vertex
+    // shader. Data positions are culled against the ranges, so range changes need no reload.
+    m_indexCount = renderArraySize;
 
     if (m_indexCount > 0) {
-        if (cache->colorStyle() == Q3DTheme::ColorStyleRangeGradient)
-            createRangeGradientUVs(cache, buffered_uvs);
-
         glGenBuffers(1, &m_pointbuffer);
         glBindBuffer(GL_ARRAY_BUFFER, m_pointbuffer);
-        glBufferData(GL_ARRAY_BUFFER, m_bufferedPoints.size() * sizeof(QVector3D),
-                     &m_bufferedPoints.at(0),
-                     GL_DYNAMIC_DRAW);
-
-        if (buffered_uvs.size()) {
-            glGenBuffers(1, &m_uvbuffer);
-            glBindBuffer(GL_ARRAY_BUFFER, m_uvbuffer);
-            glBufferData(GL_ARRAY_BUFFER, buffered_uvs.size() * sizeof(QVector2D),
-                         &buffered_uvs.at(0), GL_STATIC_DRAW);
+        if (m_dataPositions) {
+            glBufferData(GL_ARRAY_BUFFER, renderArraySize * sizeof(QVector3D),
+                         renderArray.positions().constData(), GL_DYNAMIC_DRAW);
+        } else if (renderArray.visibleCount() == renderArraySize) {
+            glBufferData(GL_ARRAY_BUFFER, renderArraySize * sizeof(QVector3D),
+                         renderArray.translations().constData(), GL_DYNAMIC_DRAW);
+        } else {
+            QList<QVector3D> bufferedPoints(renderArraySize);
+            for (int i = 0; i < renderArraySize; i++)
+                bufferedPoints[i] = bufferedPoint(renderArray, i);
+            glBufferData(GL_ARRAY_BUFFER, renderArraySize * sizeof(QVector3D),
+                         bufferedPoints.constData(), GL_DYNAMIC_DRAW);
         }
-
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
         m_meshDataLoaded = true;
@@ -115,79 +106,47 @@ void ScatterPointBufferHelper::load(ScatterSeriesRenderCache *cache)
 
 void ScatterPointBufferHelper::update(ScatterSeriesRenderCache *cache)
 {
-    // It may be that the buffer hasn't yet been initialized, in case the entire series was
-    // hidden items. No need to update in that case.
+    // It may be that the buffer hasn't yet been initialized, in case the series was empty.
+    // No need to update in that case.
     if (m_indexCount > 0) {
         const ScatterRenderItemArray &renderArray = cache->renderArray();
-        const int updateSize = cache->updateIndices().size();
+        const QList<int> &updateIndices = cache->updateIndices();
+        const int updateSize = updateIndices.size();
+        QList<QVector3D> points;
 
         glBindBuffer(GL_ARRAY_BUFFER, m_pointbuffer);
-        for (int i = 0; i < updateSize; i++) {
-            int index = cache->updateIndices().at(i);
-            const ScatterRenderItem &item = renderArray.at(index);
-            if (!item.isVisible())
-                m_bufferedPoints[index] = hiddenPos;
-            else
-                m_bufferedPoints[index] = item.translation();
-
-            if (index != m_oldRemoveIndex) {
-                glBufferSubData(GL_ARRAY_BUFFER, index * sizeof(QVector3D),
-                                sizeof(QVector3D), &m_bufferedPoints.at(index));
-            }
-        }
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    }
-}
-
-void ScatterPointBufferHelper::updateUVs(ScatterSeriesRenderCache *cache)
-{
-    // It may be that the buffer hasn't yet been initialized, in case the entire series was
-    // hidden items. No need to update in that case.
-    if (m_indexCount > 0) {
-        QList<QVector2D> buffered_uvs;
-        createRangeGradientUVs(cache, buffered_uvs);
-
-        if (buffered_uvs.size()) {
-            if (!m_uvbuffer)
-                glGenBuffers(1, &m_uvbuffer);
-
-            int updateSize = cache->updateIndices().size();
-            glBindBuffer(GL_ARRAY_BUFFER, m_uvbuffer);
-            if (updateSize) {
-                for (int i = 0; i < updateSize; i++) {
-                    int index = cache->updateIndices().at(i);
-                    glBufferSubData(GL_ARRAY_BUFFER, index * sizeof(QVector2D),
-                                    sizeof(QVector2D), &buffered_uvs.at(i));
-
+        // Runs of consecutive indices, such as the items overwritten by a proxy with a
+        // capacity, are uploaded with one call
+        for (int i = 0; i < updateSize;) {
+            const int first = updateIndices.at(i);
+            int count = 1;
+            while (i + count < updateSize && updateIndices.at(i + count) == first + count)
+                count++;
+
+            points.resize(count);
+            for (int j = 0; j < count; j++) {
+                const int index = first + j;
+                points[j] = bufferedPoint(renderArray, index);
+                if (index == m_oldRemoveIndex) {
+                    // Keep the pushed point hidden until it is popped
+                    m_removedPoint = points.at(j);
+                    points[j] = hiddenPos;
                 }
-            } else {
-                glBufferData(GL_ARRAY_BUFFER, buffered_uvs.size() * sizeof(QVector2D),
-                             &buffered_uvs.at(0), GL_STATIC_DRAW);
             }
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(QVector3D),
+                            count * sizeof(QVector3D), points.constData());
+            i += count;
         }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 }
 
-void ScatterPointBufferHelper::createRangeGradientUVs(ScatterSeriesRenderCache *cache,
-                                                      QList<QVector2D> &buffered_uvs)
+QVector3D ScatterPointBufferHelper::bufferedPoint(const ScatterRenderItemArray &renderArray,
+                                                  int index) const
 {
-    const ScatterRenderItemArray &renderArray = cache->renderArray();
-    const bool updateAll = (cache->updateIndices().size() == 0);
-    const int updateSize = updateAll ? renderArray.size() : cache->updateIndices().size();
-    buffered_uvs.resize(updateSize);
-
-    QVector2D uv;
-    uv.setX(0.0f);
-    for (int i = 0; i < updateSize; i++) {
-        int index = updateAll ? i : cache->updateIndices().at(i);
-        const ScatterRenderItem &item = renderArray.at(index);
-
-        float y = ((item.translation().y() + m_scaleY) * 0.5f) / m_scaleY;
-        uv.setY(y);
-        buffered_uvs[i] = uv;
-    }
+    if (m_dataPositions)
+        return renderArray.position(index);
+    return renderArray.isVisible(index) ? renderArray.translation(index) : hiddenPos;
 }
 
 QT_END_NAMESPACE
@@ -28,23 +28,25 @@ public:
 
     GLuint pointBuf();
 
-    void pushPoint(uint pointIndex);
+    // Hides the point until it is popped
+    void pushPoint(ScatterSeriesRenderCache *cache, uint pointIndex);
     void popPoint();
-    void load(ScatterSeriesRenderCache *cache);
+    // With dataPositions, the buffer holds data space positions that are mapped to the axes
+    // in the vertex shader. Otherwise it holds the translations of the render items.
+    void load(ScatterSeriesRenderCache *cache, bool dataPositions);
     void update(ScatterSeriesRenderCache *cache);
-    void setScaleY(float scale) { m_scaleY = scale; }
-    void updateUVs(ScatterSeriesRenderCache *cache);
+    inline bool hasDataPositions() const { return m_dataPositions; }
 
 public:
     GLuint m_pointbuffer;
 
 private:
-    void createRangeGradientUVs(ScatterSeriesRenderCache *cache, QList<QVector2D> &buffered_uvs);
+    QVector3D bufferedPoint(const ScatterRenderItemArray &renderArray, int index) const;
 
 private:
-    QList<QVector3D> m_bufferedPoints;
     int m_oldRemoveIndex;
-    float m_scaleY;
+    QVector3D m_removedPoint;
+    bool m_dataPositions;
 };
 
 QT_END_NAMESPACE
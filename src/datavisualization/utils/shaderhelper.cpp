@@ -3,6 +3,10 @@
 
 #include "shaderhelper_p.h"
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtGui/QOpenGLContext>
 #include <QtOpenGL/QOpenGLShader>
 
 QT_BEGIN_NAMESPACE
@@ -15,6 +19,24 @@ void discardDebugMsgs(QtMsgType type, const QMessageLogContext &context, const Q
     // Used to discard warnings generated during shader test compilation
 }
 
+struct ShaderProgramRef {
+    int refCount;
+    QOpenGLShaderProgram *program;
+};
+
+// Linked programs are shared by all graphs that render on the same thread with contexts that
+// share GPU resources. Every draw sets the uniforms it uses, so sharing a program between
+// renderers does not leak state from one graph to another.
+typedef QPair<const QOpenGLContextGroup *, const QThread *> ProgramGroupKey;
+static QHash<ProgramGroupKey, QHash<QString, ShaderProgramRef *> *> programTable;
+static QMutex programTableMutex;
+static QAtomicInt threadGeneration;
+
+static QString programKey(const QString &vertexShader, const QString &fragmentShader)
+{
+    return vertexShader + QLatin1Char('\n') + fragmentShader;
+}
+
 ShaderHelper::ShaderHelper(QObject *parent,
                            const QString &vertexShader,
                            const QString &fragmentShader,
@@ -22,6 +44,9 @@ ShaderHelper::ShaderHelper(QObject *parent,
                            const QString &depthTexture)
     : m_caller(parent),
       m_program(0),
+      m_programGroup(nullptr),
+      m_programThread(nullptr),
+      m_threadGeneration(threadGeneration.loadRelaxed()),
       m_vertexShaderFile(vertexShader),
       m_fragmentShaderFile(fragmentShader),
       m_textureFile(texture),
@@ -55,13 +80,21 @@ ShaderHelper::ShaderHelper(QObject *parent,
       m_minBoundsUniform(0),
       m_maxBoundsUniform(0),
       m_sliceFrameWidthUniform(0),
+      m_pointSizeUniform(0),
+      m_selectionGridUniform(0),
+      m_axisMinUniform(0),
+      m_axisRangeUniform(0),
+      m_axisLogUniform(0),
+      m_axisScaleUniform(0),
+      m_axisOffsetUniform(0),
+      m_polarRadiusUniform(0),
       m_initialized(false)
 {
 }
 
 ShaderHelper::~ShaderHelper()
 {
-    delete m_program;
+    releaseProgram();
 }
 
 void ShaderHelper::setShaders(const QString &vertexShader,
@@ -80,20 +113,109 @@ void ShaderHelper::setTextures(const QString &texture,
 
 void ShaderHelper::initialize()
 {
-    if (m_program)
-        delete m_program;
-    m_program = new QOpenGLShaderProgram(m_caller);
+    releaseProgram();
+    if (acquireSharedProgram()) {
+        resolveLocations();
+        return;
+    }
+
+    m_program = new QOpenGLShaderProgram();
     if (!m_program->addShaderFromSourceFile(QOpenGLShader::Vertex, m_vertexShaderFile))
         qFatal("Compiling Vertex shader failed");
     if (!m_program->addShaderFromSourceFile(QOpenGLShader::Fragment, m_fragmentShaderFile))
         qFatal("Compiling Fragment shader failed");
 
+    m_program->bindAttributeLocation("vertexPosition_mdl", PositionAttribute);
+    m_program->bindAttributeLocation("vertexNormal_mdl", NormalAttribute);
+    m_program->bindAttributeLocation("vertexUV", UVAttribute);
+
     if (!m_program->link()) {
         qWarning() << "Unable to link shader program:" <<
                       m_vertexShaderFile << m_fragmentShaderFile;
         return;
     }
 
+    if (QOpenGLContext *context = QOpenGLContext::currentContext()) {
+        QMutexLocker locker(&programTableMutex);
+        m_programGroup = context->shareGroup();
+        const ProgramGroupKey groupKey(m_programGroup, QThread::currentThread());
+        QHash<QString, ShaderProgramRef *> *groupTable = programTable.value(groupKey, 0);
+        if (!groupTable) {
+            groupTable = new QHash<QString, ShaderProgramRef *>;
+            programTable.insert(groupKey, groupTable);
+        }
+        ShaderProgramRef *programRef = new ShaderProgramRef;
+        programRef->refCount = 1;
+        programRef->program = m_program;
+        m_programThread = QThread::currentThread();
+        m_programKey = programKey(m_vertexShaderFile, m_fragmentShaderFile);
+        groupTable->insert(m_programKey, programRef);
+    }
+
+    resolveLocations();
+}
+
+bool ShaderHelper::acquireSharedProgram()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context)
+        return false;
+
+    QMutexLocker locker(&programTableMutex);
+    const ProgramGroupKey groupKey(context->shareGroup(), QThread::currentThread());
+    QHash<QString, ShaderProgramRef *> *groupTable = programTable.value(groupKey, 0);
+    if (!groupTable)
+        return false;
+    const QString key = programKey(m_vertexShaderFile, m_fragmentShaderFile);
+    ShaderProgramRef *programRef = groupTable->value(key, 0);
+    if (!programRef)
+        return false;
+
+    programRef->refCount++;
+    m_program = programRef->program;
+    m_programGroup = context->shareGroup();
+    m_programThread = QThread::currentThread();
+    m_programKey = key;
+    return true;
+}
+
+void ShaderHelper::releaseProgram()
+{
+    m_initialized = false;
+    if (!m_program)
+        return;
+
+    QMutexLocker locker(&programTableMutex);
+    const ProgramGroupKey groupKey(m_programGroup, m_programThread);
+    QHash<QString, ShaderProgramRef *> *groupTable =
+            m_programGroup ? programTable.value(groupKey, 0) : nullptr;
+    if (groupTable) {
+        // Delete the program when the last helper using it releases it
+        ShaderProgramRef *programRef = groupTable->value(m_programKey, 0);
+        if (programRef && programRef->program == m_program) {
+            if (--programRef->refCount <= 0) {
+                groupTable->remove(m_programKey);
+                delete programRef->program;
+                delete programRef;
+            }
+        } else {
+            delete m_program;
+        }
+        if (groupTable->isEmpty()) {
+            programTable.remove(groupKey);
+            delete groupTable;
+        }
+    } else {
+        delete m_program;
+    }
+    m_program = 0;
+    m_programGroup = nullptr;
+    m_programThread = nullptr;
+    m_programKey.clear();
+}
+
+void ShaderHelper::resolveLocations()
+{
     m_positionAttr = m_program->attributeLocation("vertexPosition_mdl");
     m_normalAttr = m_program->attributeLocation("vertexNormal_mdl");
     m_uvAttr = m_program->attributeLocation("vertexUV");
@@ -124,6 +246,14 @@ void ShaderHelper::initialize()
     m_minBoundsUniform = m_program->uniformLocation("minBounds");
     m_maxBoundsUniform = m_program->uniformLocation("maxBounds");
     m_sliceFrameWidthUniform = m_program->uniformLocation("sliceFrameWidth");
+    m_pointSizeUniform = m_program->uniformLocation("pointSize");
+    m_selectionGridUniform = m_program->uniformLocation("selectionGrid");
+    m_axisMinUniform = m_program->uniformLocation("axisMin");
+    m_axisRangeUniform = m_program->uniformLocation("axisRange");
+    m_axisLogUniform = m_program->uniformLocation("axisLog");
+    m_axisScaleUniform = m_program->uniformLocation("axisScale");
+    m_axisOffsetUniform = m_program->uniformLocation("axisOffset");
+    m_polarRadiusUniform = m_program->uniformLocation("polarRadius");
     m_initialized = true;
 }
 
@@ -133,8 +263,7 @@ bool ShaderHelper::testCompile()
 
     // Discard warnings, we only need the result
     QtMessageHandler handler = qInstallMessageHandler(discardDebugMsgs);
-    if (m_program)
-        delete m_program;
+    releaseProgram();
     m_program = new QOpenGLShaderProgram();
     if (!m_program->addShaderFromSourceFile(QOpenGLShader::Vertex, m_vertexShaderFile))
         result = false;
@@ -146,8 +275,20 @@ bool ShaderHelper::testCompile()
     return result;
 }
 
+void ShaderHelper::markRenderThreadChanged()
+{
+    threadGeneration.fetchAndAddRelaxed(1);
+}
+
 void ShaderHelper::bind()
 {
+    const int generation = threadGeneration.loadRelaxed();
+    if (m_threadGeneration != generation) {
+        m_threadGeneration = generation;
+        // A program shared on another thread must not be used by two threads at once
+        if (m_programGroup && m_programThread != QThread::currentThread())
+            initialize();
+    }
     m_program->bind();
 }
 
@@ -374,6 +515,62 @@ GLint ShaderHelper::sliceFrameWidth()
     return m_sliceFrameWidthUniform;
 }
 
+GLint ShaderHelper::pointSize()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_pointSizeUniform;
+}
+
+GLint ShaderHelper::selectionGrid()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_selectionGridUniform;
+}
+
+GLint ShaderHelper::axisMin()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_axisMinUniform;
+}
+
+GLint ShaderHelper::axisRange()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_axisRangeUniform;
+}
+
+GLint ShaderHelper::axisLog()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_axisLogUniform;
+}
+
+GLint ShaderHelper::axisScale()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_axisScaleUniform;
+}
+
+GLint ShaderHelper::axisOffset()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_axisOffsetUniform;
+}
+
+GLint ShaderHelper::polarRadius()
+{
+    if (!m_initialized)
+        qFatal("Shader not initialized");
+    return m_polarRadiusUniform;
+}
+
 GLint ShaderHelper::posAtt()
 {
     if (!m_initialized)
@@ -17,12 +17,22 @@
 #include "datavisualizationglobal_p.h"
 
 QT_FORWARD_DECLARE_CLASS(QOpenGLShaderProgram)
+QT_FORWARD_DECLARE_CLASS(QOpenGLContextGroup)
+QT_FORWARD_DECLARE_CLASS(QThread)
 
 QT_BEGIN_NAMESPACE
 
 class ShaderHelper
 {
     public:
+    // Vertex attributes are bound to fixed locations in all shaders,
+    // so that one vertex array object per mesh works with any of them.
+    enum AttributeLocation {
+        PositionAttribute = 0,
+        NormalAttribute,
+        UVAttribute
+    };
+
     ShaderHelper(QObject *parent,
                  const QString &vertexShader = QString(),
                  const QString &fragmentShader = QString(),
@@ -35,6 +45,9 @@ class ShaderHelper
 
     void initialize();
     bool testCompile();
+    // Makes shared programs get reacquired for the current thread on their next bind, after a
+    // renderer has moved to another thread
+    static void markRenderThreadChanged();
     void bind();
     void release();
     void setUniformValue(GLint uniform, const QVector2D &value);
@@ -71,14 +84,31 @@ class ShaderHelper
     GLint maxBounds();
     GLint minBounds();
     GLint sliceFrameWidth();
+    GLint pointSize();
+    GLint selectionGrid();
+    GLint axisMin();
+    GLint axisRange();
+    GLint axisLog();
+    GLint axisScale();
+    GLint axisOffset();
+    GLint polarRadius();
 
     GLint posAtt();
     GLint uvAtt();
     GLint normalAtt();
 
     private:
+    bool acquireSharedProgram();
+    void releaseProgram();
+    void resolveLocations();
+
     QObject *m_caller;
     QOpenGLShaderProgram *m_program;
+    // Set when m_program is shared with other helpers in the same context share group
+    QOpenGLContextGroup *m_programGroup;
+    QThread *m_programThread;
+    QString m_programKey;
+    int m_threadGeneration;
 
     QString m_vertexShaderFile;
     QString m_fragmentShaderFile;
@@ -116,6 +146,14 @@ class ShaderHelper
     GLint m_minBoundsUniform;
     GLint m_maxBoundsUniform;
     GLint m_sliceFrameWidthUniform;
+    GLint m_pointSizeUniform;
+    GLint m_selectionGridUniform;
+    GLint m_axisMinUniform;
+    GLint m_axisRangeUniform;
+    GLint m_axisLogUniform;
+    GLint m_axisScaleUniform;
+    GLint m_axisOffsetUniform;
+    GLint m_polarRadiusUniform;
 
     GLboolean m_initialized;
 };
@@ -8,6 +8,10 @@
 
 QT_BEGIN_NAMESPACE
 
+// Largest number of samples per axis for 16-bit UVs. Selection rounds the grid UVs to the
+// nearest sample, which needs neighboring samples to be at least two UV steps apart.
+const int maxPackedUVSamples = 32768;
+
 SurfaceObject::SurfaceObject(Surface3DRenderer *renderer)
     : m_axisCacheX(renderer->m_axisCacheX),
       m_axisCacheY(renderer->m_axisCacheY),
@@ -20,14 +24,15 @@ SurfaceObject::SurfaceObject(Surface3DRenderer *renderer)
     glGenBuffers(1, &m_elementbuffer);
     glGenBuffers(1, &m_gridElementbuffer);
     glGenBuffers(1, &m_uvTextureBuffer);
+
+    // Surface UVs are always within [0, 1]
+    setVertexFormat(CompactFormat);
 }
 
 SurfaceObject::~SurfaceObject()
 {
-    if (QOpenGLContext::currentContext()) {
-        glDeleteBuffers(1, &m_gridElementbuffer);
-        glDeleteBuffers(1, &m_uvTextureBuffer);
-    }
+    deleteBuffer(m_gridElementbuffer);
+    deleteBuffer(m_uvTextureBuffer);
 }
 
 void SurfaceObject::setUpSmoothData(const QSurfaceDataArray &dataArray, const QRect &space,
@@ -35,6 +40,7 @@ void SurfaceObject::setUpSmoothData(const QSurfaceDataArray &dataArray, const QR
 {
     m_columns = space.width();
     m_rows = space.height();
+    updateVertexFormat();
     int totalSize = m_rows * m_columns;
     GLfloat uvX = 1.0f / GLfloat(m_columns - 1);
     GLfloat uvY = 1.0f / GLfloat(m_rows - 1);
@@ -307,10 +313,7 @@ void SurfaceObject::smoothUVs(const QSurfaceDataArray &dataArray,
     }
 
     if (uvs.size() > 0) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_uvTextureBuffer);
-        glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(QVector2D),
-                     &uvs.at(0), GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        uploadUVs(m_uvTextureBuffer, uvs.constData(), uvs.size(), GL_STATIC_DRAW);
 
         m_returnTextureBuffer = true;
     }
@@ -325,6 +328,10 @@ void SurfaceObject::updateSmoothRow(const QSurfaceDataArray &dataArray, int rowI
     for (int j = 0; j < m_columns; j++)
         getNormalizedVertex(dataRow.at(j), m_vertices[p++], polar, false);
 
+    // Normals of the neighboring rows depend on the row as well
+    markVerticesChanged(qMax(rowIndex - 1, 0) * m_columns,
+                        qMin(rowIndex + 2, m_rows) * m_columns);
+
     // Create normals
     bool upwards = (m_dataDimension == BothAscending) || (m_dataDimension == XDescending);
     int startRow = rowIndex;
@@ -355,6 +362,8 @@ void SurfaceObject::updateSmoothItem(const QSurfaceDataArray &dataArray, int row
     // Update a vertice
     getNormalizedVertex(dataArray.at(row)->at(column),
                         m_vertices[row * m_columns + column], polar, false);
+    markVerticesChanged(qMax(row - 1, 0) * m_columns + qMax(column - 1, 0),
+                        qMin(row + 1, m_rows - 1) * m_columns + qMin(column + 2, m_columns));
 
     // Create normals
     bool upwards = (m_dataDimension == BothAscending) || (m_dataDimension == XDescending);
@@ -440,13 +449,69 @@ void SurfaceObject::createSmoothIndices(int x, int y, int endX, int endY)
         }
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementbuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexCount * sizeof(GLint),
-                 indices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_indexType = uploadIndices(m_elementbuffer, reinterpret_cast<const GLuint *>(indices),
+                                m_indexCount, GL_STATIC_DRAW);
 
     delete[] indices;
+
+    // The coarser mesh is rebuilt when it is next needed
+    m_lodStep = 0;
+    m_lodActive = false;
+}
+
+void SurfaceObject::setLevelOfDetail(int step)
+{
+    if (step <= 1 || m_surfaceType != SurfaceSmooth || !m_indexCount) {
+        m_lodActive = false;
+        return;
+    }
+
+    if (step != m_lodStep) {
+        // Sample every step:th row and column, always including the last ones
+        QList<int> columns;
+        for (int j = 0; j < m_columns - 1; j += step)
+            columns.append(j);
+        columns.append(m_columns - 1);
+        QList<int> rows;
+        for (int i = 0; i < m_rows - 1; i += step)
+            rows.append(i * m_columns);
+        rows.append((m_rows - 1) * m_columns);
+
+        m_lodIndexCount = 6 * (columns.size() - 1) * (rows.size() - 1);
+        QList<GLuint> indices(m_lodIndexCount);
+        int p = 0;
+        for (int i = 0; i < rows.size() - 1; i++) {
+            const int row = rows.at(i);
+            const int upperRow = rows.at(i + 1);
+            for (int j = 0; j < columns.size() - 1; j++) {
+                const int column = columns.at(j);
+                const int nextColumn = columns.at(j + 1);
+                // Same winding as in createSmoothIndices()
+                if ((m_dataDimension == BothAscending) || (m_dataDimension == BothDescending)) {
+                    indices[p++] = row + nextColumn;
+                    indices[p++] = upperRow + column;
+                    indices[p++] = row + column;
+
+                    indices[p++] = upperRow + nextColumn;
+                    indices[p++] = upperRow + column;
+                    indices[p++] = row + nextColumn;
+                } else {
+                    indices[p++] = upperRow + column;
+                    indices[p++] = upperRow + nextColumn;
+                    indices[p++] = row + column;
+
+                    indices[p++] = row + column;
+                    indices[p++] = upperRow + nextColumn;
+                    indices[p++] = row + nextColumn;
+                }
+            }
+        }
+
+        m_lodIndexType = uploadIndices(m_lodElementbuffer, indices.constData(), m_lodIndexCount,
+                                       GL_STATIC_DRAW);
+        m_lodStep = step;
+    }
+    m_lodActive = true;
 }
 
 void SurfaceObject::createSmoothGridlineIndices(int x, int y, int endX, int endY)
@@ -478,11 +543,9 @@ void SurfaceObject::createSmoothGridlineIndices(int x, int y, int endX, int endY
         }
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_gridElementbuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_gridIndexCount * sizeof(GLint),
-                 gridIndices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_gridIndexType = uploadIndices(m_gridElementbuffer,
+                                    reinterpret_cast<const GLuint *>(gridIndices),
+                                    m_gridIndexCount, GL_STATIC_DRAW);
 
     delete[] gridIndices;
 }
@@ -492,6 +555,7 @@ void SurfaceObject::setUpData(const QSurfaceDataArray &dataArray, const QRect &s
 {
     m_columns = space.width();
     m_rows = space.height();
+    updateVertexFormat();
     int totalSize = m_rows * m_columns * 2;
     GLfloat uvX = 1.0f / GLfloat(m_columns - 1);
     GLfloat uvY = 1.0f / GLfloat(m_rows - 1);
@@ -617,10 +681,7 @@ void SurfaceObject::coarseUVs(const QSurfaceDataArray &dataArray,
     }
 
     if (uvs.size() > 0) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_uvTextureBuffer);
-        glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(QVector2D),
-                     &uvs.at(0), GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        uploadUVs(m_uvTextureBuffer, uvs.constData(), uvs.size(), GL_STATIC_DRAW);
 
         m_returnTextureBuffer = true;
     }
@@ -642,6 +703,8 @@ void SurfaceObject::updateCoarseRow(const QSurfaceDataArray &dataArray, int rowI
         }
     }
 
+    markVerticesChanged(qMax(rowIndex - 1, 0) * doubleColumns, (rowIndex + 1) * doubleColumns);
+
     // Create normals
     p = rowIndex * doubleColumns;
     if (p > 0)
@@ -670,6 +733,9 @@ void SurfaceObject::updateCoarseItem(const QSurfaceDataArray &dataArray, int row
     if (column > 0 && column < colLimit)
         m_vertices[p] = m_vertices[p - 1];
 
+    markVerticesChanged(qMax(row - 1, 0) * doubleColumns + qMax(column - 1, 0) * 2,
+                        row * doubleColumns + column * 2 + 2);
+
     // Create normals
     int startRow = row;
     if (startRow > 0)
@@ -716,11 +782,8 @@ void SurfaceObject::createCoarseSubSection(int x, int y, int columns, int rows)
             createCoarseIndices(indices, p, row, upperRow, j);
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementbuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexCount * sizeof(GLint),
-                 indices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_indexType = uploadIndices(m_elementbuffer, reinterpret_cast<const GLuint *>(indices),
+                                m_indexCount, GL_STATIC_DRAW);
 
     delete[] indices;
 }
@@ -765,51 +828,82 @@ void SurfaceObject::createCoarseGridlineIndices(int x, int y, int endX, int endY
         gridIndices[p++] = i  + doubleColumns;
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_gridElementbuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_gridIndexCount * sizeof(GLint),
-                 gridIndices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_gridIndexType = uploadIndices(m_gridElementbuffer,
+                                    reinterpret_cast<const GLuint *>(gridIndices),
+                                    m_gridIndexCount, GL_STATIC_DRAW);
 
     delete[] gridIndices;
 }
 
-void SurfaceObject::uploadBuffers()
+void SurfaceObject::uploadChangedVertices()
 {
-    QList<QVector2D> uvs; // Empty dummy
-    createBuffers(m_vertices, uvs, m_normals, 0);
+    if (m_changedFirst >= m_changedEnd)
+        return;
+
+    // Flat surfaces have no normals for the topmost row
+    const int normalEnd = qBound(m_changedFirst, int(m_normals.size()), m_changedEnd);
+    if (normalEnd > m_changedFirst) {
+        updateVertices(m_changedFirst, m_vertices.constData() + m_changedFirst,
+                       m_normals.constData() + m_changedFirst, normalEnd - m_changedFirst);
+    }
+    if (m_changedEnd > normalEnd) {
+        updateVertices(normalEnd, m_vertices.constData() + normalEnd, nullptr,
+                       m_changedEnd - normalEnd);
+    }
+    m_changedFirst = 0;
+    m_changedEnd = 0;
+}
+
+void SurfaceObject::markVerticesChanged(int first, int end)
+{
+    end = qMin(end, int(m_vertices.size()));
+    if (m_changedFirst >= m_changedEnd) {
+        m_changedFirst = first;
+        m_changedEnd = end;
+    } else {
+        m_changedFirst = qMin(m_changedFirst, first);
+        m_changedEnd = qMax(m_changedEnd, end);
+    }
 }
 
 void SurfaceObject::createBuffers(const QList<QVector3D> &vertices, const QList<QVector2D> &uvs,
                                   const QList<QVector3D> &normals, const GLint *indices)
 {
-    // Move to buffers
-    glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(QVector3D),
-                 &vertices.at(0), GL_DYNAMIC_DRAW);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_normalbuffer);
-    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(QVector3D),
-                 &normals.at(0), GL_DYNAMIC_DRAW);
-
-    if (uvs.size()) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_uvbuffer);
-        glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(QVector2D),
-                     &uvs.at(0), GL_STATIC_DRAW);
+    // Move to buffers. Buffers of the same size are rewritten in place, so that refreshing
+    // the whole surface every frame does not reallocate them.
+    if (m_meshDataLoaded && vertices.size() == m_bufferVertexCount
+            && normals.size() == m_bufferNormalCount) {
+        m_changedFirst = 0;
+        m_changedEnd = vertices.size();
+        uploadChangedVertices();
+    } else {
+        uploadVertices(vertices.constData(), vertices.size(), normals.constData(),
+                       normals.size(), GL_DYNAMIC_DRAW);
+        m_bufferVertexCount = vertices.size();
+        m_bufferNormalCount = normals.size();
+        m_changedFirst = 0;
+        m_changedEnd = 0;
     }
 
+    if (uvs.size())
+        uploadUVs(m_uvbuffer, uvs.constData(), uvs.size(), GL_STATIC_DRAW);
+
     if (indices) {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementbuffer);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexCount * sizeof(GLint),
-                     indices, GL_STATIC_DRAW);
+        m_indexType = uploadIndices(m_elementbuffer, reinterpret_cast<const GLuint *>(indices),
+                                    m_indexCount, GL_STATIC_DRAW);
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
     m_meshDataLoaded = true;
 }
 
+void SurfaceObject::updateVertexFormat()
+{
+    // Wider surfaces keep float UVs, so that selection can tell their samples apart
+    VertexFormat format = CompactFormat;
+    format.setFlag(PackedUVs, qMax(m_columns, m_rows) <= maxPackedUVSamples);
+    setVertexFormat(format);
+}
+
 void SurfaceObject::checkDirections(const QSurfaceDataArray &array)
 {
     m_dataDimension = BothAscending;
@@ -891,9 +985,15 @@ void SurfaceObject::clear()
 {
     m_gridIndexCount = 0;
     m_indexCount = 0;
+    m_lodStep = 0;
+    m_lodActive = false;
     m_surfaceType = Undefined;
     m_vertices.clear();
     m_normals.clear();
+    m_bufferVertexCount = 0;
+    m_bufferNormalCount = 0;
+    m_changedFirst = 0;
+    m_changedEnd = 0;
 }
 
 void SurfaceObject::createCoarseIndices(GLint *indices, int &p, int row, int upperRow, int j)
@@ -57,13 +57,19 @@ public:
     void updateSmoothItem(const QSurfaceDataArray &dataArray, int row, int column, bool polar);
     void updateCoarseItem(const QSurfaceDataArray &dataArray, int row, int column, bool polar);
     void createSmoothIndices(int x, int y, int endX, int endY);
+    // Activates a coarser mesh of every step:th row and column of a smooth surface, or the
+    // full mesh when step is 1
+    void setLevelOfDetail(int step);
     void createCoarseSubSection(int x, int y, int columns, int rows);
     void createSmoothGridlineIndices(int x, int y, int endX, int endY);
     void createCoarseGridlineIndices(int x, int y, int endX, int endY);
-    void uploadBuffers();
+    // Uploads the vertices and normals changed by the row and item updates since the last
+    // upload
+    void uploadChangedVertices();
     GLuint gridElementBuf();
     GLuint uvBuf() override;
     GLuint gridIndexCount();
+    inline GLenum gridIndexType() const { return m_gridIndexType; }
     QVector3D vertexAt(int column, int row);
     void clear();
     float minYValue() const { return m_minY; }
@@ -82,7 +88,10 @@ private:
     QVector3D normal(const QVector3D &a, const QVector3D &b, const QVector3D &c);
     void createBuffers(const QList<QVector3D> &vertices, const QList<QVector2D> &uvs,
                        const QList<QVector3D> &normals, const GLint *indices);
+    void updateVertexFormat();
     void checkDirections(const QSurfaceDataArray &array);
+    // Extends the range of vertices uploaded by uploadChangedVertices, end is exclusive
+    void markVerticesChanged(int first, int end);
     inline void getNormalizedVertex(const QSurfaceDataItem &data, QVector3D &vertex, bool polar,
                                     bool flipXZ);
 
@@ -92,8 +101,14 @@ private:
     int m_rows = 0;
     GLuint m_gridElementbuffer;
     GLuint m_gridIndexCount = 0;
+    GLenum m_gridIndexType = GL_UNSIGNED_INT;
+    int m_lodStep = 0;
     QList<QVector3D> m_vertices;
     QList<QVector3D> m_normals;
+    int m_bufferVertexCount = 0;
+    int m_bufferNormalCount = 0;
+    int m_changedFirst = 0;
+    int m_changedEnd = 0;
     // Caches are not owned
     AxisRenderCache &m_axisCacheX;
     AxisRenderCache &m_axisCacheY;
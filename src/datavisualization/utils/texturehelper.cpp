@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "texturehelper_p.h"
+#include "glstatecache_p.h"
 #include "utils_p.h"
 
 #include <QtGui/QImage>
@@ -44,6 +45,7 @@ TextureHelper::~TextureHelper()
 GLuint TextureHelper::create2DTexture(const QImage &image, bool useTrilinearFiltering,
                                       bool convert, bool smoothScale, bool clampY)
 {
+    GLStateCache::markTexturesChanged();
     if (image.isNull())
         return 0;
 
@@ -87,6 +89,7 @@ GLuint TextureHelper::create2DTexture(const QImage &image, bool useTrilinearFilt
 GLuint TextureHelper::create3DTexture(const QList<uchar> *data, int width, int height, int depth,
                                       QImage::Format dataFormat)
 {
+    GLStateCache::markTexturesChanged();
     if (Utils::isOpenGLES() || !width || !height || !depth)
         return 0;
 
@@ -132,6 +135,7 @@ GLuint TextureHelper::create3DTexture(const QList<uchar> *data, int width, int h
 
 GLuint TextureHelper::createCubeMapTexture(const QImage &image, bool useTrilinearFiltering)
 {
+    GLStateCache::markTexturesChanged();
     if (image.isNull())
         return 0;
 
@@ -155,6 +159,7 @@ GLuint TextureHelper::createCubeMapTexture(const QImage &image, bool useTrilinea
 GLuint TextureHelper::createSelectionTexture(const QSize &size, GLuint &frameBuffer,
                                              GLuint &depthBuffer)
 {
+    GLStateCache::markTexturesChanged();
     GLuint textureid;
 
     // Create texture for the selection buffer
@@ -216,6 +221,7 @@ GLuint TextureHelper::createSelectionTexture(const QSize &size, GLuint &frameBuf
 
 GLuint TextureHelper::createCursorPositionTexture(const QSize &size, GLuint &frameBuffer)
 {
+    GLStateCache::markTexturesChanged();
     GLuint textureid;
     glGenTextures(1, &textureid);
     glBindTexture(GL_TEXTURE_2D, textureid);
@@ -265,6 +271,7 @@ GLuint TextureHelper::createGradientTexture(const QLinearGradient &gradient)
 
 GLuint TextureHelper::createDepthTexture(const QSize &size, GLuint textureSize)
 {
+    GLStateCache::markTexturesChanged();
     GLuint depthtextureid = 0;
 #if QT_CONFIG(opengles2)
     Q_UNUSED(size);
@@ -291,6 +298,7 @@ GLuint TextureHelper::createDepthTexture(const QSize &size, GLuint textureSize)
 GLuint TextureHelper::createDepthTextureFrameBuffer(const QSize &size, GLuint &frameBuffer,
                                                     GLuint textureSize)
 {
+    GLStateCache::markTexturesChanged();
     GLuint depthtextureid = createDepthTexture(size, textureSize);
 #if QT_CONFIG(opengles2)
     Q_UNUSED(frameBuffer);
@@ -324,6 +332,7 @@ GLuint TextureHelper::createDepthTextureFrameBuffer(const QSize &size, GLuint &f
 
 void TextureHelper::deleteTexture(GLuint *texture)
 {
+    GLStateCache::markTexturesChanged();
     if (texture && *texture) {
         if (QOpenGLContext::currentContext())
             glDeleteTextures(1, texture);
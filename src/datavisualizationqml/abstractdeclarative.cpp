@@ -16,6 +16,7 @@
 #define USE_SHARED_CONTEXT
 #else
 #include "glstatestore_p.h"
+#include <QtQuick/QSGRendererInterface>
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -363,6 +364,10 @@ void AbstractDeclarative::activateOpenGLContext(QQuickWindow *window)
         // Shared contexts don't work properly in some platforms, so just store the
         // context state on those
         m_stateStore = new GLStateStore(QOpenGLContext::currentContext());
+        // The OpenGL backend of the scene graph sets its state again after external commands,
+        // so reading all of it back every frame is not needed
+        m_stateStore->setHostResetsState(window->rendererInterface()->graphicsApi()
+                                         == QSGRendererInterface::OpenGL);
         m_stateStore->storeGLState();
 #endif
         m_controller->initializeOpenGL();
@@ -391,10 +396,15 @@ void AbstractDeclarative::doneOpenGLContext(QQuickWindow *window)
 
 void AbstractDeclarative::synchDataToRenderer()
 {
+    // The GUI thread is blocked during the sync, so the controller only snapshots the changed
+    // data here. It is converted and uploaded when rendering, after the GUI thread is released.
     QQuickWindow *win = window();
+    // Lets the scene graph know it cannot rely on the GL state it has cached
+    win->beginExternalCommands();
     activateOpenGLContext(win);
     m_controller->synchDataToRenderer();
     doneOpenGLContext(win);
+    win->endExternalCommands();
 }
 
 int AbstractDeclarative::msaaSamples() const
@@ -103,7 +103,8 @@ public:
 
     enum OptimizationHint {
         OptimizationDefault = 0,
-        OptimizationStatic  = 1
+        OptimizationStatic  = 1,
+        OptimizationProgressive = 2
     };
     Q_DECLARE_FLAGS(OptimizationHints, OptimizationHint)
 
@@ -143,6 +143,19 @@ float DeclarativeBars::floorLevel() const
     return m_barsController->floorLevel();
 }
 
+void DeclarativeBars::setOcclusionCulling(bool enable)
+{
+    if (enable != isOcclusionCulling()) {
+        m_barsController->setOcclusionCulling(enable);
+        emit occlusionCullingChanged(enable);
+    }
+}
+
+bool DeclarativeBars::isOcclusionCulling() const
+{
+    return m_barsController->isOcclusionCulling();
+}
+
 QQmlListProperty<QBar3DSeries> DeclarativeBars::seriesList()
 {
     return QQmlListProperty<QBar3DSeries>(this, this,
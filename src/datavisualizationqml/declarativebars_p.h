@@ -35,6 +35,7 @@ class DeclarativeBars : public AbstractDeclarative
     Q_PROPERTY(QBar3DSeries *selectedSeries READ selectedSeries NOTIFY selectedSeriesChanged)
     Q_PROPERTY(QBar3DSeries *primarySeries READ primarySeries WRITE setPrimarySeries NOTIFY primarySeriesChanged)
     Q_PROPERTY(float floorLevel READ floorLevel WRITE setFloorLevel NOTIFY floorLevelChanged REVISION(1, 2))
+    Q_PROPERTY(bool occlusionCulling READ isOcclusionCulling WRITE setOcclusionCulling NOTIFY occlusionCullingChanged REVISION(6, 10))
     Q_CLASSINFO("DefaultProperty", "seriesList")
 
     QML_NAMED_ELEMENT(Bars3D)
@@ -81,6 +82,9 @@ public:
     void setFloorLevel(float level);
     float floorLevel() const;
 
+    void setOcclusionCulling(bool enable);
+    bool isOcclusionCulling() const;
+
 public Q_SLOTS:
     void handleAxisXChanged(QAbstract3DAxis *axis) override;
     void handleAxisYChanged(QAbstract3DAxis *axis) override;
@@ -99,6 +103,7 @@ Q_SIGNALS:
     void primarySeriesChanged(QBar3DSeries *series);
     void selectedSeriesChanged(QBar3DSeries *series);
     Q_REVISION(1, 2) void floorLevelChanged(float level);
+    Q_REVISION(6, 10) void occlusionCullingChanged(bool enable);
 
 private:
     Bars3DController *m_barsController;
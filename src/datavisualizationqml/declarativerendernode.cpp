@@ -3,6 +3,7 @@
 
 #include "declarativerendernode_p.h"
 #include "abstractdeclarative_p.h"
+#include "framebufferpool_p.h"
 #include <QtOpenGL/QOpenGLFramebufferObject>
 #include <QtCore/QMutexLocker>
 
@@ -30,8 +31,13 @@ DeclarativeRenderNode::DeclarativeRenderNode(AbstractDeclarative *declarative,
 
 DeclarativeRenderNode::~DeclarativeRenderNode()
 {
-    delete m_fbo;
-    delete m_multisampledFBO;
+    if (m_fboPool) {
+        m_fboPool->release(m_fbo);
+        m_fboPool->release(m_multisampledFBO);
+    } else {
+        delete m_fbo;
+        delete m_multisampledFBO;
+    }
     delete m_texture;
 
     m_nodeMutex.clear();
@@ -57,42 +63,64 @@ void DeclarativeRenderNode::update()
 
 void DeclarativeRenderNode::updateFBO()
 {
+    m_window->beginExternalCommands();
     m_declarative->activateOpenGLContext(m_window);
 
-    if (m_fbo)
-        delete m_fbo;
+    // Framebuffers are only reallocated when the size no longer fits them, or they have become
+    // much larger than needed. Otherwise the graph is rendered into a sub-rect of them.
+    FramebufferPool *pool = FramebufferPool::currentPool();
+    if (pool != m_fboPool) {
+        if (m_fboPool) {
+            m_fboPool->release(m_fbo);
+            m_fboPool->release(m_multisampledFBO);
+        } else {
+            delete m_fbo;
+            delete m_multisampledFBO;
+        }
+        m_fbo = 0;
+        m_multisampledFBO = 0;
+        m_fboPool = pool;
+    }
 
-    m_fbo = new QOpenGLFramebufferObject(m_size);
-    m_fbo->setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    bool textureChanged = false;
+    if (!pool->isSuitable(m_fbo, m_size, 0)) {
+        pool->release(m_fbo);
+        m_fbo = pool->acquire(m_size, 0);
+        textureChanged = true;
+    }
 
     // Multisampled
-    if (m_multisampledFBO) {
-        delete m_multisampledFBO;
-        m_multisampledFBO = 0;
-    }
     if (m_samples > 0) {
-        QOpenGLFramebufferObjectFormat multisampledFrambufferFormat;
-        multisampledFrambufferFormat.setSamples(m_samples);
-        multisampledFrambufferFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-
-        m_multisampledFBO = new QOpenGLFramebufferObject(m_size, multisampledFrambufferFormat);
+        if (!pool->isSuitable(m_multisampledFBO, m_size, m_samples)) {
+            pool->release(m_multisampledFBO);
+            m_multisampledFBO = pool->acquire(m_size, m_samples);
+        }
+    } else if (m_multisampledFBO) {
+        pool->release(m_multisampledFBO);
+        m_multisampledFBO = 0;
     }
 
+    const QSize fboSize = m_fbo->size();
+    const qreal usedWidth = qreal(m_size.width()) / qreal(fboSize.width());
+    const qreal usedHeight = qreal(m_size.height()) / qreal(fboSize.height());
     QSGGeometry::updateTexturedRectGeometry(&m_geometry,
                                             QRectF(0, 0,
                                                    m_size.width()
                                                    / m_controller->scene()->devicePixelRatio(),
                                                    m_size.height()
                                                    / m_controller->scene()->devicePixelRatio()),
-                                            QRectF(0, 1, 1, -1));
-
-    delete m_texture;
-    const uint id = m_fbo->texture();
-    m_texture = QNativeInterface::QSGOpenGLTexture::fromNative(id, m_window, m_size);
-    m_material.setTexture(m_texture);
-    m_materialO.setTexture(m_texture);
+                                            QRectF(0, usedHeight, usedWidth, -usedHeight));
+
+    if (textureChanged) {
+        delete m_texture;
+        const uint id = m_fbo->texture();
+        m_texture = QNativeInterface::QSGOpenGLTexture::fromNative(id, m_window, fboSize);
+        m_material.setTexture(m_texture);
+        m_materialO.setTexture(m_texture);
+    }
 
     m_declarative->doneOpenGLContext(m_window);
+    m_window->endExternalCommands();
 }
 
 void DeclarativeRenderNode::setQuickWindow(QQuickWindow *window)
@@ -134,6 +162,7 @@ void DeclarativeRenderNode::preprocess()
     else
         targetFBO = m_fbo;
 
+    m_window->beginExternalCommands();
     m_declarative->activateOpenGLContext(m_window);
 
     targetFBO->bind();
@@ -142,10 +171,13 @@ void DeclarativeRenderNode::preprocess()
 
     targetFBO->release();
 
-    if (m_samples > 0)
-        QOpenGLFramebufferObject::blitFramebuffer(m_fbo, m_multisampledFBO);
+    if (m_samples > 0) {
+        const QRect usedRect(QPoint(0, 0), m_size);
+        QOpenGLFramebufferObject::blitFramebuffer(m_fbo, usedRect, m_multisampledFBO, usedRect);
+    }
 
     m_declarative->doneOpenGLContext(m_window);
+    m_window->endExternalCommands();
 }
 
 // This function is called within m_nodeMutex lock
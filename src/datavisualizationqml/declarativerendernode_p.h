@@ -22,11 +22,13 @@
 #include <QtCore/QMutex>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 
 QT_BEGIN_NAMESPACE
 
 class Abstract3DController;
 class AbstractDeclarative;
+class FramebufferPool;
 
 class DeclarativeRenderNode : public QObject, public QSGGeometryNode
 {
@@ -62,6 +64,7 @@ private:
     Abstract3DController *m_controller;
     QOpenGLFramebufferObject *m_fbo;
     QOpenGLFramebufferObject *m_multisampledFBO;
+    QPointer<FramebufferPool> m_fboPool;
     QQuickWindow *m_window;
     int m_samples;
 
@@ -34,6 +34,7 @@
 #include <QtDataVisualization/qcustom3ditem.h>
 #include <QtDataVisualization/qcustom3dlabel.h>
 #include <QtDataVisualization/qcustom3dvolume.h>
+#include <QtDataVisualization/qheightfieldsurfacedataproxy.h>
 #include <QtDataVisualization/qheightmapsurfacedataproxy.h>
 #include <QtDataVisualization/qitemmodelbardataproxy.h>
 #include <QtDataVisualization/qitemmodelscatterdataproxy.h>
@@ -102,6 +103,14 @@ DEFINE_FOREIGN_CREATABLE_TYPE(Q3DInputHandler, InputHandler3D, 2)
 DEFINE_FOREIGN_CREATABLE_TYPE(QCustom3DVolume, Custom3DVolume, 2)
 DEFINE_FOREIGN_CREATABLE_TYPE(QTouch3DInputHandler, TouchInputHandler3D, 2)
 
+struct QHeightFieldSurfaceDataProxyDataVisForeign
+{
+    Q_GADGET
+    QML_NAMED_ELEMENT(HeightFieldSurfaceDataProxy)
+    QML_FOREIGN(QHeightFieldSurfaceDataProxy)
+    QML_ADDED_IN_VERSION(6, 10)
+};
+
 DEFINE_FOREIGN_REPLACED_TYPE(Q3DTheme, Q3DTheme, Theme3D)
 DEFINE_FOREIGN_REPLACED_TYPE(QBar3DSeries, QBar3DSeries, Bar3DSeries)
 DEFINE_FOREIGN_REPLACED_TYPE(QScatter3DSeries, QScatter3DSeries, Scatter3DSeries)
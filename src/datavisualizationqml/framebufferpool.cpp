@@ -0,0 +1,121 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "framebufferpool_p.h"
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
+#include <QtOpenGL/QOpenGLFramebufferObject>
+
+QT_BEGIN_NAMESPACE
+
+// Allocations grow by a quarter over the requested size, rounded up to this granularity
+const int allocationGranularity = 64;
+// A framebuffer is not used for sizes it would be more than this many times larger than
+const int maxAreaRatio = 4;
+const int maxFreeFramebuffers = 4;
+
+FramebufferPool::FramebufferPool(QOpenGLContext *context)
+    : QObject(context),
+      m_maxSize(0)
+{
+    QOpenGLFunctions *funcs = context->functions();
+    GLint maxTextureSize = 0;
+    GLint maxRenderbufferSize = 0;
+    funcs->glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    funcs->glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRenderbufferSize);
+    m_maxSize = qMin(maxTextureSize, maxRenderbufferSize);
+}
+
+FramebufferPool::~FramebufferPool()
+{
+    qDeleteAll(m_freeFramebuffers);
+}
+
+FramebufferPool *FramebufferPool::currentPool()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    Q_ASSERT(context);
+
+    FramebufferPool *pool = context->findChild<FramebufferPool *>(QString(),
+                                                                   Qt::FindDirectChildrenOnly);
+    if (!pool)
+        pool = new FramebufferPool(context);
+    return pool;
+}
+
+QOpenGLFramebufferObject *FramebufferPool::acquire(const QSize &size, int samples)
+{
+    // Reuse the smallest suitable free framebuffer
+    int bestIndex = -1;
+    qint64 bestArea = 0;
+    for (int i = 0; i < m_freeFramebuffers.size(); i++) {
+        const QOpenGLFramebufferObject *framebuffer = m_freeFramebuffers.at(i);
+        if (isSuitable(framebuffer, size, samples)) {
+            const qint64 area = qint64(framebuffer->width()) * framebuffer->height();
+            if (bestIndex < 0 || area < bestArea) {
+                bestIndex = i;
+                bestArea = area;
+            }
+        }
+    }
+    if (bestIndex >= 0)
+        return m_freeFramebuffers.takeAt(bestIndex);
+
+    QOpenGLFramebufferObjectFormat format;
+    format.setSamples(samples);
+    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    QOpenGLFramebufferObject *framebuffer =
+            new QOpenGLFramebufferObject(allocationSize(size), format);
+    m_requestedSamples.insert(framebuffer, samples);
+    return framebuffer;
+}
+
+void FramebufferPool::release(QOpenGLFramebufferObject *framebuffer)
+{
+    if (!framebuffer)
+        return;
+
+    if (!m_requestedSamples.contains(framebuffer)) {
+        // Not allocated from this pool, e.g. by a graph moved to another window
+        delete framebuffer;
+        return;
+    }
+
+    m_freeFramebuffers.prepend(framebuffer);
+    while (m_freeFramebuffers.size() > maxFreeFramebuffers) {
+        QOpenGLFramebufferObject *oldest = m_freeFramebuffers.takeLast();
+        m_requestedSamples.remove(oldest);
+        delete oldest;
+    }
+}
+
+bool FramebufferPool::isSuitable(const QOpenGLFramebufferObject *framebuffer, const QSize &size,
+                                 int samples) const
+{
+    if (!framebuffer || m_requestedSamples.value(framebuffer, -1) != samples)
+        return false;
+
+    const QSize framebufferSize = framebuffer->size();
+    if (framebufferSize.width() < size.width() || framebufferSize.height() < size.height())
+        return false;
+
+    // Shrink only once the framebuffer has become much larger than needed, so that sizes
+    // going back and forth do not cause reallocations
+    const qint64 area = qint64(size.width()) * size.height();
+    const qint64 framebufferArea = qint64(framebufferSize.width()) * framebufferSize.height();
+    return framebufferArea <= qMax(area * maxAreaRatio,
+                                   qint64(allocationGranularity) * allocationGranularity);
+}
+
+QSize FramebufferPool::allocationSize(const QSize &size) const
+{
+    auto grow = [this](int length) {
+        int grown = length + length / 4;
+        grown = ((grown + allocationGranularity - 1) / allocationGranularity)
+                * allocationGranularity;
+        return qMax(length, qMin(grown, m_maxSize));
+    };
+    return QSize(grow(size.width()), grow(size.height()));
+}
+
+QT_END_NAMESPACE
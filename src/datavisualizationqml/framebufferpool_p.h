@@ -0,0 +1,61 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QtDataVisualization API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef FRAMEBUFFERPOOL_P_H
+#define FRAMEBUFFERPOOL_P_H
+
+#include <private/datavisualizationglobal_p.h>
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QSize>
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLContext;
+class QOpenGLFramebufferObject;
+
+// Hands out framebuffer objects that are larger than requested, so that graphs can keep
+// rendering into a sub-rect of the same framebuffer while they are resized. Released
+// framebuffers are kept for reuse by other graphs rendering with the same context.
+// The pool is owned by its context, and framebuffer objects cannot be shared between contexts.
+class FramebufferPool : public QObject
+{
+    Q_OBJECT
+public:
+    // Returns the pool of the current context, creating it if needed
+    static FramebufferPool *currentPool();
+
+    ~FramebufferPool();
+
+    QOpenGLFramebufferObject *acquire(const QSize &size, int samples);
+    void release(QOpenGLFramebufferObject *framebuffer);
+
+    // Whether framebuffer can be used for size without wasting too much memory
+    bool isSuitable(const QOpenGLFramebufferObject *framebuffer, const QSize &size,
+                    int samples) const;
+
+private:
+    explicit FramebufferPool(QOpenGLContext *context);
+
+    QSize allocationSize(const QSize &size) const;
+
+    QList<QOpenGLFramebufferObject *> m_freeFramebuffers; // Most recently released first
+    QHash<const QOpenGLFramebufferObject *, int> m_requestedSamples;
+    int m_maxSize;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -17,6 +17,7 @@ GLStateStore::GLStateStore(QOpenGLContext *context, QObject *parent) :
   #ifdef VERBOSE_STATE_STORE
   , m_map(EnumToStringMap::newInstance())
   #endif
+  , m_hostResetsState(false)
 {
     GLint maxVertexAttribs;
     glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxVertexAttribs);
@@ -35,7 +36,8 @@ GLStateStore::GLStateStore(QOpenGLContext *context, QObject *parent) :
     }
 #endif
 
-    m_maxVertexAttribs = qMin(maxVertexAttribs, 2); // Datavis only uses 2 attribs max
+    // Datavis binds its attributes to the first 3 locations, see ShaderHelper::AttributeLocation
+    m_maxVertexAttribs = qMin(maxVertexAttribs, 3);
     m_vertexAttribArrayEnabledStates.reset(new GLint[maxVertexAttribs]);
     m_vertexAttribArrayBoundBuffers.reset(new GLint[maxVertexAttribs]);
     m_vertexAttribArraySizes.reset(new GLint[maxVertexAttribs]);
@@ -66,6 +68,9 @@ void GLStateStore::storeGLState()
     glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_readFramebuffer);
     glGetIntegerv(GL_RENDERBUFFER_BINDING, &m_renderbuffer);
 #endif
+    if (m_hostResetsState)
+        return;
+
     glGetFloatv(GL_COLOR_CLEAR_VALUE, m_clearColor);
     m_isBlendingEnabled = glIsEnabled(GL_BLEND);
     m_isDepthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
@@ -255,8 +260,16 @@ void GLStateStore::restoreGLState()
 #if !QT_CONFIG(opengles2)
     glBindFramebuffer(GL_READ_FRAMEBUFFER, m_readFramebuffer);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_drawFramebuffer);
-    glBindRenderbuffer(GL_RENDERBUFFER_BINDING, m_renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_renderbuffer);
+#endif
+
+    if (m_hostResetsState) {
+        releaseGLState();
+#ifdef VERBOSE_STATE_STORE
+        printCurrentState(false);
 #endif
+        return;
+    }
 
     if (m_isScissorTestEnabled)
         glEnable(GL_SCISSOR_TEST);
@@ -325,6 +338,19 @@ void GLStateStore::restoreGLState()
 #endif
 }
 
+void GLStateStore::releaseGLState()
+{
+    // The host sets the state its draws need, but assumes that nothing else is bound and that
+    // no other attribute arrays are enabled
+    glUseProgram(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    for (int i = 0; i < m_maxVertexAttribs; i++)
+        glDisableVertexAttribArray(i);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void GLStateStore::initGLDefaultState()
 {
 #if !QT_CONFIG(opengles2)
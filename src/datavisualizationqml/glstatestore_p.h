@@ -25,10 +25,18 @@ public:
     explicit GLStateStore(QOpenGLContext *context, QObject *parent = 0);
     ~GLStateStore();
 
+    // Called after each beginExternalCommands(), as the scene graph may have changed any of
+    // the state since the previous call
     void storeGLState();
     void restoreGLState();
     void initGLDefaultState();
 
+    // Set when the host drops its cached GL state at endExternalCommands(), as the OpenGL
+    // backend of Qt Quick does. Only the framebuffer bindings are then stored and restored,
+    // and the rest of the state is left for the host to set again.
+    inline void setHostResetsState(bool reset) { m_hostResetsState = reset; }
+    inline bool hostResetsState() const { return m_hostResetsState; }
+
 #ifdef VERBOSE_STATE_STORE
     void printCurrentState(bool in);
     EnumToStringMap *m_map;
@@ -74,6 +82,11 @@ public:
     GLboolean m_polygonOffsetFillEnabled;
     GLfloat m_polygonOffsetFactor;
     GLfloat m_polygonOffsetUnits;
+
+private:
+    void releaseGLState();
+
+    bool m_hostResetsState;
 };
 
 #endif
@@ -0,0 +1,122 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtDataVisualization/private/adaptivequality_p.h>
+
+// Frame times in nanoseconds
+static const qint64 budget = 10000000;
+static const qint64 fastFrame = 5000000;
+static const qint64 slowFrame = 20000000;
+
+class tst_adaptivequality: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void construct();
+
+    void cameraChange();
+    void overBudget();
+    void withinBudget();
+    void restoreBackoff();
+    void reset();
+
+private:
+    AdaptiveQuality m_quality;
+};
+
+void tst_adaptivequality::init()
+{
+    m_quality = AdaptiveQuality();
+    m_quality.setFrameTimeBudget(budget);
+}
+
+void tst_adaptivequality::construct()
+{
+    AdaptiveQuality quality;
+    QCOMPARE(quality.isReduced(), false);
+    QCOMPARE(quality.frameTimeBudget(), qint64(33000000));
+    QCOMPARE(quality.restoreInterval(), int(AdaptiveQuality::minRestoreInterval));
+}
+
+void tst_adaptivequality::cameraChange()
+{
+    QCOMPARE(m_quality.update(true, true, fastFrame, false), true);
+    QCOMPARE(m_quality.isReduced(), true);
+
+    // Quality stays reduced while frames keep changing
+    QCOMPARE(m_quality.update(false, true, fastFrame, false), true);
+    QCOMPARE(m_quality.isReduced(), true);
+
+    // Idle frames keep the reduction until the restore is due
+    QCOMPARE(m_quality.update(false, false, fastFrame, false), false);
+    QCOMPARE(m_quality.isReduced(), true);
+    QCOMPARE(m_quality.update(false, false, fastFrame, true), false);
+    QCOMPARE(m_quality.isReduced(), false);
+}
+
+void tst_adaptivequality::overBudget()
+{
+    QCOMPARE(m_quality.update(false, true, slowFrame, false), true);
+    QCOMPARE(m_quality.isReduced(), true);
+
+    // A restore is ignored while frames keep changing
+    QCOMPARE(m_quality.update(false, true, fastFrame, true), true);
+    QCOMPARE(m_quality.isReduced(), true);
+}
+
+void tst_adaptivequality::withinBudget()
+{
+    QCOMPARE(m_quality.update(false, true, fastFrame, false), false);
+    QCOMPARE(m_quality.isReduced(), false);
+
+    // Slow frames without changes to render do not reduce the quality
+    QCOMPARE(m_quality.update(false, false, slowFrame, false), false);
+    QCOMPARE(m_quality.isReduced(), false);
+}
+
+void tst_adaptivequality::restoreBackoff()
+{
+    int expectedInterval = AdaptiveQuality::minRestoreInterval;
+    m_quality.update(false, true, slowFrame, false);
+    for (int i = 0; i < 6; i++) {
+        m_quality.update(false, false, fastFrame, true);
+        QCOMPARE(m_quality.isReduced(), false);
+
+        // Full quality is still over budget, so the next restore waits longer
+        QCOMPARE(m_quality.update(false, true, slowFrame, false), true);
+        QCOMPARE(m_quality.isReduced(), true);
+        expectedInterval = qMin(expectedInterval * 2, int(AdaptiveQuality::maxRestoreInterval));
+        QCOMPARE(m_quality.restoreInterval(), expectedInterval);
+    }
+    QCOMPARE(m_quality.restoreInterval(), int(AdaptiveQuality::maxRestoreInterval));
+
+    // Only the first frame after a restore counts
+    m_quality.update(false, true, slowFrame, false);
+    QCOMPARE(m_quality.restoreInterval(), int(AdaptiveQuality::maxRestoreInterval));
+
+    // Full quality within budget returns to the shortest interval
+    m_quality.update(false, false, fastFrame, true);
+    QCOMPARE(m_quality.update(false, true, fastFrame, false), false);
+    QCOMPARE(m_quality.isReduced(), false);
+    QCOMPARE(m_quality.restoreInterval(), int(AdaptiveQuality::minRestoreInterval));
+}
+
+void tst_adaptivequality::reset()
+{
+    m_quality.update(false, true, slowFrame, false);
+    m_quality.update(false, false, fastFrame, true);
+    m_quality.update(false, true, slowFrame, false);
+    QVERIFY(m_quality.restoreInterval() > int(AdaptiveQuality::minRestoreInterval));
+
+    m_quality.reset();
+    QCOMPARE(m_quality.isReduced(), false);
+    QCOMPARE(m_quality.restoreInterval(), int(AdaptiveQuality::minRestoreInterval));
+}
+
+QTEST_MAIN(tst_adaptivequality)
+#include "tst_adaptivequality.moc"
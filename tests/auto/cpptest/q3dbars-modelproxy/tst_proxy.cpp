@@ -25,6 +25,7 @@ private slots:
     void initializeProperties();
 
     void multiMatch();
+    void incrementalRowChanges();
 
 private:
     QItemModelBarDataProxy *m_proxy;
@@ -254,5 +255,43 @@ void tst_proxy::multiMatch()
     m_proxy = 0; // Proxy gets deleted as graph gets deleted
 }
 
+void tst_proxy::incrementalRowChanges()
+{
+    QTableWidget table;
+    table.setRowCount(2);
+    table.setColumnCount(2);
+    for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 2; col++)
+            table.setItem(row, col, new QTableWidgetItem(QString::number(row * 10 + col)));
+    }
+
+    m_proxy->setItemModel(table.model());
+    m_proxy->setUseModelCategories(true);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowLabels(), QStringList() << "1" << "2");
+
+    // Row changes after the initial resolve are applied without resetting the whole array
+    QSignalSpy resetSpy(m_proxy, &QBarDataProxy::arrayReset);
+
+    table.insertRow(1);
+    QCOMPARE(m_proxy->rowCount(), 3);
+    QCOMPARE(m_proxy->rowLabels(), QStringList() << "1" << "2" << "3");
+    QCOMPARE(m_proxy->itemAt(2, 1)->value(), 11.0f);
+
+    table.setItem(1, 0, new QTableWidgetItem(QStringLiteral("5")));
+    QCOMPARE(m_proxy->itemAt(1, 0)->value(), 5.0f);
+
+    table.removeRow(0);
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowLabels(), QStringList() << "1" << "2");
+    QCOMPARE(m_proxy->itemAt(0, 0)->value(), 5.0f);
+    QCOMPARE(m_proxy->itemAt(1, 1)->value(), 11.0f);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(resetSpy.size(), 0);
+}
+
 QTEST_MAIN(tst_proxy)
 #include "tst_proxy.moc"
@@ -44,6 +44,8 @@ private slots:
     void removeCustomItem();
 
     void renderToImage();
+    void threadedRendering();
+    void destroyWhileThreaded();
 
 private:
     Q3DBars *m_graph;
@@ -102,6 +104,7 @@ void tst_bars::initialProperties()
     QVERIFY(!m_graph->selectedSeries());
     QVERIFY(!m_graph->primarySeries());
     QCOMPARE(m_graph->floorLevel(), 0.0);
+    QCOMPARE(m_graph->isOcclusionCulling(), false);
     QCOMPARE(m_graph->columnAxis()->orientation(), QAbstract3DAxis::AxisOrientationX);
     QCOMPARE(m_graph->valueAxis()->orientation(), QAbstract3DAxis::AxisOrientationY);
     QCOMPARE(m_graph->rowAxis()->orientation(), QAbstract3DAxis::AxisOrientationZ);
@@ -124,6 +127,9 @@ void tst_bars::initialProperties()
     QCOMPARE(m_graph->locale(), QLocale("C"));
     QCOMPARE(m_graph->queriedGraphPosition(), QVector3D(0, 0, 0));
     QCOMPARE(m_graph->margin(), -1.0);
+    QCOMPARE(m_graph->isThreadedRendering(), false);
+    QCOMPARE(m_graph->isAdaptiveQuality(), false);
+    QCOMPARE(m_graph->frameTimeBudget(), 33.0);
 }
 
 void tst_bars::initializeProperties()
@@ -136,6 +142,7 @@ void tst_bars::initializeProperties()
     m_graph->setBarSeriesMargin(QSizeF(0.3f, 0.3f));
     m_graph->setBarSpacingRelative(false);
     m_graph->setFloorLevel(1.0f);
+    m_graph->setOcclusionCulling(true);
 
     QCOMPARE(m_graph->isMultiSeriesUniform(), true);
     QCOMPARE(m_graph->barThickness(), 0.2f);
@@ -143,6 +150,7 @@ void tst_bars::initializeProperties()
     QCOMPARE(m_graph->barSeriesMargin(), QSizeF(0.3f, 0.3f));
     QCOMPARE(m_graph->isBarSpacingRelative(), false);
     QCOMPARE(m_graph->floorLevel(), 1.0f);
+    QCOMPARE(m_graph->isOcclusionCulling(), true);
 
     Q3DTheme *theme = new Q3DTheme(Q3DTheme::ThemeDigia);
     m_graph->setActiveTheme(theme);
@@ -160,6 +168,8 @@ void tst_bars::initializeProperties()
     m_graph->setReflectivity(0.1);
     m_graph->setLocale(QLocale("FI"));
     m_graph->setMargin(1.0);
+    m_graph->setAdaptiveQuality(true);
+    m_graph->setFrameTimeBudget(16.0);
 
     QCOMPARE(m_graph->activeTheme()->type(), Q3DTheme::ThemeDigia);
     QCOMPARE(m_graph->selectionMode(), QAbstract3DGraph::SelectionItem | QAbstract3DGraph::SelectionRow | QAbstract3DGraph::SelectionSlice);
@@ -175,6 +185,8 @@ void tst_bars::initializeProperties()
     QCOMPARE(m_graph->reflectivity(), 0.1);
     QCOMPARE(m_graph->locale(), QLocale("FI"));
     QCOMPARE(m_graph->margin(), 1.0);
+    QCOMPARE(m_graph->isAdaptiveQuality(), true);
+    QCOMPARE(m_graph->frameTimeBudget(), 16.0);
 }
 
 void tst_bars::invalidProperties()
@@ -405,5 +417,67 @@ void tst_bars::renderToImage()
     */
 }
 
+void tst_bars::threadedRendering()
+{
+    m_graph->addSeries(newSeries());
+    m_graph->resize(300, 300);
+    m_graph->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_graph));
+
+    QSignalSpy spy(m_graph, &QAbstract3DGraph::threadedRenderingChanged);
+    m_graph->setThreadedRendering(true);
+    if (!m_graph->isThreadedRendering())
+        QSKIP("Threaded OpenGL not supported on this platform");
+    QCOMPARE(spy.size(), 1);
+
+    // Changes are synced to the render thread and show up in the next frame
+    m_graph->activeTheme()->setWindowColor(Qt::green);
+    QTest::qWait(100);
+    const QImage before = m_graph->renderToImage(0, QSize(300, 300));
+    QCOMPARE(before.size(), QSize(300, 300));
+    QCOMPARE(before.pixelColor(0, 0), QColor(Qt::green));
+
+    QBarDataRow *row = new QBarDataRow;
+    *row << 7.5f << -1.0f << 2.0f << 3.0f << 0.5f;
+    m_graph->seriesList().at(0)->dataProxy()->setRow(0, row);
+    QTest::qWait(100);
+    const QImage after = m_graph->renderToImage(0, QSize(300, 300));
+    QVERIFY(after != before);
+
+    // Rendering continues in the GUI thread with meshes and programs acquired again
+    m_graph->setThreadedRendering(false);
+    QCOMPARE(m_graph->isThreadedRendering(), false);
+    QCOMPARE(spy.size(), 2);
+    QCOMPARE(spy.at(1).at(0).toBool(), false);
+
+    const QImage image = m_graph->renderToImage(0, QSize(300, 300));
+    QCOMPARE(image.size(), QSize(300, 300));
+    QCOMPARE(image.pixelColor(0, 0), QColor(Qt::green));
+}
+
+void tst_bars::destroyWhileThreaded()
+{
+    m_graph->addSeries(newSeries());
+    m_graph->resize(300, 300);
+    m_graph->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_graph));
+
+    QSignalSpy spy(m_graph, &QAbstract3DGraph::threadedRenderingChanged);
+    m_graph->setThreadedRendering(true);
+    if (!m_graph->isThreadedRendering())
+        QSKIP("Threaded OpenGL not supported on this platform");
+    QCOMPARE(spy.size(), 1);
+
+    // Keep frames in flight in the render thread while the graph is destroyed
+    for (int i = 0; i < 10; i++) {
+        QBarDataRow *row = new QBarDataRow;
+        *row << 7.5f << -1.0f << 2.0f << 3.0f << 0.5f;
+        m_graph->seriesList().at(0)->dataProxy()->setRow(0, row);
+        QCoreApplication::processEvents();
+    }
+    delete m_graph;
+    m_graph = nullptr;
+}
+
 QTEST_MAIN(tst_bars)
 #include "tst_bars.moc"
@@ -0,0 +1,169 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtGui/QMatrix4x4>
+
+#include <QtDataVisualization/private/frustum_p.h>
+
+class tst_frustum: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void construct();
+
+    void orthographicBoxes();
+    void orthographicSpheres();
+    void perspectiveBoxes();
+    void perspectiveSpheres();
+    void transformBox();
+
+private:
+    static QVector3D offset(float size) { return QVector3D(size, size, size); }
+    static bool fuzzyEquals(const QVector3D &a, const QVector3D &b)
+    {
+        return (a - b).length() < 1e-5f;
+    }
+
+    // Looks down the negative z-axis from z = 5. The visible volume is [-1, 1] on the x-axis
+    // and the y-axis, and [-5, 4] on the z-axis.
+    Frustum m_orthographic;
+    // Looks down the negative z-axis from the origin with a field of view of 90 degrees. The
+    // visible volume reaches from z = -1 to z = -10, and |x| and |y| are at most -z.
+    Frustum m_perspective;
+};
+
+void tst_frustum::init()
+{
+    QMatrix4x4 projection;
+    projection.ortho(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 10.0f);
+    QMatrix4x4 view;
+    view.lookAt(QVector3D(0.0f, 0.0f, 5.0f), QVector3D(0.0f, 0.0f, 0.0f),
+                QVector3D(0.0f, 1.0f, 0.0f));
+    m_orthographic = Frustum(projection * view);
+
+    projection.setToIdentity();
+    projection.perspective(90.0f, 1.0f, 1.0f, 10.0f);
+    m_perspective = Frustum(projection);
+}
+
+void tst_frustum::construct()
+{
+    // Default constructed frustums contain everything
+    Frustum frustum;
+    QCOMPARE(frustum.containsBox(QVector3D(-1e6f, -1e6f, -1e6f), QVector3D(1e6f, 1e6f, 1e6f)),
+             Frustum::Inside);
+    QVERIFY(frustum.intersectsBox(QVector3D(1e6f, 1e6f, 1e6f), QVector3D(2e6f, 2e6f, 2e6f)));
+    QVERIFY(frustum.intersectsSphere(QVector3D(-1e6f, 0.0f, 0.0f), 1.0f));
+}
+
+void tst_frustum::orthographicBoxes()
+{
+    const QVector3D center;
+    QCOMPARE(m_orthographic.containsBox(center - offset(0.5f), center + offset(0.5f)),
+             Frustum::Inside);
+
+    // Beyond each side plane
+    QCOMPARE(m_orthographic.containsBox(QVector3D(2.0f, -0.5f, -0.5f),
+                                        QVector3D(3.0f, 0.5f, 0.5f)),
+             Frustum::Outside);
+    QCOMPARE(m_orthographic.containsBox(QVector3D(-0.5f, -3.0f, -0.5f),
+                                        QVector3D(0.5f, -2.0f, 0.5f)),
+             Frustum::Outside);
+    QVERIFY(!m_orthographic.intersectsBox(QVector3D(2.0f, -0.5f, -0.5f),
+                                          QVector3D(3.0f, 0.5f, 0.5f)));
+
+    // Beyond the far plane, and behind the near plane
+    QCOMPARE(m_orthographic.containsBox(QVector3D(-0.5f, -0.5f, -7.0f),
+                                        QVector3D(0.5f, 0.5f, -6.0f)),
+             Frustum::Outside);
+    QCOMPARE(m_orthographic.containsBox(QVector3D(-0.5f, -0.5f, 4.5f),
+                                        QVector3D(0.5f, 0.5f, 6.0f)),
+             Frustum::Outside);
+
+    // Crossing a side plane, the near plane, and all of the planes
+    QCOMPARE(m_orthographic.containsBox(QVector3D(0.5f, -0.5f, -0.5f),
+                                        QVector3D(1.5f, 0.5f, 0.5f)),
+             Frustum::Intersecting);
+    QCOMPARE(m_orthographic.containsBox(QVector3D(-0.5f, -0.5f, 3.0f),
+                                        QVector3D(0.5f, 0.5f, 5.0f)),
+             Frustum::Intersecting);
+    QCOMPARE(m_orthographic.containsBox(center - offset(20.0f), center + offset(20.0f)),
+             Frustum::Intersecting);
+    QVERIFY(m_orthographic.intersectsBox(QVector3D(0.5f, -0.5f, -0.5f),
+                                         QVector3D(1.5f, 0.5f, 0.5f)));
+}
+
+void tst_frustum::orthographicSpheres()
+{
+    // Planes are normalized, so that distances are in scene units
+    QVERIFY(m_orthographic.intersectsSphere(QVector3D(0.0f, 0.0f, 0.0f), 0.5f));
+    QVERIFY(m_orthographic.intersectsSphere(QVector3D(1.3f, 0.0f, 0.0f), 0.5f));
+    QVERIFY(!m_orthographic.intersectsSphere(QVector3D(1.7f, 0.0f, 0.0f), 0.5f));
+    QVERIFY(m_orthographic.intersectsSphere(QVector3D(0.0f, 0.0f, 4.4f), 0.5f));
+    QVERIFY(!m_orthographic.intersectsSphere(QVector3D(0.0f, 0.0f, 4.6f), 0.5f));
+    QVERIFY(!m_orthographic.intersectsSphere(QVector3D(0.0f, 0.0f, -5.6f), 0.5f));
+}
+
+void tst_frustum::perspectiveBoxes()
+{
+    const QVector3D center(0.0f, 0.0f, -5.0f);
+    QCOMPARE(m_perspective.containsBox(center - offset(0.5f), center + offset(0.5f)),
+             Frustum::Inside);
+
+    // Outside the right plane at that depth, and behind the camera
+    const QVector3D right(7.0f, 0.0f, -5.0f);
+    QCOMPARE(m_perspective.containsBox(right - offset(0.5f), right + offset(0.5f)),
+             Frustum::Outside);
+    const QVector3D behind(0.0f, 0.0f, 1.0f);
+    QCOMPARE(m_perspective.containsBox(behind - offset(0.5f), behind + offset(0.5f)),
+             Frustum::Outside);
+
+    // Crossing the right plane, and the far plane
+    const QVector3D edge(5.0f, 0.0f, -5.0f);
+    QCOMPARE(m_perspective.containsBox(edge - offset(0.5f), edge + offset(0.5f)),
+             Frustum::Intersecting);
+    const QVector3D distant(0.0f, 0.0f, -10.0f);
+    QCOMPARE(m_perspective.containsBox(distant - offset(0.5f), distant + offset(0.5f)),
+             Frustum::Intersecting);
+}
+
+void tst_frustum::perspectiveSpheres()
+{
+    QVERIFY(m_perspective.intersectsSphere(QVector3D(0.0f, 0.0f, -5.0f), 1.0f));
+    // Distance to the right plane is the offset from it divided by the square root of two
+    QVERIFY(m_perspective.intersectsSphere(QVector3D(5.5f, 0.0f, -5.0f), 1.0f));
+    QVERIFY(!m_perspective.intersectsSphere(QVector3D(8.0f, 0.0f, -5.0f), 1.0f));
+    QVERIFY(!m_perspective.intersectsSphere(QVector3D(0.0f, 0.0f, 0.5f), 1.0f));
+}
+
+void tst_frustum::transformBox()
+{
+    QMatrix4x4 matrix;
+    matrix.translate(1.0f, 0.0f, 0.0f);
+    matrix.rotate(90.0f, 0.0f, 0.0f, 1.0f);
+
+    QVector3D minimum(0.0f, 0.0f, 0.0f);
+    QVector3D maximum(2.0f, 1.0f, 1.0f);
+    Frustum::transformBox(matrix, minimum, maximum);
+
+    QVERIFY(fuzzyEquals(minimum, QVector3D(0.0f, 0.0f, 0.0f)));
+    QVERIFY(fuzzyEquals(maximum, QVector3D(1.0f, 2.0f, 1.0f)));
+
+    // The bounds of a rotated box grow to contain all of its corners
+    minimum = QVector3D(-1.0f, -1.0f, -1.0f);
+    maximum = QVector3D(1.0f, 1.0f, 1.0f);
+    matrix.setToIdentity();
+    matrix.rotate(45.0f, 0.0f, 1.0f, 0.0f);
+    Frustum::transformBox(matrix, minimum, maximum);
+
+    const float diagonal = std::sqrt(2.0f);
+    QVERIFY(fuzzyEquals(minimum, QVector3D(-diagonal, -1.0f, -diagonal)));
+    QVERIFY(fuzzyEquals(maximum, QVector3D(diagonal, 1.0f, diagonal)));
+}
+
+QTEST_MAIN(tst_frustum)
+#include "tst_frustum.moc"
@@ -6,6 +6,7 @@
 #include <QtDataVisualization/QItemModelScatterDataProxy>
 #include <QtDataVisualization/Q3DScatter>
 #include <QtWidgets/QTableWidget>
+#include <QtGui/QStandardItemModel>
 
 class tst_proxy: public QObject
 {
@@ -23,6 +24,7 @@ private slots:
     void initializeProperties();
 
     void addModel();
+    void incrementalRowChanges();
 
 private:
     QItemModelScatterDataProxy *m_proxy;
@@ -176,5 +178,73 @@ void tst_proxy::addModel()
     m_proxy = 0; // proxy gets deleted with series
 }
 
+static QStandardItem *newItem(int x, int y, int z)
+{
+    return new QStandardItem(QStringLiteral("%1/%2/%3").arg(x).arg(y).arg(z));
+}
+
+void tst_proxy::incrementalRowChanges()
+{
+    // Each cell of the two column model is an item, with "x/y/z" as its position
+    QStandardItemModel model(2, 2);
+    for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 2; col++)
+            model.setItem(row, col, newItem(col, row * 10 + col, row));
+    }
+
+    const QString displayRole = QString::fromLatin1(model.roleNames().value(Qt::DisplayRole));
+    const QRegularExpression pattern(QStringLiteral("^(\\d+)\\/(\\d+)\\/(\\d+)$"));
+    m_proxy->setItemModel(&model);
+    m_proxy->setXPosRole(displayRole);
+    m_proxy->setYPosRole(displayRole);
+    m_proxy->setZPosRole(displayRole);
+    m_proxy->setXPosRolePattern(pattern);
+    m_proxy->setYPosRolePattern(pattern);
+    m_proxy->setZPosRolePattern(pattern);
+    m_proxy->setXPosRoleReplace(QStringLiteral("\\1"));
+    m_proxy->setYPosRoleReplace(QStringLiteral("\\2"));
+    m_proxy->setZPosRoleReplace(QStringLiteral("\\3"));
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->itemCount(), 4);
+    QCOMPARE(m_proxy->itemAt(3)->position(), QVector3D(1.0f, 11.0f, 1.0f));
+
+    // Row changes after the initial resolve are applied without resetting the whole array
+    QSignalSpy resetSpy(m_proxy, &QScatterDataProxy::arrayReset);
+
+    model.insertRow(1, QList<QStandardItem *>() << newItem(0, 50, 5) << newItem(1, 51, 5));
+    QCOMPARE(m_proxy->itemCount(), 6);
+    QCOMPARE(m_proxy->itemAt(2)->position(), QVector3D(0.0f, 50.0f, 5.0f));
+    QCOMPARE(m_proxy->itemAt(3)->position(), QVector3D(1.0f, 51.0f, 5.0f));
+    QCOMPARE(m_proxy->itemAt(5)->position(), QVector3D(1.0f, 11.0f, 1.0f));
+
+    model.item(2, 0)->setText(QStringLiteral("0/70/1"));
+    QCOMPARE(m_proxy->itemAt(4)->position(), QVector3D(0.0f, 70.0f, 1.0f));
+
+    // Child rows are not part of the data
+    model.item(0, 0)->appendRow(newItem(9, 99, 9));
+    model.item(0, 0)->child(0)->setText(QStringLiteral("8/88/8"));
+    model.item(0, 0)->removeRow(0);
+    QCOMPARE(m_proxy->itemCount(), 6);
+    QCOMPARE(m_proxy->itemAt(0)->position(), QVector3D(0.0f, 0.0f, 0.0f));
+
+    model.removeRow(0);
+    QCOMPARE(m_proxy->itemCount(), 4);
+    QCOMPARE(m_proxy->itemAt(0)->position(), QVector3D(0.0f, 50.0f, 5.0f));
+    QCOMPARE(m_proxy->itemAt(2)->position(), QVector3D(0.0f, 70.0f, 1.0f));
+
+    QCoreApplication::processEvents();
+    QCOMPARE(resetSpy.size(), 0);
+
+    // Changes made while a mapping change is pending are resolved with the new mapping
+    m_proxy->setYPosRoleReplace(QStringLiteral("\\3"));
+    model.removeRow(0);
+    QCOMPARE(m_proxy->itemCount(), 4);
+    QCoreApplication::processEvents();
+    QCOMPARE(resetSpy.size(), 1);
+    QCOMPARE(m_proxy->itemCount(), 2);
+    QCOMPARE(m_proxy->itemAt(1)->position(), QVector3D(1.0f, 1.0f, 1.0f));
+}
+
 QTEST_MAIN(tst_proxy)
 #include "tst_proxy.moc"
@@ -4,6 +4,7 @@
 #include <QtTest/QtTest>
 
 #include <QtDataVisualization/QScatterDataProxy>
+#include <QtDataVisualization/QScatter3DSeries>
 
 class tst_proxy: public QObject
 {
@@ -20,6 +21,10 @@ private slots:
     void initialProperties();
     void initializeProperties();
 
+    void capacity();
+    void capacityLimitsAllChanges();
+    void capacitySelection();
+
 private:
     QScatterDataProxy *m_proxy;
 };
@@ -70,5 +75,119 @@ void tst_proxy::initializeProperties()
     QCOMPARE(m_proxy->itemCount(), 2);
 }
 
+void tst_proxy::capacity()
+{
+    QCOMPARE(m_proxy->capacity(), 0);
+
+    QSignalSpy addSpy(m_proxy, &QScatterDataProxy::itemsAdded);
+    QSignalSpy changeSpy(m_proxy, &QScatterDataProxy::itemsChanged);
+    QSignalSpy resetSpy(m_proxy, &QScatterDataProxy::arrayReset);
+
+    m_proxy->setCapacity(4);
+    QCOMPARE(m_proxy->capacity(), 4);
+
+    QScatterDataArray data;
+    data << QVector3D(0.0f, 0.0f, 0.0f) << QVector3D(1.0f, 1.0f, 1.0f)
+         << QVector3D(2.0f, 2.0f, 2.0f);
+    QCOMPARE(m_proxy->addItems(data), 0);
+    QCOMPARE(m_proxy->itemCount(), 3);
+
+    // Fills the array and overwrites the oldest item
+    data.clear();
+    data << QVector3D(3.0f, 3.0f, 3.0f) << QVector3D(4.0f, 4.0f, 4.0f);
+    QCOMPARE(m_proxy->addItems(data), 3);
+    QCOMPARE(m_proxy->itemCount(), 4);
+    QCOMPARE(addSpy.size(), 2);
+    QCOMPARE(addSpy.last().at(0).toInt(), 3);
+    QCOMPARE(addSpy.last().at(1).toInt(), 1);
+    QCOMPARE(changeSpy.size(), 1);
+    QCOMPARE(changeSpy.last().at(0).toInt(), 0);
+    QCOMPARE(changeSpy.last().at(1).toInt(), 1);
+    QCOMPARE(m_proxy->itemAt(0)->x(), 4.0f);
+
+    // Wraps around the end of the array
+    data.clear();
+    data << QVector3D(5.0f, 5.0f, 5.0f) << QVector3D(6.0f, 6.0f, 6.0f)
+         << QVector3D(7.0f, 7.0f, 7.0f) << QVector3D(8.0f, 8.0f, 8.0f);
+    QCOMPARE(m_proxy->addItems(data), 1);
+    QCOMPARE(m_proxy->itemCount(), 4);
+    QCOMPARE(addSpy.size(), 2);
+    QCOMPARE(changeSpy.size(), 3);
+    QCOMPARE(changeSpy.last().at(0).toInt(), 0);
+    QCOMPARE(changeSpy.last().at(1).toInt(), 1);
+    QCOMPARE(m_proxy->itemAt(0)->x(), 8.0f);
+    QCOMPARE(m_proxy->itemAt(1)->x(), 5.0f);
+
+    // Reducing the capacity keeps the newest items in chronological order
+    m_proxy->setCapacity(2);
+    QCOMPARE(resetSpy.size(), 1);
+    QCOMPARE(m_proxy->itemCount(), 2);
+    QCOMPARE(m_proxy->itemAt(0)->x(), 7.0f);
+    QCOMPARE(m_proxy->itemAt(1)->x(), 8.0f);
+
+    m_proxy->setCapacity(0);
+    QCOMPARE(m_proxy->addItem(QVector3D(9.0f, 9.0f, 9.0f)), 2);
+    QCOMPARE(m_proxy->itemCount(), 3);
+}
+
+void tst_proxy::capacityLimitsAllChanges()
+{
+    m_proxy->setCapacity(3);
+
+    // Items that do not fit are removed from the start of the array
+    QScatterDataArray *array = new QScatterDataArray;
+    for (int i = 0; i < 5; i++)
+        *array << QVector3D(float(i), 0.0f, 0.0f);
+    m_proxy->resetArray(array);
+    QCOMPARE(m_proxy->itemCount(), 3);
+    QCOMPARE(m_proxy->itemAt(0)->x(), 2.0f);
+
+    QSignalSpy removeSpy(m_proxy, &QScatterDataProxy::itemsRemoved);
+
+    m_proxy->insertItem(1, QVector3D(9.0f, 0.0f, 0.0f));
+    QCOMPARE(m_proxy->itemCount(), 3);
+    QCOMPARE(removeSpy.size(), 1);
+    QCOMPARE(removeSpy.last().at(0).toInt(), 0);
+    QCOMPARE(removeSpy.last().at(1).toInt(), 1);
+    QCOMPARE(m_proxy->itemAt(0)->x(), 9.0f);
+    QCOMPARE(m_proxy->itemAt(2)->x(), 4.0f);
+
+    QScatterDataArray data;
+    data << QVector3D(10.0f, 0.0f, 0.0f) << QVector3D(11.0f, 0.0f, 0.0f);
+    m_proxy->insertItems(3, data);
+    QCOMPARE(m_proxy->itemCount(), 3);
+    QCOMPARE(removeSpy.size(), 2);
+    QCOMPARE(removeSpy.last().at(1).toInt(), 2);
+    QCOMPARE(m_proxy->itemAt(0)->x(), 4.0f);
+    QCOMPARE(m_proxy->itemAt(2)->x(), 11.0f);
+}
+
+void tst_proxy::capacitySelection()
+{
+    QScatter3DSeries series;
+    QScatterDataProxy *proxy = series.dataProxy();
+    proxy->setCapacity(3);
+
+    QScatterDataArray data;
+    data << QVector3D(0.0f, 0.0f, 0.0f) << QVector3D(1.0f, 1.0f, 1.0f)
+         << QVector3D(2.0f, 2.0f, 2.0f);
+    proxy->addItems(data);
+    series.setSelectedItem(1);
+
+    // Overwriting other items keeps the selection
+    proxy->addItem(QVector3D(3.0f, 3.0f, 3.0f));
+    QCOMPARE(series.selectedItem(), 1);
+
+    // Overwriting the selected item clears the selection
+    proxy->addItem(QVector3D(4.0f, 4.0f, 4.0f));
+    QCOMPARE(series.selectedItem(), QScatter3DSeries::invalidSelectionIndex());
+
+    // Restoring the chronological order moves the selection with its item
+    series.setSelectedItem(0);
+    proxy->setCapacity(2);
+    QCOMPARE(proxy->itemAt(0)->x(), 3.0f);
+    QCOMPARE(series.selectedItem(), 0);
+}
+
 QTEST_MAIN(tst_proxy)
 #include "tst_proxy.moc"
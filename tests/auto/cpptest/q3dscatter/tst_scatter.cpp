@@ -30,6 +30,9 @@ private slots:
     void removeMultipleSeries();
     void hasSeries();
 
+    void threadedRendering();
+    void destroyWhileThreaded();
+
 private:
     Q3DScatter *m_graph;
 };
@@ -102,6 +105,9 @@ void tst_scatter::initialProperties()
     QCOMPARE(m_graph->locale(), QLocale("C"));
     QCOMPARE(m_graph->queriedGraphPosition(), QVector3D(0, 0, 0));
     QCOMPARE(m_graph->margin(), -1.0);
+    QCOMPARE(m_graph->isThreadedRendering(), false);
+    QCOMPARE(m_graph->isAdaptiveQuality(), false);
+    QCOMPARE(m_graph->frameTimeBudget(), 33.0);
 }
 
 void tst_scatter::initializeProperties()
@@ -122,6 +128,8 @@ void tst_scatter::initializeProperties()
     m_graph->setReflectivity(0.1);
     m_graph->setLocale(QLocale("FI"));
     m_graph->setMargin(1.0);
+    m_graph->setAdaptiveQuality(true);
+    m_graph->setFrameTimeBudget(16.0);
 
     QCOMPARE(m_graph->activeTheme()->type(), Q3DTheme::ThemeDigia);
     QCOMPARE(m_graph->selectionMode(), QAbstract3DGraph::SelectionNone);
@@ -137,6 +145,8 @@ void tst_scatter::initializeProperties()
     QCOMPARE(m_graph->reflectivity(), 0.1);
     QCOMPARE(m_graph->locale(), QLocale("FI"));
     QCOMPARE(m_graph->margin(), 1.0);
+    QCOMPARE(m_graph->isAdaptiveQuality(), true);
+    QCOMPARE(m_graph->frameTimeBudget(), 16.0);
 }
 
 void tst_scatter::invalidProperties()
@@ -237,5 +247,65 @@ void tst_scatter::hasSeries()
     QCOMPARE(m_graph->hasSeries(series2), false);
 }
 
+void tst_scatter::threadedRendering()
+{
+    m_graph->addSeries(newSeries());
+    m_graph->resize(300, 300);
+    m_graph->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_graph));
+
+    QSignalSpy spy(m_graph, &QAbstract3DGraph::threadedRenderingChanged);
+    m_graph->setThreadedRendering(true);
+    if (!m_graph->isThreadedRendering())
+        QSKIP("Threaded OpenGL not supported on this platform");
+    QCOMPARE(spy.size(), 1);
+
+    // Changes are synced to the render thread and show up in the next frame
+    m_graph->activeTheme()->setWindowColor(Qt::green);
+    QTest::qWait(100);
+    const QImage before = m_graph->renderToImage(0, QSize(300, 300));
+    QCOMPARE(before.size(), QSize(300, 300));
+    QCOMPARE(before.pixelColor(0, 0), QColor(Qt::green));
+
+    m_graph->seriesList().at(0)->dataProxy()->setItem(
+                0, QScatterDataItem(QVector3D(-0.5f, 0.8f, -0.5f)));
+    QTest::qWait(100);
+    const QImage after = m_graph->renderToImage(0, QSize(300, 300));
+    QVERIFY(after != before);
+
+    // Rendering continues in the GUI thread with meshes and programs acquired again
+    m_graph->setThreadedRendering(false);
+    QCOMPARE(m_graph->isThreadedRendering(), false);
+    QCOMPARE(spy.size(), 2);
+    QCOMPARE(spy.at(1).at(0).toBool(), false);
+
+    const QImage image = m_graph->renderToImage(0, QSize(300, 300));
+    QCOMPARE(image.size(), QSize(300, 300));
+    QCOMPARE(image.pixelColor(0, 0), QColor(Qt::green));
+}
+
+void tst_scatter::destroyWhileThreaded()
+{
+    m_graph->addSeries(newSeries());
+    m_graph->resize(300, 300);
+    m_graph->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_graph));
+
+    QSignalSpy spy(m_graph, &QAbstract3DGraph::threadedRenderingChanged);
+    m_graph->setThreadedRendering(true);
+    if (!m_graph->isThreadedRendering())
+        QSKIP("Threaded OpenGL not supported on this platform");
+    QCOMPARE(spy.size(), 1);
+
+    // Keep frames in flight in the render thread while the graph is destroyed
+    for (int i = 0; i < 10; i++) {
+        m_graph->seriesList().at(0)->dataProxy()->setItem(
+                    0, QScatterDataItem(QVector3D(-0.5f, 0.8f, -0.5f)));
+        QCoreApplication::processEvents();
+    }
+    delete m_graph;
+    m_graph = nullptr;
+}
+
 QTEST_MAIN(tst_scatter)
 #include "tst_scatter.moc"
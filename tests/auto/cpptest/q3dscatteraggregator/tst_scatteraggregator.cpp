@@ -0,0 +1,228 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtGui/QVector3D>
+
+#include <QtDataVisualization/private/scatteraggregator_p.h>
+#include <QtDataVisualization/private/scatterrenderitem_p.h>
+
+// Two cells per axis, each cell one unit wide
+static const int resolution = 2;
+static const QVector3D extent(1.0f, 1.0f, 1.0f);
+
+class tst_scatteraggregator: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void construct();
+
+    void build();
+    void cellBounds();
+    void moveItem();
+    void moveHead();
+    void visibility();
+    void clear();
+
+private:
+    QList<int> cellItems(int head) const;
+    quint64 cellOf(int item) const;
+
+    ScatterRenderItemArray m_items;
+    ScatterAggregator m_aggregator;
+};
+
+void tst_scatteraggregator::init()
+{
+    // Items 0, 2 and 4 are in the lowest cell, items 1, 3 and 6 in the highest one. Item 6 is
+    // outside the binned volume, so it goes to the nearest cell. Item 5 is hidden.
+    const QList<QVector3D> translations = {
+        QVector3D(-0.5f, -0.5f, -0.5f),
+        QVector3D(0.5f, 0.5f, 0.5f),
+        QVector3D(-0.25f, -0.75f, -0.5f),
+        QVector3D(0.75f, 0.25f, 0.9f),
+        QVector3D(-0.9f, -0.1f, -0.1f),
+        QVector3D(0.5f, -0.5f, 0.5f),
+        QVector3D(2.0f, 2.0f, 2.0f)
+    };
+
+    m_items.clear();
+    m_items.resize(int(translations.size()));
+    for (int i = 0; i < translations.size(); i++) {
+        m_items.setTranslation(i, translations.at(i));
+        m_items.setVisible(i, i != 5);
+    }
+
+    m_aggregator = ScatterAggregator();
+    m_aggregator.build(m_items, resolution, extent);
+}
+
+void tst_scatteraggregator::construct()
+{
+    ScatterAggregator aggregator;
+    QCOMPARE(aggregator.resolution(), 0);
+    QVERIFY(!aggregator.isActive());
+    QCOMPARE(aggregator.binnedItemCount(), 0);
+    QVERIFY(aggregator.cells().isEmpty());
+    QVERIFY(aggregator.representatives().isEmpty());
+}
+
+void tst_scatteraggregator::build()
+{
+    QCOMPARE(m_aggregator.resolution(), resolution);
+    QVERIFY(m_aggregator.isActive());
+    QCOMPARE(m_aggregator.extent(), extent);
+    QCOMPARE(m_aggregator.binnedItemCount(), 6);
+    QCOMPARE(m_aggregator.cells().size(), 2);
+
+    // The first item of each cell represents it, later items are linked after the head
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1}));
+    QCOMPARE(cellItems(0), QList<int>({0, 4, 2}));
+    QCOMPARE(cellItems(1), QList<int>({1, 6, 3}));
+    QCOMPARE(m_aggregator.nextItem(5), -1);
+}
+
+void tst_scatteraggregator::cellBounds()
+{
+    QVector3D minimum;
+    QVector3D maximum;
+
+    m_aggregator.cellBounds(cellOf(0), minimum, maximum);
+    QCOMPARE(minimum, QVector3D(-1.0f, -1.0f, -1.0f));
+    QCOMPARE(maximum, QVector3D(0.0f, 0.0f, 0.0f));
+
+    m_aggregator.cellBounds(cellOf(1), minimum, maximum);
+    QCOMPARE(minimum, QVector3D(0.0f, 0.0f, 0.0f));
+    QCOMPARE(maximum, QVector3D(1.0f, 1.0f, 1.0f));
+
+    // Every binned item is within the bounds of its cell, apart from the clamped item
+    for (int i = 0; i < m_items.size(); i++) {
+        if (i == 5 || i == 6)
+            continue;
+        const QVector3D &translation = m_items.translation(i);
+        m_aggregator.cellBounds(cellOf(i), minimum, maximum);
+        for (int axis = 0; axis < 3; axis++) {
+            QVERIFY(translation[axis] >= minimum[axis]);
+            QVERIFY(translation[axis] <= maximum[axis]);
+        }
+    }
+}
+
+void tst_scatteraggregator::moveItem()
+{
+    // Moving within the cell keeps the links
+    m_items.setTranslation(2, QVector3D(-0.1f, -0.1f, -0.1f));
+    m_aggregator.updateItem(m_items, 2);
+    QCOMPARE(cellItems(0), QList<int>({0, 4, 2}));
+
+    // Moving to a new cell makes the item its representative
+    m_items.setTranslation(2, QVector3D(0.5f, -0.5f, -0.5f));
+    m_aggregator.updateItem(m_items, 2);
+    QCOMPARE(m_aggregator.binnedItemCount(), 6);
+    QCOMPARE(m_aggregator.cells().size(), 3);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1, 2}));
+    QCOMPARE(cellItems(0), QList<int>({0, 4}));
+    QCOMPARE(cellItems(2), QList<int>({2}));
+
+    // Moving to an occupied cell keeps its representative
+    m_items.setTranslation(4, QVector3D(0.9f, 0.9f, 0.9f));
+    m_aggregator.updateItem(m_items, 4);
+    QCOMPARE(m_aggregator.cells().size(), 3);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1, 2}));
+    QCOMPARE(cellItems(0), QList<int>({0}));
+    QCOMPARE(cellItems(1), QList<int>({1, 4, 6, 3}));
+}
+
+void tst_scatteraggregator::moveHead()
+{
+    // The next item in the cell becomes the representative
+    m_items.setTranslation(0, QVector3D(0.5f, -0.5f, -0.5f));
+    m_aggregator.updateItem(m_items, 0);
+    QCOMPARE(m_aggregator.binnedItemCount(), 6);
+    QCOMPARE(m_aggregator.cells().size(), 3);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1, 4}));
+    QCOMPARE(cellItems(4), QList<int>({4, 2}));
+    QCOMPARE(cellItems(0), QList<int>({0}));
+
+    // Emptying a cell removes it
+    m_items.setTranslation(4, QVector3D(0.5f, 0.5f, 0.5f));
+    m_aggregator.updateItem(m_items, 4);
+    m_items.setTranslation(2, QVector3D(0.5f, 0.5f, 0.5f));
+    m_aggregator.updateItem(m_items, 2);
+    QCOMPARE(m_aggregator.cells().size(), 2);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1}));
+    QCOMPARE(cellItems(1), QList<int>({1, 2, 4, 6, 3}));
+}
+
+void tst_scatteraggregator::visibility()
+{
+    // Showing an item bins it
+    m_aggregator.updateItem(m_items, 5);
+    QCOMPARE(m_aggregator.binnedItemCount(), 6);
+    m_items.setVisible(5, true);
+    m_aggregator.updateItem(m_items, 5);
+    QCOMPARE(m_aggregator.binnedItemCount(), 7);
+    QCOMPARE(m_aggregator.cells().size(), 3);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1, 5}));
+
+    // Hiding a representative promotes the next item of the cell
+    m_items.setVisible(1, false);
+    m_aggregator.updateItem(m_items, 1);
+    QCOMPARE(m_aggregator.binnedItemCount(), 6);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 5, 6}));
+    QCOMPARE(cellItems(6), QList<int>({6, 3}));
+    QCOMPARE(m_aggregator.nextItem(1), -1);
+
+    // Hiding the only item of a cell removes the cell
+    m_items.setVisible(5, false);
+    m_aggregator.updateItem(m_items, 5);
+    QCOMPARE(m_aggregator.binnedItemCount(), 5);
+    QCOMPARE(m_aggregator.cells().size(), 2);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 6}));
+}
+
+void tst_scatteraggregator::clear()
+{
+    m_aggregator.clear();
+    QCOMPARE(m_aggregator.resolution(), 0);
+    QVERIFY(!m_aggregator.isActive());
+    QCOMPARE(m_aggregator.binnedItemCount(), 0);
+    QVERIFY(m_aggregator.cells().isEmpty());
+    QVERIFY(m_aggregator.representatives().isEmpty());
+
+    // Updates are ignored until the items are binned again
+    m_aggregator.updateItem(m_items, 0);
+    QVERIFY(m_aggregator.cells().isEmpty());
+
+    m_aggregator.build(m_items, resolution, extent);
+    QCOMPARE(m_aggregator.binnedItemCount(), 6);
+    QCOMPARE(m_aggregator.representatives(), QList<int>({0, 1}));
+}
+
+// Items of the cell, starting from its representative
+QList<int> tst_scatteraggregator::cellItems(int head) const
+{
+    QList<int> items;
+    if (m_aggregator.cells().value(cellOf(head), -1) != head)
+        return items;
+    for (int i = head; i >= 0; i = m_aggregator.nextItem(i))
+        items.append(i);
+    return items;
+}
+
+quint64 tst_scatteraggregator::cellOf(int item) const
+{
+    for (auto it = m_aggregator.cells().cbegin(); it != m_aggregator.cells().cend(); ++it) {
+        for (int i = it.value(); i >= 0; i = m_aggregator.nextItem(i)) {
+            if (i == item)
+                return it.key();
+        }
+    }
+    return ~quint64(0);
+}
+
+QTEST_MAIN(tst_scatteraggregator)
+#include "tst_scatteraggregator.moc"
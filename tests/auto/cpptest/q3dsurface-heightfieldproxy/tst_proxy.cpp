@@ -0,0 +1,243 @@
+// Copyright (C) 2016 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtDataVisualization/QHeightFieldSurfaceDataProxy>
+
+class tst_proxy: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void construct();
+
+    void initialProperties();
+    void headerFile();
+    void sidecarFile();
+    void windowAndStep();
+    void invalidProperties();
+    void resetDuringResolve();
+
+private:
+    QString writeHeaderFile(int width, int height);
+
+    QHeightFieldSurfaceDataProxy *m_proxy;
+    QTemporaryDir m_dir;
+};
+
+void tst_proxy::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_proxy::cleanupTestCase()
+{
+}
+
+void tst_proxy::init()
+{
+    m_proxy = new QHeightFieldSurfaceDataProxy();
+}
+
+void tst_proxy::cleanup()
+{
+    delete m_proxy;
+}
+
+QString tst_proxy::writeHeaderFile(int width, int height)
+{
+    // Samples are row * 100 + column, the first row in the file being the top row
+    QString filename = m_dir.filePath(QStringLiteral("field_%1x%2.raw").arg(width).arg(height));
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return QString();
+
+    QByteArray header(40, 0);
+    uchar *data = reinterpret_cast<uchar *>(header.data());
+    memcpy(data, "QDVH", 4);
+    qToLittleEndian<quint32>(width, data + 4);
+    qToLittleEndian<quint32>(height, data + 8);
+    qToLittleEndian<quint32>(0, data + 12);
+    qToLittleEndian<float>(0.0f, data + 16);
+    qToLittleEndian<float>(float(width - 1), data + 20);
+    qToLittleEndian<float>(0.0f, data + 24);
+    qToLittleEndian<float>(float(height - 1), data + 28);
+    qToLittleEndian<float>(1.0f, data + 32);
+    qToLittleEndian<float>(0.0f, data + 36);
+    file.write(header);
+
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            uchar sample[2];
+            qToLittleEndian<qint16>(qint16(i * 100 + j), sample);
+            file.write(reinterpret_cast<char *>(sample), 2);
+        }
+    }
+    return filename;
+}
+
+void tst_proxy::construct()
+{
+    QHeightFieldSurfaceDataProxy *proxy = new QHeightFieldSurfaceDataProxy();
+    QVERIFY(proxy);
+    delete proxy;
+
+    proxy = new QHeightFieldSurfaceDataProxy(writeHeaderFile(8, 6));
+    QVERIFY(proxy);
+    QCoreApplication::processEvents();
+    QCOMPARE(proxy->columnCount(), 8);
+    QCOMPARE(proxy->rowCount(), 6);
+    delete proxy;
+}
+
+void tst_proxy::initialProperties()
+{
+    QVERIFY(m_proxy);
+
+    QCOMPARE(m_proxy->heightFieldFile(), QString());
+    QCOMPARE(m_proxy->fieldSize(), QSize());
+    QCOMPARE(m_proxy->window(), QRect());
+    QCOMPARE(m_proxy->sampleStep(), 1);
+
+    QCOMPARE(m_proxy->columnCount(), 0);
+    QCOMPARE(m_proxy->rowCount(), 0);
+    QVERIFY(!m_proxy->series());
+
+    QCOMPARE(m_proxy->type(), QAbstractDataProxy::DataTypeSurface);
+}
+
+void tst_proxy::headerFile()
+{
+    QString filename = writeHeaderFile(8, 6);
+    m_proxy->setHeightFieldFile(filename);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->heightFieldFile(), filename);
+    QCOMPARE(m_proxy->fieldSize(), QSize(8, 6));
+    QCOMPARE(m_proxy->columnCount(), 8);
+    QCOMPARE(m_proxy->rowCount(), 6);
+
+    // First data row is the last row in the file
+    QCOMPARE(m_proxy->itemAt(0, 0)->position(), QVector3D(0.0f, 500.0f, 0.0f));
+    QCOMPARE(m_proxy->itemAt(5, 7)->position(), QVector3D(7.0f, 7.0f, 5.0f));
+    QCOMPARE(m_proxy->itemAt(2, 3)->y(), 303.0f);
+
+    m_proxy->setHeightFieldFile(QString());
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->fieldSize(), QSize());
+    QCOMPARE(m_proxy->columnCount(), 0);
+    QCOMPARE(m_proxy->rowCount(), 0);
+}
+
+void tst_proxy::sidecarFile()
+{
+    QString filename = m_dir.filePath(QStringLiteral("sidecar.raw"));
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    for (int i = 0; i < 4 * 3; i++) {
+        uchar sample[4];
+        qToLittleEndian<float>(float(i) * 0.5f, sample);
+        file.write(reinterpret_cast<char *>(sample), 4);
+    }
+    file.close();
+
+    QFile sidecar(filename + QStringLiteral(".json"));
+    QVERIFY(sidecar.open(QIODevice::WriteOnly));
+    sidecar.write("{ \"width\": 4, \"height\": 3, \"sampleType\": \"float32\","
+                  " \"minX\": -1, \"maxX\": 2, \"minZ\": 10, \"maxZ\": 12,"
+                  " \"heightScale\": 2, \"heightOffset\": 1 }");
+    sidecar.close();
+
+    m_proxy->setHeightFieldFile(filename);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->fieldSize(), QSize(4, 3));
+    QCOMPARE(m_proxy->columnCount(), 4);
+    QCOMPARE(m_proxy->rowCount(), 3);
+    QCOMPARE(m_proxy->itemAt(0, 0)->position(), QVector3D(-1.0f, 9.0f, 10.0f));
+    QCOMPARE(m_proxy->itemAt(2, 3)->position(), QVector3D(2.0f, 4.0f, 12.0f));
+}
+
+void tst_proxy::windowAndStep()
+{
+    m_proxy->setHeightFieldFile(writeHeaderFile(8, 6));
+    m_proxy->setWindow(QRect(2, 1, 5, 4));
+    m_proxy->setSampleStep(2);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->window(), QRect(2, 1, 5, 4));
+    QCOMPARE(m_proxy->sampleStep(), 2);
+    QCOMPARE(m_proxy->columnCount(), 3);
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->itemAt(0, 0)->position(), QVector3D(2.0f, 302.0f, 2.0f));
+    QCOMPARE(m_proxy->itemAt(1, 2)->position(), QVector3D(6.0f, 106.0f, 4.0f));
+
+    // Window is clipped to the field
+    m_proxy->setWindow(QRect(6, 4, 10, 10));
+    m_proxy->setSampleStep(1);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->columnCount(), 2);
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->itemAt(0, 0)->y(), 506.0f);
+}
+
+void tst_proxy::invalidProperties()
+{
+    QTest::ignoreMessage(QtWarningMsg,
+                         "Warning: Tried to set invalid sample step: 0 Sample step must be at least 1.");
+    m_proxy->setSampleStep(0);
+    QCOMPARE(m_proxy->sampleStep(), 1);
+
+    QString filename = m_dir.filePath(QStringLiteral("noheader.raw"));
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(64, 0));
+    file.close();
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("has neither a header"));
+    m_proxy->setHeightFieldFile(filename);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->fieldSize(), QSize());
+    QCOMPARE(m_proxy->rowCount(), 0);
+}
+
+void tst_proxy::resetDuringResolve()
+{
+    // Fields this large are resolved in the background
+    const QString largeFile = writeHeaderFile(1200, 1000);
+    const QString smallFile = writeHeaderFile(8, 6);
+
+    // Start a resolve and replace the file while the background threads read it
+    m_proxy->setHeightFieldFile(largeFile);
+    QCoreApplication::processEvents();
+    m_proxy->setHeightFieldFile(smallFile);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->columnCount(), 8);
+    QCOMPARE(m_proxy->rowCount(), 6);
+
+    // Results of the canceled resolve are discarded
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCOMPARE(m_proxy->columnCount(), 8);
+    QCOMPARE(m_proxy->itemAt(2, 3)->y(), 303.0f);
+
+    // Destroy the proxy while its resolve is running
+    m_proxy->setHeightFieldFile(largeFile);
+    QCoreApplication::processEvents();
+    delete m_proxy;
+    m_proxy = nullptr;
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+QTEST_MAIN(tst_proxy)
+#include "tst_proxy.moc"
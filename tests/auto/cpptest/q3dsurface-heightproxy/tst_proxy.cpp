@@ -21,6 +21,12 @@ private slots:
     void initializeProperties();
     void invalidProperties();
 
+    void floatHeightMap();
+    void premultipliedHeightMap();
+    void rgba64HeightMap();
+    void backgroundResolve();
+    void destroyWhileResolving();
+
 private:
     QHeightMapSurfaceDataProxy *m_proxy;
 };
@@ -81,6 +87,7 @@ void tst_proxy::initialProperties()
 
     QCOMPARE(m_proxy->columnCount(), 0);
     QCOMPARE(m_proxy->rowCount(), 0);
+    QCOMPARE(m_proxy->resolveProgress(), 1.0f);
     QVERIFY(!m_proxy->series());
 
     QCOMPARE(m_proxy->type(), QAbstractDataProxy::DataTypeSurface);
@@ -139,5 +146,109 @@ void tst_proxy::invalidProperties()
     QCOMPARE(m_proxy->minZValue(), 10.0f);
 }
 
+void tst_proxy::floatHeightMap()
+{
+    QImage image(QSize(4, 3), QImage::Format_RGBA32FPx4);
+    image.fill(QColor::fromRgbF(0.25f, 0.25f, 0.25f));
+    image.setPixelColor(1, 2, QColor::fromRgbF(0.75f, 0.75f, 0.75f));
+
+    m_proxy->setHeightMap(image);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->columnCount(), 4);
+    QCOMPARE(m_proxy->rowCount(), 3);
+    QCOMPARE(m_proxy->itemAt(0, 0)->y(), 0.25f);
+    // First data row is the bottom row of the image
+    QCOMPARE(m_proxy->itemAt(0, 1)->y(), 0.75f);
+    QCOMPARE(m_proxy->itemAt(2, 1)->y(), 0.25f);
+
+    m_proxy->setMinYValue(-2.0f);
+    m_proxy->setMaxYValue(2.0f);
+    m_proxy->setAutoScaleY(true);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->itemAt(0, 0)->y(), -1.0f);
+    QCOMPARE(m_proxy->itemAt(0, 1)->y(), 1.0f);
+}
+
+void tst_proxy::premultipliedHeightMap()
+{
+    QImage image(QSize(3, 3), QImage::Format_ARGB32_Premultiplied);
+    image.fill(QColor(100, 100, 100, 128));
+
+    m_proxy->setHeightMap(image);
+    QCoreApplication::processEvents();
+
+    QCOMPARE(m_proxy->rowCount(), 3);
+    // Alpha must not scale the heights
+    QVERIFY(qAbs(m_proxy->itemAt(1, 1)->y() - 100.0f) <= 1.0f);
+}
+
+void tst_proxy::rgba64HeightMap()
+{
+    QImage image(QSize(3, 2), QImage::Format_RGBA64);
+    image.fill(QColor::fromRgba64(0x1234, 0x1234, 0x1234, 0xffff));
+    image.setPixelColor(1, 0, QColor::fromRgba64(1000, 2000, 6000, 0xffff));
+    // Alpha does not affect the heights
+    image.setPixelColor(2, 0, QColor::fromRgba64(0xffff, 0xffff, 0xffff, 0x8000));
+
+    m_proxy->setHeightMap(image);
+    QCoreApplication::processEvents();
+
+    // Heights are read from the full 16-bit components, for gray and colored pixels alike
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->itemAt(0, 0)->y(), 4660.0f);
+    QCOMPARE(m_proxy->itemAt(1, 0)->y(), 4660.0f);
+    QCOMPARE(m_proxy->itemAt(1, 1)->y(), 3000.0f);
+    QCOMPARE(m_proxy->itemAt(1, 2)->y(), 65535.0f);
+
+    m_proxy->setMinYValue(0.0f);
+    m_proxy->setMaxYValue(1.0f);
+    m_proxy->setAutoScaleY(true);
+    QCoreApplication::processEvents();
+
+    QVERIFY(qAbs(m_proxy->itemAt(1, 1)->y() - 3000.0f / 65535.0f) < 1e-6f);
+    QVERIFY(qAbs(m_proxy->itemAt(1, 2)->y() - 1.0f) < 1e-6f);
+}
+
+void tst_proxy::backgroundResolve()
+{
+    QImage image(QSize(1024, 1024), QImage::Format_Grayscale16);
+    for (int i = 0; i < image.height(); i++) {
+        quint16 *line = reinterpret_cast<quint16 *>(image.scanLine(i));
+        for (int j = 0; j < image.width(); j++)
+            line[j] = quint16(j);
+    }
+
+    QSignalSpy progressSpy(m_proxy, &QHeightMapSurfaceDataProxy::resolveProgressChanged);
+    m_proxy->setHeightMap(image);
+
+    QTRY_COMPARE(m_proxy->rowCount(), 1024);
+    QCOMPARE(m_proxy->columnCount(), 1024);
+    QCOMPARE(m_proxy->resolveProgress(), 1.0f);
+    QVERIFY(progressSpy.size() >= 2);
+    QCOMPARE(m_proxy->itemAt(0, 0)->x(), m_proxy->minXValue());
+    QCOMPARE(m_proxy->itemAt(1023, 1023)->x(), m_proxy->maxXValue());
+    QCOMPARE(m_proxy->itemAt(1023, 1023)->z(), m_proxy->maxZValue());
+    QCOMPARE(m_proxy->itemAt(500, 1000)->y(), 1000.0f);
+}
+
+void tst_proxy::destroyWhileResolving()
+{
+    QImage image(QSize(2048, 2048), QImage::Format_Grayscale8);
+    image.fill(10);
+
+    QHeightMapSurfaceDataProxy *proxy = new QHeightMapSurfaceDataProxy(image);
+    QSignalSpy progressSpy(proxy, &QHeightMapSurfaceDataProxy::resolveProgressChanged);
+    QCoreApplication::processEvents();
+    QVERIFY(progressSpy.size() >= 1);
+
+    // Background threads must neither block the deletion nor report to the deleted proxy
+    delete proxy;
+    QCoreApplication::processEvents();
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+}
+
 QTEST_MAIN(tst_proxy)
 #include "tst_proxy.moc"
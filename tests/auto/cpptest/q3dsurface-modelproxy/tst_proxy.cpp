@@ -25,6 +25,7 @@ private slots:
     void initializeProperties();
 
     void multiMatch();
+    void incrementalRowChanges();
 
 private:
     QItemModelSurfaceDataProxy *m_proxy;
@@ -270,5 +271,45 @@ void tst_proxy::multiMatch()
     m_proxy = 0; // Graph deletes proxy
 }
 
+void tst_proxy::incrementalRowChanges()
+{
+    QTableWidget table;
+    table.setRowCount(2);
+    table.setColumnCount(2);
+    for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 2; col++)
+            table.setItem(row, col, new QTableWidgetItem(QString::number(row * 10 + col)));
+    }
+
+    m_proxy->setItemModel(table.model());
+    m_proxy->setUseModelCategories(true);
+    QCoreApplication::processEvents();
+
+    // Without position roles, x and z come from the headers, which number the rows
+    // and columns from one
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->itemAt(1, 1)->position(), QVector3D(2.0f, 11.0f, 2.0f));
+
+    // Row changes after the initial resolve are applied without resetting the whole array
+    QSignalSpy resetSpy(m_proxy, &QSurfaceDataProxy::arrayReset);
+
+    table.insertRow(1);
+    QCOMPARE(m_proxy->rowCount(), 3);
+    QCOMPARE(m_proxy->itemAt(1, 0)->position(), QVector3D(1.0f, 0.0f, 2.0f));
+    // The shifted row has a new header, and so a new z-position
+    QCOMPARE(m_proxy->itemAt(2, 1)->position(), QVector3D(2.0f, 11.0f, 3.0f));
+
+    table.setItem(1, 0, new QTableWidgetItem(QStringLiteral("5")));
+    QCOMPARE(m_proxy->itemAt(1, 0)->y(), 5.0f);
+
+    table.removeRow(0);
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->itemAt(0, 0)->position(), QVector3D(1.0f, 5.0f, 1.0f));
+    QCOMPARE(m_proxy->itemAt(1, 1)->position(), QVector3D(2.0f, 11.0f, 2.0f));
+
+    QCoreApplication::processEvents();
+    QCOMPARE(resetSpy.size(), 0);
+}
+
 QTEST_MAIN(tst_proxy)
 #include "tst_proxy.moc"
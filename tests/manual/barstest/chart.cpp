@@ -14,12 +14,47 @@
 #include <QtDataVisualization/q3dtheme.h>
 #include <QtDataVisualization/q3dinputhandler.h>
 #include <QtDataVisualization/qcustom3ditem.h>
+#include <QtDataVisualization/private/qabstract3dgraph_p.h>
+#include <QtDataVisualization/private/bars3dcontroller_p.h>
 #include <QtCore/QRandomGenerator>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QThreadPool>
 #include <QtCore/qmath.h>
 
 const QString celsiusString = QString(QChar(0xB0)) + "C";
 
+static FrameStatistics frameStatistics(QAbstract3DGraph *graph)
+{
+    return QAbstract3DGraphPrivate::controller(graph)->frameStatistics();
+}
+
+// Prints the counters collected between the two statistics, mostly as averages per frame
+static void logFrameStatistics(const QString &title, const FrameStatistics &start,
+                               const FrameStatistics &end)
+{
+    const quint64 frames = end.renderedFrames - start.renderedFrames;
+    const double perFrame = frames ? 1.0 / double(frames) : 0.0;
+    qDebug().noquote() << title << "- frames:" << frames
+             << "render requests:" << end.renderRequests - start.renderRequests
+             << "coalesced:" << end.coalescedRenderRequests - start.coalescedRenderRequests
+             << "unchanged frames:" << end.unchangedFrames - start.unchangedFrames
+             << "camera only frames:" << end.cameraOnlyFrames - start.cameraOnlyFrames
+             << "selection passes skipped:"
+             << end.selectionPassesSkipped - start.selectionPassesSkipped;
+    qDebug() << "  per frame - render ms:"
+             << double(end.renderNsecs - start.renderNsecs) * perFrame / 1000000.0
+             << "draw calls:" << double(end.drawCalls - start.drawCalls) * perFrame
+             << "binds elided:" << double(end.stateBindsElided - start.stateBindsElided) * perFrame
+             << "culled items:" << double(end.culledItems - start.culledItems) * perFrame
+             << "occluded items:" << double(end.occludedItems - start.occludedItems) * perFrame;
+    qDebug() << "  reflection passes rendered:"
+             << end.reflectionPassesRendered - start.reflectionPassesRendered
+             << "reused:" << end.reflectionPassesReused - start.reflectionPassesReused
+             << "reflection ms per frame:"
+             << double(end.reflectionPassNsecs - start.reflectionPassNsecs) * perFrame
+                / 1000000.0;
+}
+
 GraphModifier::GraphModifier(Q3DBars *barchart, QColorDialog *colorDialog)
     : m_graph(barchart),
       m_colorDialog(colorDialog),
@@ -61,7 +96,8 @@ GraphModifier::GraphModifier(Q3DBars *barchart, QColorDialog *colorDialog)
       m_ownTheme(0),
       m_builtinTheme(new Q3DTheme(Q3DTheme::ThemeStoneMoss)),
       m_customInputHandler(new CustomInputHandler),
-      m_extraSeries(0)
+      m_extraSeries(0),
+      m_occlusionBenchmarkStep(0)
 {
     m_temperatureData->setObjectName("m_temperatureData");
     m_temperatureData2->setObjectName("m_temperatureData2");
@@ -229,6 +265,14 @@ GraphModifier::GraphModifier(Q3DBars *barchart, QColorDialog *colorDialog)
 
     QObject::connect(m_graph, &QAbstract3DGraph::currentFpsChanged, this,
                      &GraphModifier::handleFpsChange);
+    QObject::connect(&m_occlusionBenchmarkTimer, &QTimer::timeout, this,
+                     &GraphModifier::occlusionBenchmarkTimeout);
+    QObject::connect(&m_reflectionBenchmarkTimer, &QTimer::timeout, this,
+                     &GraphModifier::reflectionBenchmarkTimeout);
+    QObject::connect(&m_reflectionCameraTimer, &QTimer::timeout, this, [this]() {
+        Q3DCamera *camera = m_graph->scene()->activeCamera();
+        camera->setXRotation(camera->xRotation() + 0.5f);
+    });
 
     resetTemperatureData();
 }
@@ -329,7 +373,101 @@ void GraphModifier::flipViews(bool checked)
 
 void GraphModifier::createMassiveArray()
 {
-    const int arrayDimension = 1000;
+    fillMassiveArray(1000);
+}
+
+void GraphModifier::benchmarkOcclusionCulling()
+{
+    if (m_occlusionBenchmarkTimer.isActive())
+        return;
+
+    // Front rows hide most of the bars when the graph is viewed from a low angle
+    fillMassiveArray(500);
+    m_graph->scene()->activeCamera()->setCameraPosition(30.0f, 2.0f, 100.0f);
+    m_graph->setOcclusionCulling(false);
+    m_graph->setMeasureFps(true);
+    m_occlusionBenchmarkStep = 0;
+    m_benchmarkStatistics = frameStatistics(m_graph);
+    m_occlusionBenchmarkTimer.start(5000);
+}
+
+void GraphModifier::occlusionBenchmarkTimeout()
+{
+    const QString title = QStringLiteral("Occlusion culling %1 for 500 x 500 bars, fps: %2")
+            .arg(m_graph->isOcclusionCulling() ? QStringLiteral("on") : QStringLiteral("off"))
+            .arg(m_graph->currentFps());
+    const FrameStatistics statistics = frameStatistics(m_graph);
+    logFrameStatistics(title, m_benchmarkStatistics, statistics);
+    m_benchmarkStatistics = statistics;
+
+    if (++m_occlusionBenchmarkStep < 2) {
+        m_graph->setOcclusionCulling(!m_graph->isOcclusionCulling());
+    } else {
+        m_occlusionBenchmarkTimer.stop();
+        m_graph->setOcclusionCulling(false);
+    }
+}
+
+void GraphModifier::benchmarkReflections()
+{
+    if (m_reflectionBenchmarkTimer.isActive())
+        return;
+
+    // Compares drawing the reflections directly to rendering them into the reflection texture,
+    // both with a moving camera and with a still one, in which case the texture is reused
+    fillMassiveArray(200);
+    m_graph->setReflection(true);
+    m_graph->setMeasureFps(true);
+    m_reflectionBenchmarkStep = 0;
+    setReflectionBenchmarkStep(m_reflectionBenchmarkStep);
+    m_reflectionBenchmarkTimer.start(5000);
+}
+
+void GraphModifier::reflectionBenchmarkTimeout()
+{
+    const QString title = QStringLiteral("Reflections drawn %1 with a %2 camera, fps: %3")
+            .arg(m_reflectionBenchmarkStep & 1 ? QStringLiteral("into the texture")
+                                               : QStringLiteral("directly"))
+            .arg(m_reflectionBenchmarkStep & 2 ? QStringLiteral("still")
+                                               : QStringLiteral("moving"))
+            .arg(m_graph->currentFps());
+    logFrameStatistics(title, m_benchmarkStatistics, frameStatistics(m_graph));
+
+    if (++m_reflectionBenchmarkStep < 4) {
+        setReflectionBenchmarkStep(m_reflectionBenchmarkStep);
+    } else {
+        m_reflectionBenchmarkTimer.stop();
+        m_reflectionCameraTimer.stop();
+        setReflectionTextureEnabled(true);
+    }
+}
+
+void GraphModifier::setReflectionBenchmarkStep(int step)
+{
+    setReflectionTextureEnabled(step & 1);
+    if (step & 2)
+        m_reflectionCameraTimer.stop();
+    else
+        m_reflectionCameraTimer.start(16);
+    m_benchmarkStatistics = frameStatistics(m_graph);
+}
+
+void GraphModifier::setReflectionTextureEnabled(bool enable)
+{
+    static_cast<Bars3DController *>(QAbstract3DGraphPrivate::controller(m_graph))
+            ->setReflectionTextureEnabled(enable);
+}
+
+void GraphModifier::printFrameStatistics()
+{
+    const FrameStatistics statistics = frameStatistics(m_graph);
+    logFrameStatistics(QStringLiteral("Frame statistics since the last print"),
+                       m_printedStatistics, statistics);
+    m_printedStatistics = statistics;
+}
+
+void GraphModifier::fillMassiveArray(int arrayDimension)
+{
     QElapsedTimer timer;
     timer.start();
 
@@ -349,6 +487,15 @@ void GraphModifier::createMassiveArray()
             genericRowLabels << QStringLiteral("Row %1").arg(i);
     }
 
+    QBarDataArray *dataArray = makeMassiveDataArray(arrayDimension);
+
+    m_genericData->dataProxy()->resetArray(dataArray, genericRowLabels, genericColumnLabels);
+
+    qDebug() << "Created Massive Array (" << arrayDimension << "), time:" << timer.elapsed();
+}
+
+QBarDataArray *GraphModifier::makeMassiveDataArray(int arrayDimension)
+{
     QBarDataArray *dataArray = new QBarDataArray;
     dataArray->reserve(arrayDimension);
     for (int i = 0; i < arrayDimension; i++) {
@@ -363,10 +510,40 @@ void GraphModifier::createMassiveArray()
         }
         dataArray->append(dataRow);
     }
+    return dataArray;
+}
 
-    m_genericData->dataProxy()->resetArray(dataArray, genericRowLabels, genericColumnLabels);
+void GraphModifier::benchmarkDataUpdates()
+{
+    // The update latency is the time to render a frame after a data change, minus the time to
+    // render the same frame without one
+    const int arrayDimension = 1000;
+    const QSize imageSize(256, 256);
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int defaultThreadCount = pool->maxThreadCount();
 
-    qDebug() << "Created Massive Array (" << arrayDimension << "), time:" << timer.elapsed();
+    fillMassiveArray(arrayDimension);
+    m_graph->renderToImage(0, imageSize);
+
+    const int threadCounts[] = { 1, 4, 16 };
+    for (int threadCount : threadCounts) {
+        pool->setMaxThreadCount(threadCount);
+        QElapsedTimer timer;
+        timer.start();
+        m_graph->renderToImage(0, imageSize);
+        const qint64 renderTime = timer.nsecsElapsed();
+
+        QBarDataArray *dataArray = makeMassiveDataArray(arrayDimension);
+        timer.restart();
+        m_genericData->dataProxy()->resetArray(dataArray);
+        m_graph->renderToImage(0, imageSize);
+        const qint64 updateTime = timer.nsecsElapsed() - renderTime;
+
+        qDebug() << "Updated" << arrayDimension << "x" << arrayDimension << "bars with"
+                 << threadCount << "threads, latency:" << updateTime / 1000000.0 << "ms";
+    }
+
+    pool->setMaxThreadCount(defaultThreadCount);
 }
 
 void GraphModifier::resetTemperatureData()
@@ -8,6 +8,7 @@
 #include <QtDataVisualization/q3dinputhandler.h>
 #include <QtDataVisualization/qbar3dseries.h>
 #include <QtDataVisualization/q3dtheme.h>
+#include <QtDataVisualization/private/abstract3dcontroller_p.h>
 #include <QFont>
 #include <QDebug>
 #include <QStringList>
@@ -64,6 +65,10 @@ public:
     void releaseAxes();
     void releaseSeries();
     void createMassiveArray();
+    void benchmarkOcclusionCulling();
+    void benchmarkDataUpdates();
+    void benchmarkReflections();
+    void printFrameStatistics();
     void useOwnTheme(bool checked);
     void changeBaseColor(const QColor &color);
     void changeColorStyle(bool checked);
@@ -107,6 +112,8 @@ public Q_SLOTS:
     void triggerRotation();
     void handleValueAxisLabelsChanged();
     void handleFpsChange(qreal fps);
+    void occlusionBenchmarkTimeout();
+    void reflectionBenchmarkTimeout();
     void setCameraTargetX(int value);
     void setCameraTargetY(int value);
     void setCameraTargetZ(int value);
@@ -118,6 +125,10 @@ Q_SIGNALS:
 
 private:
     void populateFlatSeries(QBar3DSeries *series, int rows, int columns, float value);
+    void fillMassiveArray(int arrayDimension);
+    QBarDataArray *makeMassiveDataArray(int arrayDimension);
+    void setReflectionBenchmarkStep(int step);
+    void setReflectionTextureEnabled(bool enable);
     QBarDataRow *createFlatRow(int columns, float value);
 
     Q3DBars *m_graph;
@@ -166,6 +177,13 @@ private:
     QAbstract3DInputHandler *m_customInputHandler;
     QTimer m_selectionTimer;
     QTimer m_rotationTimer;
+    QTimer m_occlusionBenchmarkTimer;
+    int m_occlusionBenchmarkStep;
+    QTimer m_reflectionBenchmarkTimer;
+    QTimer m_reflectionCameraTimer;
+    int m_reflectionBenchmarkStep;
+    FrameStatistics m_benchmarkStatistics;
+    FrameStatistics m_printedStatistics;
     QLabel *m_fpsLabel;
     QBar3DSeries *m_extraSeries;
     QVector3D m_cameraTarget;
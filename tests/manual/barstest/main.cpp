@@ -107,6 +107,21 @@ int main(int argc, char **argv)
     massiveArrayButton->setText(QStringLiteral("Create massive array"));
     massiveArrayButton->setEnabled(false);
 
+    QPushButton *occlusionBenchmarkButton = new QPushButton(widget);
+    occlusionBenchmarkButton->setText(QStringLiteral("Benchmark occlusion culling"));
+    occlusionBenchmarkButton->setEnabled(false);
+
+    QPushButton *updateBenchmarkButton = new QPushButton(widget);
+    updateBenchmarkButton->setText(QStringLiteral("Benchmark data updates"));
+    updateBenchmarkButton->setEnabled(false);
+
+    QPushButton *reflectionBenchmarkButton = new QPushButton(widget);
+    reflectionBenchmarkButton->setText(QStringLiteral("Benchmark reflections"));
+    reflectionBenchmarkButton->setEnabled(false);
+
+    QPushButton *statisticsButton = new QPushButton(widget);
+    statisticsButton->setText(QStringLiteral("Print frame statistics"));
+
     QPushButton *themeButton = new QPushButton(widget);
     themeButton->setText(QStringLiteral("Change theme"));
 
@@ -391,6 +406,10 @@ int main(int argc, char **argv)
     vLayout->addWidget(removeRowButton, 0, Qt::AlignTop);
     vLayout->addWidget(removeRowsButton, 0, Qt::AlignTop);
     vLayout->addWidget(massiveArrayButton, 0, Qt::AlignTop);
+    vLayout->addWidget(occlusionBenchmarkButton, 0, Qt::AlignTop);
+    vLayout->addWidget(updateBenchmarkButton, 0, Qt::AlignTop);
+    vLayout->addWidget(reflectionBenchmarkButton, 0, Qt::AlignTop);
+    vLayout->addWidget(statisticsButton, 0, Qt::AlignTop);
     vLayout->addWidget(showFiveSeriesButton, 0, Qt::AlignTop);
     vLayout->addWidget(themeButton, 0, Qt::AlignTop);
     vLayout->addWidget(labelButton, 0, Qt::AlignTop);
@@ -534,6 +553,14 @@ int main(int argc, char **argv)
     QObject::connect(removeRowButton, &QPushButton::clicked, modifier, &GraphModifier::removeRow);
     QObject::connect(removeRowsButton, &QPushButton::clicked, modifier, &GraphModifier::removeRows);
     QObject::connect(massiveArrayButton, &QPushButton::clicked, modifier, &GraphModifier::createMassiveArray);
+    QObject::connect(occlusionBenchmarkButton, &QPushButton::clicked, modifier,
+                     &GraphModifier::benchmarkOcclusionCulling);
+    QObject::connect(updateBenchmarkButton, &QPushButton::clicked, modifier,
+                     &GraphModifier::benchmarkDataUpdates);
+    QObject::connect(reflectionBenchmarkButton, &QPushButton::clicked, modifier,
+                     &GraphModifier::benchmarkReflections);
+    QObject::connect(statisticsButton, &QPushButton::clicked, modifier,
+                     &GraphModifier::printFrameStatistics);
     QObject::connect(showFiveSeriesButton, &QPushButton::clicked, modifier, &GraphModifier::showFiveSeries);
     QObject::connect(selectionButton, &QPushButton::clicked, modifier,
                      &GraphModifier::changeSelectionMode);
@@ -619,6 +646,9 @@ int main(int argc, char **argv)
     ButtonWrapper *changeRowButtonWrapper = new ButtonWrapper(changeRowButton);
     ButtonWrapper *changeRowsButtonWrapper = new ButtonWrapper(changeRowsButton);
     ButtonWrapper *massiveArrayButtonWrapper = new ButtonWrapper(massiveArrayButton);
+    ButtonWrapper *occlusionBenchmarkButtonWrapper = new ButtonWrapper(occlusionBenchmarkButton);
+    ButtonWrapper *updateBenchmarkButtonWrapper = new ButtonWrapper(updateBenchmarkButton);
+    ButtonWrapper *reflectionBenchmarkButtonWrapper = new ButtonWrapper(reflectionBenchmarkButton);
     ButtonWrapper *removeRowButtonWrapper = new ButtonWrapper(removeRowButton);
     ButtonWrapper *removeRowsButtonWrapper = new ButtonWrapper(removeRowsButton);
 
@@ -650,6 +680,12 @@ int main(int argc, char **argv)
                      &ButtonWrapper::setEnabled);
     QObject::connect(staticCheckBox, &QCheckBox::stateChanged, massiveArrayButtonWrapper,
                      &ButtonWrapper::setEnabled);
+    QObject::connect(staticCheckBox, &QCheckBox::stateChanged, occlusionBenchmarkButtonWrapper,
+                     &ButtonWrapper::setEnabled);
+    QObject::connect(staticCheckBox, &QCheckBox::stateChanged, updateBenchmarkButtonWrapper,
+                     &ButtonWrapper::setEnabled);
+    QObject::connect(staticCheckBox, &QCheckBox::stateChanged, reflectionBenchmarkButtonWrapper,
+                     &ButtonWrapper::setEnabled);
     QObject::connect(staticCheckBox, &QCheckBox::stateChanged, sampleSliderWrapperX,
                      &SliderWrapper::setEnabled);
     QObject::connect(staticCheckBox, &QCheckBox::stateChanged, sampleSliderWrapperZ,
@@ -3,7 +3,10 @@
 
 #include <QtGui/QGuiApplication>
 #include <QtCore/QDir>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
 #include <QtQuick/QQuickView>
+#include <QtQml/QQmlContext>
 #include <QtQml/QQmlEngine>
 
 int main(int argc, char *argv[])
@@ -24,6 +27,27 @@ int main(int argc, char *argv[])
                                       QString::fromLatin1("qml")));
     QObject::connect(viewer.engine(), &QQmlEngine::quit, &viewer, &QWindow::close);
 
+    // With -benchmark the cameras keep rotating and the average frame time is printed
+    const bool benchmark = QGuiApplication::arguments().contains(QStringLiteral("-benchmark"));
+    viewer.rootContext()->setContextProperty("benchmark", benchmark);
+
+    QElapsedTimer frameTimer;
+    int frameCount = 0;
+    if (benchmark) {
+        QObject::connect(&viewer, &QQuickWindow::frameSwapped, &viewer, [&]() {
+            if (!frameTimer.isValid())
+                frameTimer.start();
+            frameCount++;
+            if (frameTimer.elapsed() >= 2000) {
+                qDebug() << "Average frame time:"
+                         << double(frameTimer.nsecsElapsed()) / 1000000.0 / frameCount
+                         << "ms over" << frameCount << "frames";
+                frameCount = 0;
+                frameTimer.restart();
+            }
+        });
+    }
+
     viewer.setTitle(QStringLiteral("QML multitest"));
     viewer.setSource(QUrl("qrc:/qml/qmlmultitest/main.qml"));
     viewer.setResizeMode(QQuickView::SizeRootObjectToView);